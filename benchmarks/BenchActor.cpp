@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/actor.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/signal.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <zmq.hpp>
+
+namespace {
+
+using namespace zmqzext;
+
+bool is_stop_request(zmq::message_t const& msg) {
+    auto const signal = signal_t::check_signal(msg);
+    return signal && signal->is_stop();
+}
+
+/**
+ * Actor that signals success and then waits for the stop request.
+ */
+bool idle_actor(zmq::socket_t& socket) {
+    socket.send(signal_t::create_success(), zmq::send_flags::none);
+    zmq::message_t msg;
+    while (true) {
+        if (socket.recv(msg, zmq::recv_flags::none) && is_stop_request(msg)) {
+            return true;
+        }
+    }
+}
+
+/**
+ * Actor that echoes every message received through its socket until the stop request.
+ */
+bool echo_actor(zmq::socket_t& socket) {
+    socket.send(signal_t::create_success(), zmq::send_flags::none);
+    zmq::message_t msg;
+    while (true) {
+        if (!socket.recv(msg, zmq::recv_flags::none)) {
+            continue;
+        }
+        if (is_stop_request(msg)) {
+            return true;
+        }
+        socket.send(msg, zmq::send_flags::none);
+    }
+}
+
+/**
+ * Actor that echoes every frame received through its ring pipe until the stop
+ * request arrives through its socket.
+ */
+bool pipe_echo_actor(zmq::socket_t& socket, ring_pipe_t& pipe) {
+    loop_t loop;
+    loop.add(socket, [](loop_t&, zmq::socket_ref s) {
+        zmq::message_t msg;
+        return !(s.recv(msg, zmq::recv_flags::dontwait) && is_stop_request(msg));
+    });
+    loop.add_fd(pipe.fd(), [&pipe](loop_t&, zmq::fd_t) {
+        zmq::message_t msg;
+        while (pipe.recv(msg, zmq::recv_flags::dontwait)) {
+            pipe.send(zmq::buffer(msg.data(), msg.size()));
+        }
+        return true;
+    });
+    socket.send(signal_t::create_success(), zmq::send_flags::none);
+    loop.run(false);
+    return true;
+}
+
+/**
+ * Full actor lifecycle: construction, thread start with the initialization
+ * handshake, stop request and join.
+ */
+void BM_ActorStartStop(benchmark::State& state) {
+    zmq::context_t ctx;
+    for (auto _ : state) {
+        actor_t actor(ctx);
+        actor.start(idle_actor);
+        actor.stop(std::chrono::milliseconds{-1});
+    }
+}
+BENCHMARK(BM_ActorStartStop)->UseRealTime();
+
+/**
+ * Round trip between the parent and an echo actor through the actor PAIR socket.
+ */
+void BM_ActorSocketRoundTrip(benchmark::State& state) {
+    zmq::context_t ctx;
+    actor_t actor(ctx);
+    actor.start(echo_actor);
+    std::string const payload(static_cast<std::size_t>(state.range(0)), 'x');
+
+    zmq::message_t msg;
+    for (auto _ : state) {
+        actor.socket().send(zmq::buffer(payload), zmq::send_flags::none);
+        benchmark::DoNotOptimize(actor.socket().recv(msg, zmq::recv_flags::none));
+    }
+
+    actor.stop(std::chrono::milliseconds{-1});
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * 2);
+}
+BENCHMARK(BM_ActorSocketRoundTrip)->RangeMultiplier(64)->Range(16, 65536)->UseRealTime();
+
+#if !defined(WIN32)
+/**
+ * Round trip between the parent and an echo actor through the actor ring pipe.
+ */
+void BM_ActorRingPipeRoundTrip(benchmark::State& state) {
+    zmq::context_t ctx;
+    actor_t actor(ctx);
+    actor.start(pipe_echo_actor, ring_pipe_t::DEFAULT_CAPACITY);
+    std::string const payload(static_cast<std::size_t>(state.range(0)), 'x');
+
+    zmq::message_t msg;
+    for (auto _ : state) {
+        actor.pipe().send(zmq::buffer(payload));
+        benchmark::DoNotOptimize(actor.pipe().recv(msg));
+    }
+
+    actor.stop(std::chrono::milliseconds{-1});
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * 2);
+}
+BENCHMARK(BM_ActorRingPipeRoundTrip)->RangeMultiplier(64)->Range(16, 65536)->UseRealTime();
+#endif
+
+}  // namespace
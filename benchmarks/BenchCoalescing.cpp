@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/coalescing_sender.h>
+#include <cppzmqzoltanext/loop.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <zmq.hpp>
+
+namespace {
+
+using namespace zmqzext;
+
+/// Records sent, then received, in each iteration.
+constexpr std::size_t k_records_per_iteration = 1000;
+
+struct push_pull_t {
+    explicit push_pull_t(zmq::context_t& ctx) : push(ctx, zmq::socket_type::push), pull(ctx, zmq::socket_type::pull) {
+        push.set(zmq::sockopt::linger, 0);
+        push.set(zmq::sockopt::sndhwm, 0);
+        pull.set(zmq::sockopt::rcvhwm, 0);
+        pull.bind("inproc://bench-coalescing");
+        push.connect("inproc://bench-coalescing");
+    }
+
+    zmq::socket_t push;
+    zmq::socket_t pull;
+};
+
+/**
+ * Baseline: one message per record. Items are records.
+ */
+void BM_SendPerRecord(benchmark::State& state) {
+    zmq::context_t ctx;
+    push_pull_t sockets(ctx);
+    std::string const record(static_cast<std::size_t>(state.range(0)), 'x');
+    zmq::message_t msg;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < k_records_per_iteration; ++i) {
+            sockets.push.send(zmq::buffer(record), zmq::send_flags::none);
+        }
+        for (std::size_t i = 0; i < k_records_per_iteration; ++i) {
+            benchmark::DoNotOptimize(sockets.pull.recv(msg, zmq::recv_flags::none));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * k_records_per_iteration));
+}
+BENCHMARK(BM_SendPerRecord)->Arg(16)->Arg(64)->Arg(256)->ArgName("record_size");
+
+/**
+ * coalescing_sender_t with the default 64 KiB threshold, flushed at the end of
+ * each iteration, and batch_reader_t splitting the batches. Items are records.
+ */
+void BM_CoalescedSend(benchmark::State& state) {
+    zmq::context_t ctx;
+    push_pull_t sockets(ctx);
+    loop_t loop;
+    coalescing_sender_t sender(loop, sockets.push);
+    std::string const record(static_cast<std::size_t>(state.range(0)), 'x');
+    zmq::message_t msg;
+    zmq::const_buffer received;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < k_records_per_iteration; ++i) {
+            sender.send(zmq::buffer(record));
+        }
+        sender.flush();
+        std::size_t count = 0;
+        while (count < k_records_per_iteration) {
+            benchmark::DoNotOptimize(sockets.pull.recv(msg, zmq::recv_flags::none));
+            batch_reader_t reader(msg);
+            while (reader.next(received)) {
+                benchmark::DoNotOptimize(received.data());
+                ++count;
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * k_records_per_iteration));
+}
+BENCHMARK(BM_CoalescedSend)->Arg(16)->Arg(64)->Arg(256)->ArgName("record_size");
+
+}  // namespace
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/histogram.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using namespace zmqzext;
+
+/**
+ * Cost of recording a value, with all benchmark threads sharing one histogram.
+ */
+void BM_HistogramRecord(benchmark::State& state) {
+    static auto histogram = std::make_unique<histogram_t>();
+    std::uint64_t value = 1000 + static_cast<std::uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        histogram->record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        value >>= 40;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(BM_HistogramRecord)->ThreadRange(1, 4);
+
+/**
+ * Cost of taking a snapshot and querying a percentile.
+ */
+void BM_HistogramSnapshotPercentile(benchmark::State& state) {
+    auto histogram = std::make_unique<histogram_t>();
+    for (std::uint64_t value = 0; value < 100000; ++value) {
+        histogram->record(value * 31);
+    }
+    for (auto _ : state) {
+        auto const snapshot = histogram->snapshot();
+        benchmark::DoNotOptimize(snapshot.value_at_percentile(99.9));
+    }
+}
+BENCHMARK(BM_HistogramSnapshotPercentile);
+
+}  // namespace
@@ -0,0 +1,290 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/static_loop.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+namespace {
+
+using namespace zmqzext;
+
+/// Long enough to never expire during a benchmark run.
+constexpr std::chrono::milliseconds k_idle_timer_timeout{std::chrono::hours{1}};
+
+/**
+ * Round trip of a message between two loop_t instances in different threads.
+ * The server echoes every frame and stops on an empty frame. One iteration is
+ * one round trip, so the reported time per iteration is the round trip latency.
+ */
+void BM_LoopPingPong(benchmark::State& state, std::string const& bind_endpoint) {
+    zmq::context_t ctx;
+    zmq::socket_t server(ctx, zmq::socket_type::pair);
+    server.set(zmq::sockopt::linger, 0);
+    server.bind(bind_endpoint);
+    auto const endpoint = server.get(zmq::sockopt::last_endpoint);
+
+    std::thread server_thread([&server]() {
+        loop_t loop;
+        loop.add(server, [](loop_t&, zmq::socket_ref socket) {
+            zmq::message_t msg;
+            if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            if (msg.size() == 0) {
+                return false;
+            }
+            socket.send(msg, zmq::send_flags::none);
+            return true;
+        });
+        loop.run(false);
+    });
+
+    zmq::socket_t client(ctx, zmq::socket_type::pair);
+    client.set(zmq::sockopt::linger, 0);
+    client.connect(endpoint);
+
+    std::string const payload(static_cast<std::size_t>(state.range(0)), 'x');
+    loop_t loop;
+    loop.add(client, [&state, &payload](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+            return true;
+        }
+        if (!state.KeepRunning()) {
+            return false;
+        }
+        socket.send(zmq::buffer(payload), zmq::send_flags::none);
+        return true;
+    });
+
+    if (state.KeepRunning()) {
+        client.send(zmq::buffer(payload), zmq::send_flags::none);
+        loop.run(false);
+    }
+
+    client.send(zmq::message_t{}, zmq::send_flags::none);
+    server_thread.join();
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * 2);
+}
+BENCHMARK_CAPTURE(BM_LoopPingPong, inproc, std::string{"inproc://czze-bench-ping-pong"})
+    ->RangeMultiplier(64)
+    ->Range(16, 65536)
+    ->UseRealTime();
+#if !defined(WIN32)
+BENCHMARK_CAPTURE(BM_LoopPingPong, ipc, std::string{"ipc://*"})
+    ->RangeMultiplier(64)
+    ->Range(16, 65536)
+    ->UseRealTime();
+#endif
+BENCHMARK_CAPTURE(BM_LoopPingPong, tcp, std::string{"tcp://127.0.0.1:*"})
+    ->RangeMultiplier(64)
+    ->Range(16, 65536)
+    ->UseRealTime();
+
+/**
+ * Same round trip as BM_LoopPingPong over inproc, between two static_loop_t
+ * instances, to compare the dispatch cost of the compile-time handler set.
+ */
+void BM_StaticLoopPingPong(benchmark::State& state) {
+    zmq::context_t ctx;
+    zmq::socket_t server(ctx, zmq::socket_type::pair);
+    server.set(zmq::sockopt::linger, 0);
+    server.bind("inproc://czze-bench-static-ping-pong");
+
+    std::thread server_thread([&server]() {
+        static_loop_t loop{static_socket(server, [](zmq::socket_ref socket) {
+            zmq::message_t msg;
+            if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            if (msg.size() == 0) {
+                return false;
+            }
+            socket.send(msg, zmq::send_flags::none);
+            return true;
+        })};
+        loop.run(false);
+    });
+
+    zmq::socket_t client(ctx, zmq::socket_type::pair);
+    client.set(zmq::sockopt::linger, 0);
+    client.connect("inproc://czze-bench-static-ping-pong");
+
+    std::string const payload(static_cast<std::size_t>(state.range(0)), 'x');
+    static_loop_t loop{static_socket(client, [&state, &payload](zmq::socket_ref socket) {
+        zmq::message_t msg;
+        if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+            return true;
+        }
+        if (!state.KeepRunning()) {
+            return false;
+        }
+        socket.send(zmq::buffer(payload), zmq::send_flags::none);
+        return true;
+    })};
+
+    if (state.KeepRunning()) {
+        client.send(zmq::buffer(payload), zmq::send_flags::none);
+        loop.run(false);
+    }
+
+    client.send(zmq::message_t{}, zmq::send_flags::none);
+    server_thread.join();
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * 2);
+}
+BENCHMARK(BM_StaticLoopPingPong)->RangeMultiplier(64)->Range(16, 65536)->UseRealTime();
+
+/**
+ * Messages dispatched per second by a single loop_t while a growing number of
+ * idle sockets is registered besides the active one. Each dispatched message
+ * is received and the next one is sent by the handler, so every iteration goes
+ * through one poll and one handler lookup.
+ */
+void BM_LoopDispatchVsSockets(benchmark::State& state) {
+    auto const num_sockets = static_cast<std::size_t>(state.range(0));
+    zmq::context_t ctx;
+    std::vector<zmq::socket_t> receivers;
+    std::vector<zmq::socket_t> senders;
+    receivers.reserve(num_sockets);
+    senders.reserve(num_sockets);
+    loop_t loop;
+    for (std::size_t i = 0; i < num_sockets; ++i) {
+        auto const endpoint = "inproc://czze-bench-dispatch-" + std::to_string(i);
+        receivers.emplace_back(ctx, zmq::socket_type::pair);
+        receivers.back().set(zmq::sockopt::linger, 0);
+        receivers.back().bind(endpoint);
+        senders.emplace_back(ctx, zmq::socket_type::pair);
+        senders.back().set(zmq::sockopt::linger, 0);
+        senders.back().connect(endpoint);
+    }
+
+    // Only the last registered socket receives messages
+    zmq::socket_ref active_sender = senders.back();
+    for (std::size_t i = 0; i < num_sockets; ++i) {
+        loop.add(receivers[i], [&state, &active_sender](loop_t&, zmq::socket_ref socket) {
+            zmq::message_t msg;
+            if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            if (!state.KeepRunning()) {
+                return false;
+            }
+            active_sender.send(zmq::str_buffer("msg"), zmq::send_flags::none);
+            return true;
+        });
+    }
+
+    if (state.KeepRunning()) {
+        active_sender.send(zmq::str_buffer("msg"), zmq::send_flags::none);
+        loop.run(false);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["sockets"] = static_cast<double>(num_sockets);
+}
+BENCHMARK(BM_LoopDispatchVsSockets)->RangeMultiplier(4)->Range(1, 256);
+
+/**
+ * Timer expirations handled per second by a loop_t with a growing number of
+ * live timers that never expire during the run. The measured timer has a zero
+ * timeout, so it expires on every loop iteration.
+ */
+void BM_LoopTimersVsLiveTimers(benchmark::State& state) {
+    auto const num_live_timers = static_cast<std::size_t>(state.range(0));
+    loop_t loop;
+    for (std::size_t i = 0; i < num_live_timers; ++i) {
+        loop.add_timer(k_idle_timer_timeout, 0, [](loop_t&, timer_id_t) { return true; });
+    }
+    loop.add_timer(std::chrono::milliseconds{0}, 0, [&state](loop_t&, timer_id_t) { return state.KeepRunning(); });
+
+    loop.run(false);
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["live_timers"] = static_cast<double>(num_live_timers);
+}
+BENCHMARK(BM_LoopTimersVsLiveTimers)->RangeMultiplier(8)->Range(1, 4096);
+
+/**
+ * Cost of scheduling, firing and discarding a one shot timer with a growing
+ * number of live timers. Each expiration schedules the next one shot timer
+ * from inside its handler.
+ */
+void BM_LoopOneShotTimerVsLiveTimers(benchmark::State& state) {
+    auto const num_live_timers = static_cast<std::size_t>(state.range(0));
+    loop_t loop;
+    for (std::size_t i = 0; i < num_live_timers; ++i) {
+        loop.add_timer(k_idle_timer_timeout, 0, [](loop_t&, timer_id_t) { return true; });
+    }
+    fn_timer_handler_t one_shot;
+    one_shot = [&state, &one_shot](loop_t& loop, timer_id_t) {
+        if (!state.KeepRunning()) {
+            return false;
+        }
+        loop.add_timer(std::chrono::milliseconds{0}, 1, one_shot);
+        return true;
+    };
+    loop.add_timer(std::chrono::milliseconds{0}, 1, one_shot);
+
+    loop.run(false);
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["live_timers"] = static_cast<double>(num_live_timers);
+}
+BENCHMARK(BM_LoopOneShotTimerVsLiveTimers)->RangeMultiplier(8)->Range(1, 4096);
+
+/**
+ * Cost of postponing an idle timeout on every loop iteration with a growing
+ * number of live timers, re-arming the timer in place with reset_timer().
+ */
+void BM_LoopTimerReset(benchmark::State& state) {
+    auto const num_live_timers = static_cast<std::size_t>(state.range(0));
+    loop_t loop;
+    for (std::size_t i = 0; i < num_live_timers; ++i) {
+        loop.add_timer(k_idle_timer_timeout, 0, [](loop_t&, timer_id_t) { return true; });
+    }
+    auto const idle_timer = loop.add_timer(k_idle_timer_timeout, 1, [](loop_t&, timer_id_t) { return true; });
+    loop.add_timer(std::chrono::milliseconds{0}, 0, [&state, idle_timer](loop_t& loop, timer_id_t) {
+        loop.reset_timer(idle_timer);
+        return state.KeepRunning();
+    });
+
+    loop.run(false);
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["live_timers"] = static_cast<double>(num_live_timers);
+}
+BENCHMARK(BM_LoopTimerReset)->RangeMultiplier(8)->Range(1, 4096);
+
+/**
+ * Baseline of BM_LoopTimerReset: the idle timeout is postponed by removing the
+ * timer and adding a new one.
+ */
+void BM_LoopTimerRemoveAndAdd(benchmark::State& state) {
+    auto const num_live_timers = static_cast<std::size_t>(state.range(0));
+    loop_t loop;
+    for (std::size_t i = 0; i < num_live_timers; ++i) {
+        loop.add_timer(k_idle_timer_timeout, 0, [](loop_t&, timer_id_t) { return true; });
+    }
+    fn_timer_handler_t const idle_handler = [](loop_t&, timer_id_t) { return true; };
+    auto idle_timer = loop.add_timer(k_idle_timer_timeout, 1, idle_handler);
+    loop.add_timer(std::chrono::milliseconds{0}, 0, [&state, &idle_timer, &idle_handler](loop_t& loop, timer_id_t) {
+        loop.remove_timer(idle_timer);
+        idle_timer = loop.add_timer(k_idle_timer_timeout, 1, idle_handler);
+        return state.KeepRunning();
+    });
+
+    loop.run(false);
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["live_timers"] = static_cast<double>(num_live_timers);
+}
+BENCHMARK(BM_LoopTimerRemoveAndAdd)->RangeMultiplier(8)->Range(1, 4096);
+
+}  // namespace
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/poller.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+namespace {
+
+using namespace zmqzext;
+
+/**
+ * Cost of a non-blocking poller_t::wait_all() call with a growing number of
+ * registered sockets, one of which always has a pending message.
+ */
+void BM_PollerWaitAllVsSockets(benchmark::State& state) {
+    auto const num_sockets = static_cast<std::size_t>(state.range(0));
+    zmq::context_t ctx;
+    std::vector<zmq::socket_t> receivers;
+    std::vector<zmq::socket_t> senders;
+    receivers.reserve(num_sockets);
+    senders.reserve(num_sockets);
+    poller_t poller;
+    for (std::size_t i = 0; i < num_sockets; ++i) {
+        auto const endpoint = "inproc://czze-bench-poller-" + std::to_string(i);
+        receivers.emplace_back(ctx, zmq::socket_type::pair);
+        receivers.back().set(zmq::sockopt::linger, 0);
+        receivers.back().bind(endpoint);
+        senders.emplace_back(ctx, zmq::socket_type::pair);
+        senders.back().set(zmq::sockopt::linger, 0);
+        senders.back().connect(endpoint);
+        poller.add(receivers.back());
+    }
+    senders.back().send(zmq::str_buffer("msg"), zmq::send_flags::none);
+
+    for (auto _ : state) {
+        auto ready = poller.wait_all(std::chrono::milliseconds{0});
+        benchmark::DoNotOptimize(ready);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    state.counters["sockets"] = static_cast<double>(num_sockets);
+}
+BENCHMARK(BM_PollerWaitAllVsSockets)->RangeMultiplier(4)->Range(1, 256);
+
+}  // namespace
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/pubsub_hub.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+namespace {
+
+using namespace zmqzext;
+
+/// Payload of the published messages, large enough for libzmq to share it by reference counting.
+constexpr std::size_t k_payload_size = 256;
+
+/**
+ * Topics published in each iteration: one per subscriber, each subscribed to its
+ * own topic, or a single topic all the subscribers are subscribed to. Either way
+ * each subscriber receives one message per iteration.
+ */
+std::vector<std::string> round_topics(std::size_t subscribers, bool broadcast) {
+    if (broadcast) {
+        return {"broadcast"};
+    }
+    std::vector<std::string> topics;
+    for (std::size_t i = 0; i < subscribers; ++i) {
+        topics.push_back("topic/" + std::to_string(i));
+    }
+    return topics;
+}
+
+void publish_round(zmq::socket_t& publisher, std::vector<std::string> const& topics, std::string const& payload) {
+    for (auto const& topic : topics) {
+        publisher.send(zmq::buffer(topic), zmq::send_flags::sndmore);
+        publisher.send(zmq::buffer(payload), zmq::send_flags::none);
+    }
+}
+
+/**
+ * Publish rounds until every subscriber received a message, so that all the
+ * subscriptions are in place, then discard the messages received meanwhile.
+ */
+void wait_subscriptions(zmq::socket_t& publisher, std::vector<zmq::socket_t>& subscribers,
+                        std::vector<std::string> const& topics, std::string const& payload) {
+    std::vector<bool> ready(subscribers.size(), false);
+    auto remaining = subscribers.size();
+    zmq::message_t msg;
+    while (remaining > 0) {
+        publish_round(publisher, topics, payload);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        for (std::size_t i = 0; i < subscribers.size(); ++i) {
+            while (subscribers[i].recv(msg, zmq::recv_flags::dontwait)) {
+                if (!ready[i]) {
+                    ready[i] = true;
+                    --remaining;
+                }
+            }
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    for (auto& subscriber : subscribers) {
+        while (subscriber.recv(msg, zmq::recv_flags::dontwait)) {
+        }
+    }
+}
+
+void run_fan_out(benchmark::State& state, zmq::socket_t& publisher, std::vector<zmq::socket_t>& subscribers,
+                 std::vector<std::string> const& topics) {
+    std::string const payload(k_payload_size, 'x');
+    wait_subscriptions(publisher, subscribers, topics, payload);
+
+    zmq::message_t topic;
+    zmq::message_t body;
+    for (auto _ : state) {
+        publish_round(publisher, topics, payload);
+        for (auto& subscriber : subscribers) {
+            benchmark::DoNotOptimize(subscriber.recv(topic, zmq::recv_flags::none));
+            benchmark::DoNotOptimize(subscriber.recv(body, zmq::recv_flags::none));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * subscribers.size()));
+}
+
+/**
+ * Baseline: one PUB socket and one SUB socket per subscriber, libzmq filtering the subscriptions.
+ * Items are messages received by the subscribers.
+ */
+void BM_PubSubSubSockets(benchmark::State& state) {
+    auto const subscriber_count = static_cast<std::size_t>(state.range(0));
+    auto const topics = round_topics(subscriber_count, state.range(1) != 0);
+    zmq::context_t ctx;
+    zmq::socket_t publisher(ctx, zmq::socket_type::pub);
+    publisher.set(zmq::sockopt::linger, 0);
+    publisher.bind("inproc://bench-pubsub");
+
+    std::vector<zmq::socket_t> subscribers;
+    for (std::size_t i = 0; i < subscriber_count; ++i) {
+        subscribers.emplace_back(ctx, zmq::socket_type::sub);
+        subscribers.back().set(zmq::sockopt::linger, 0);
+        subscribers.back().set(zmq::sockopt::subscribe, topics.size() == 1 ? topics[0] : topics[i]);
+        subscribers.back().connect("inproc://bench-pubsub");
+    }
+
+    run_fan_out(state, publisher, subscribers, topics);
+}
+BENCHMARK(BM_PubSubSubSockets)
+    ->ArgsProduct({{16, 128, 512}, {0, 1}})
+    ->ArgNames({"subscribers", "broadcast"})
+    ->UseRealTime();
+
+/**
+ * pubsub_hub_t: publishers push to the hub actor, which matches each message once
+ * and fans it out to DEALER subscribers. Items are messages received by the subscribers.
+ */
+void BM_PubSubHub(benchmark::State& state) {
+    auto const subscriber_count = static_cast<std::size_t>(state.range(0));
+    auto const topics = round_topics(subscriber_count, state.range(1) != 0);
+    zmq::context_t ctx;
+    pubsub_hub_t hub(ctx);
+    zmq::socket_t publisher(ctx, zmq::socket_type::push);
+    publisher.set(zmq::sockopt::linger, 0);
+    publisher.connect(hub.publish_endpoint());
+
+    std::vector<zmq::socket_t> subscribers;
+    for (std::size_t i = 0; i < subscriber_count; ++i) {
+        subscribers.emplace_back(ctx, zmq::socket_type::dealer);
+        subscribers.back().set(zmq::sockopt::linger, 0);
+        subscribers.back().connect(hub.subscribe_endpoint());
+        subscribers.back().send(zmq::buffer("\x01" + (topics.size() == 1 ? topics[0] : topics[i])),
+                                zmq::send_flags::none);
+    }
+
+    run_fan_out(state, publisher, subscribers, topics);
+}
+BENCHMARK(BM_PubSubHub)
+    ->ArgsProduct({{16, 128, 512}, {0, 1}})
+    ->ArgNames({"subscribers", "broadcast"})
+    ->UseRealTime();
+
+}  // namespace
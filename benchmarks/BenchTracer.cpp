@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <cppzmqzoltanext/tracer.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace zmqzext;
+
+/**
+ * Cost of recording a begin/end pair with the tracer enabled (when compiled in).
+ */
+void BM_TraceScopeEnabled(benchmark::State& state) {
+    if (!is_tracing_compiled_in()) {
+        state.SkipWithError("Library built without CZZE_ENABLE_TRACING");
+        return;
+    }
+    enable_tracing();
+    for (auto _ : state) {
+        trace_scope_t scope("bench.scope");
+        benchmark::ClobberMemory();
+    }
+    disable_tracing();
+    clear_trace();
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * 2);
+}
+BENCHMARK(BM_TraceScopeEnabled);
+
+/**
+ * Cost of a trace scope while the tracer is disabled at runtime.
+ */
+void BM_TraceScopeDisabled(benchmark::State& state) {
+    disable_tracing();
+    for (auto _ : state) {
+        trace_scope_t scope("bench.scope");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TraceScopeDisabled);
+
+}  // namespace
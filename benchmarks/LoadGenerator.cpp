@@ -0,0 +1,284 @@
+/**
+ * Open-loop load generator for a loop_t based echo server.
+ *
+ * Ping-pong benchmarks are closed-loop: the next request is only sent once the
+ * previous reply is received, so when the server stalls the client stalls too
+ * and the requests that should have been sent meanwhile are never measured
+ * (coordinated omission). This tool sends requests at a fixed rate from a
+ * precomputed schedule instead, whatever the replies do, and measures each
+ * latency from the time the request was scheduled to be sent. Queueing delay,
+ * in the server or in the client falling behind its schedule, is thus part of
+ * the measurement, and the saturation point of the server shows as the rate
+ * where the percentiles take off.
+ *
+ * Each run pushes requests to a server thread running a loop_t, which
+ * optionally spins for a given work time per request and pushes it back. The
+ * latencies are recorded into histogram_t instances; the latency from the
+ * actual send time is reported next to it to show what a closed-loop
+ * measurement would miss.
+ *
+ * Usage:
+ *   cppzmqzoltanext_LoadGenerator [--transports inproc,ipc,tcp] [--rates 10000,50000,100000,200000]
+ *                                 [--duration 2] [--size 64] [--work-ns 0]
+ */
+
+#include <cppzmqzoltanext/histogram.h>
+#include <cppzmqzoltanext/loop.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+#if !defined(WIN32)
+#include <unistd.h>
+#endif
+
+namespace {
+
+using namespace zmqzext;
+using clock_type = std::chrono::steady_clock;
+
+/// Header of every request, followed by padding up to the payload size.
+struct request_header_t {
+    std::uint64_t intended_ns;  ///< Scheduled send time, in nanoseconds since the start of the run
+    std::uint64_t sent_ns;      ///< Actual send time, in nanoseconds since the start of the run
+};
+
+/// Time a reply is waited for after the last request was sent, before it is counted as lost.
+constexpr std::chrono::seconds k_drain_timeout{5};
+
+struct options_t {
+    std::vector<std::string> transports{"inproc", "ipc", "tcp"};
+    std::vector<std::uint64_t> rates{10000, 50000, 100000, 200000};
+    std::chrono::duration<double> duration{2.0};
+    std::size_t size{64};
+    std::chrono::nanoseconds work{0};
+};
+
+struct run_result_t {
+    std::uint64_t sent{0};
+    std::uint64_t received{0};
+    std::chrono::nanoseconds elapsed{0};
+    histogram_snapshot_t intended;  ///< Latencies from the scheduled send times
+    histogram_snapshot_t service;   ///< Latencies from the actual send times
+};
+
+std::vector<std::string> split(std::string const& list) {
+    std::vector<std::string> items;
+    std::istringstream stream{list};
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+options_t parse_options(int argc, char** argv) {
+    options_t options;
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for option " + arg);
+        }
+        std::string const value = argv[++i];
+        if (arg == "--transports") {
+            options.transports = split(value);
+        } else if (arg == "--rates") {
+            options.rates.clear();
+            for (auto const& rate : split(value)) {
+                options.rates.push_back(std::stoull(rate));
+            }
+        } else if (arg == "--duration") {
+            options.duration = std::chrono::duration<double>{std::stod(value)};
+        } else if (arg == "--size") {
+            options.size = std::stoul(value);
+        } else if (arg == "--work-ns") {
+            options.work = std::chrono::nanoseconds{std::stoll(value)};
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    for (auto const rate : options.rates) {
+        if (rate == 0) {
+            throw std::invalid_argument("Rates must be positive");
+        }
+    }
+    if (options.size < sizeof(request_header_t)) {
+        options.size = sizeof(request_header_t);
+    }
+    return options;
+}
+
+/// Endpoints are unique to each run: the sockets of the previous run may still be closing in the background.
+std::string bind_endpoint(std::string const& transport, std::uint64_t run_id, char const* direction) {
+    if (transport == "inproc") {
+        return "inproc://load-generator-" + std::to_string(run_id) + "-" + direction;
+    }
+    if (transport == "tcp") {
+        return "tcp://127.0.0.1:*";
+    }
+#if !defined(WIN32)
+    if (transport == "ipc") {
+        return "ipc:///tmp/czze-load-generator-" + std::to_string(::getpid()) + "-" + std::to_string(run_id) + "-" +
+               direction;
+    }
+#endif
+    throw std::invalid_argument("Unsupported transport " + transport);
+}
+
+std::uint64_t since(clock_type::time_point start) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count());
+}
+
+/**
+ * Echo server: a loop_t receiving requests on a PULL socket and pushing them back,
+ * after spinning for the configured work time. It stops on an empty frame.
+ */
+void run_server(zmq::socket_t& requests, zmq::socket_t& replies, std::chrono::nanoseconds work) {
+    loop_t loop;
+    loop.add(requests, [&replies, work](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        while (socket.recv(msg, zmq::recv_flags::dontwait)) {
+            if (msg.size() == 0) {
+                return false;
+            }
+            if (work.count() > 0) {
+                auto const until = clock_type::now() + work;
+                while (clock_type::now() < until) {
+                }
+            }
+            replies.send(msg, zmq::send_flags::none);
+        }
+        return true;
+    });
+    loop.run(false);
+}
+
+run_result_t run(zmq::context_t& ctx, std::string const& transport, std::uint64_t rate, options_t const& options) {
+    zmq::socket_t client_requests(ctx, zmq::socket_type::push);
+    zmq::socket_t server_requests(ctx, zmq::socket_type::pull);
+    zmq::socket_t server_replies(ctx, zmq::socket_type::push);
+    zmq::socket_t client_replies(ctx, zmq::socket_type::pull);
+    for (auto* socket : {&client_requests, &server_requests, &server_replies, &client_replies}) {
+        socket->set(zmq::sockopt::linger, 0);
+        // Buffer at least one second of requests, so the client is not blocked by the high water mark
+        socket->set(zmq::sockopt::sndhwm, static_cast<int>(rate));
+        socket->set(zmq::sockopt::rcvhwm, static_cast<int>(rate));
+    }
+    static std::uint64_t run_count = 0;
+    auto const run_id = run_count++;
+    server_requests.bind(bind_endpoint(transport, run_id, "requests"));
+    client_requests.connect(server_requests.get(zmq::sockopt::last_endpoint));
+    client_replies.bind(bind_endpoint(transport, run_id, "replies"));
+    server_replies.connect(client_replies.get(zmq::sockopt::last_endpoint));
+
+    std::thread server_thread{[&]() { run_server(server_requests, server_replies, options.work); }};
+
+    auto const period = std::chrono::nanoseconds{1000000000} / static_cast<double>(rate);
+    auto const count = static_cast<std::uint64_t>(options.duration.count() * static_cast<double>(rate));
+    // Give the connections time to be established before the schedule starts
+    auto const start = clock_type::now() + std::chrono::milliseconds{100};
+
+    std::thread client_thread{[&]() {
+        std::vector<char> payload(options.size, 'x');
+        request_header_t header{};
+        for (std::uint64_t i = 0; i < count; ++i) {
+            auto const intended = start + std::chrono::duration_cast<std::chrono::nanoseconds>(period * i);
+            // Sleep while far from the scheduled time, then spin to send on time
+            if (intended - clock_type::now() > std::chrono::microseconds{200}) {
+                std::this_thread::sleep_until(intended - std::chrono::microseconds{100});
+            }
+            while (clock_type::now() < intended) {
+            }
+            header.intended_ns = static_cast<std::uint64_t>((intended - start).count());
+            header.sent_ns = since(start);
+            std::memcpy(payload.data(), &header, sizeof(header));
+            client_requests.send(zmq::buffer(payload), zmq::send_flags::none);
+        }
+    }};
+
+    histogram_t intended;
+    histogram_t service;
+    run_result_t result;
+    result.sent = count;
+    zmq::message_t msg;
+    client_replies.set(zmq::sockopt::rcvtimeo, static_cast<int>(std::chrono::milliseconds{k_drain_timeout}.count()));
+    while (result.received < count && client_replies.recv(msg, zmq::recv_flags::none)) {
+        auto const now_ns = since(start);
+        request_header_t header;
+        std::memcpy(&header, msg.data(), sizeof(header));
+        intended.record(now_ns - header.intended_ns);
+        service.record(now_ns - header.sent_ns);
+        ++result.received;
+    }
+    result.elapsed = clock_type::now() - start;
+
+    client_thread.join();
+    client_requests.send(zmq::message_t{}, zmq::send_flags::none);
+    server_thread.join();
+
+    result.intended = intended.snapshot();
+    result.service = service.snapshot();
+    return result;
+}
+
+void print_header() {
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s %10s %10s %10s %12s\n", "", "target", "achieved", "lost",
+                "p50", "p90", "p99", "p99.9", "p99.99", "max", "service p99");
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s %10s %10s %10s %12s\n", "", "(msg/s)", "(msg/s)", "", "(us)",
+                "(us)", "(us)", "(us)", "(us)", "(us)", "(us)");
+}
+
+void print_result(std::string const& transport, std::uint64_t rate, run_result_t const& result) {
+    auto const us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    auto const seconds = std::chrono::duration<double>{result.elapsed}.count();
+    auto const& latency = result.intended;
+    std::printf("%-8s %10llu %10.0f %10llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %12.1f\n", transport.c_str(),
+                static_cast<unsigned long long>(rate), static_cast<double>(result.received) / seconds,
+                static_cast<unsigned long long>(result.sent - result.received), us(latency.value_at_percentile(50.0)),
+                us(latency.value_at_percentile(90.0)), us(latency.value_at_percentile(99.0)),
+                us(latency.value_at_percentile(99.9)), us(latency.value_at_percentile(99.99)), us(latency.max()),
+                us(result.service.value_at_percentile(99.0)));
+    std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    options_t options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << "\n"
+                  << "Usage: " << argv[0]
+                  << " [--transports inproc,ipc,tcp] [--rates 10000,50000] [--duration seconds] [--size bytes]"
+                     " [--work-ns ns]\n";
+        return EXIT_FAILURE;
+    }
+
+    zmq::context_t ctx;
+    print_header();
+    for (auto const& transport : options.transports) {
+        for (auto const rate : options.rates) {
+            try {
+                print_result(transport, rate, run(ctx, transport, rate, options));
+            } catch (std::exception const& e) {
+                std::cerr << transport << " at " << rate << " msg/s: " << e.what() << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -58,6 +58,13 @@ SOFTWARE.
  * exceptions within the user function. Still, the actor_t class will catch
  * unhandled exceptions and silently exit the thread to avoid crashing the application.
  *
+ * Ring Pipe
+ *
+ * Optionally, an actor can be started with a ring_pipe_t in addition to the PAIR
+ * sockets. The ring pipe is a lock-free in-process channel suited for high rates of
+ * small messages between the parent and the actor. The PAIR sockets keep carrying
+ * the initialization and stop signals, so the synchronization protocol is the same.
+ *
  * Finalization Synchronization
  *
  * The user function finalization is requested by the stop() method which can be called
@@ -73,7 +80,10 @@ SOFTWARE.
  * - Thread-safe concurrent execution with minimal synchronization
  * - Isolated computational units that don't share memory
  * - Message-based communication between parent and child threads
+ * - Optional lock-free ring pipe for high rate parent/child messaging
  * - Exception handling and propagation from child to parent during initialization
+ * - CPU time and context switches of the actor thread
+ * - Optional histogram of the start and stop round trips through the pipe
  * - Automatic cleanup and resource management
  *
  * @authors
@@ -94,6 +104,9 @@ SOFTWARE.
 #include <zmq.hpp>
 
 #include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/histogram.h"
+#include "cppzmqzoltanext/ring_pipe.h"
+#include "cppzmqzoltanext/thread_usage.h"
 
 namespace zmqzext {
 
@@ -120,6 +133,20 @@ namespace zmqzext {
  */
 using actor_fn_t = std::function<bool(zmq::socket_t&)>;
 
+/**
+ * @brief Alias for a function type used to define actor behaviors with a ring pipe.
+ *
+ * Same contract as actor_fn_t, with the child endpoint of the actor ring pipe
+ * passed as an additional parameter. Signals are still exchanged through the socket.
+ *
+ * @param socket Reference to a ZeroMQ socket used by the actor for signals.
+ * @param pipe Reference to the child endpoint of the ring pipe.
+ * @return true to finish with a success signal, false to finish with a failure
+ * signal.
+ * @see actor_t::start(actor_pipe_fn_t, std::size_t)
+ */
+using actor_pipe_fn_t = std::function<bool(zmq::socket_t&, ring_pipe_t&)>;
+
 /**
  * @brief Class that implements the Actor pattern using ZMQ PAIR sockets
  *
@@ -222,6 +249,21 @@ public:
      */
     void start(actor_fn_t func);
 
+    /**
+     * @brief Starts the actor thread with the provided function and a ring pipe
+     *
+     * Creates a ring_pipe_t pair, keeps the parent endpoint (see pipe()) and
+     * passes the child endpoint to the function. Otherwise behaves as start(actor_fn_t).
+     *
+     * @param func The function to be executed in the new thread. Must take a
+     * zmq::socket_t& and a ring_pipe_t& and return bool
+     * @param pipe_capacity Capacity in bytes of each direction of the ring pipe
+     * @throws std::runtime_error If the thread was already started or if the
+     * function signals failure during function initialization
+     * @throws Rethrows any exception caught during function initialization
+     */
+    void start(actor_pipe_fn_t func, std::size_t pipe_capacity);
+
     /**
      * @brief Stops the actor thread
      *
@@ -244,6 +286,21 @@ public:
      */
     zmq::socket_t& socket() noexcept { return _parent_socket; }
 
+    /**
+     * @brief Gets the parent endpoint of the ring pipe
+     *
+     * @return ring_pipe_t& Reference to the parent endpoint
+     * @throws std::runtime_error If the actor was not started with a ring pipe
+     */
+    ring_pipe_t& pipe();
+
+    /**
+     * @brief Checks if the actor was started with a ring pipe
+     *
+     * @return true if a ring pipe is available, false otherwise
+     */
+    bool has_pipe() const noexcept { return _pipe != nullptr; }
+
     /**
      * @brief Checks if the actor thread was started
      *
@@ -258,6 +315,32 @@ public:
      */
     bool is_stopped() const noexcept { return _stopped; }
 
+    /**
+     * @brief Gets the resource usage of the actor thread
+     *
+     * The CPU time is read live while the actor function runs (on Linux), so a
+     * busy actor can be spotted from the parent thread. The context switches
+     * can only be sampled by the actor thread itself: they are sampled when
+     * the actor function returns, and are 0 until then.
+     *
+     * @return Usage of the actor thread, all 0 before it is started
+     * @see current_thread_usage()
+     */
+    thread_usage_t usage() const;
+
+    /**
+     * @brief Record the round trips of the actor pipe into a histogram
+     *
+     * Records the time from the start request until the initialization signal
+     * is received, and from the stop request until its response is received.
+     * Messages exchanged by the application on socket() are not seen by the
+     * actor, so their round trips are recorded by the caller into the same
+     * histogram if wanted. The histogram must outlive the actor.
+     *
+     * @param histogram Histogram to record into, or nullptr to stop recording.
+     */
+    void set_round_trip_histogram(histogram_t* histogram) noexcept { _round_trip_histogram = histogram; }
+
     /**
      * @brief Sets the timeout value used in the destructor
      * @param timeout The timeout value in milliseconds
@@ -285,6 +368,12 @@ private:
         std::exception_ptr saved_exception;
     };
 
+    /**
+     * @brief Struct containing the usage of the execution thread, shared with the actor,
+     * defined with the platform specific CPU clock of the thread
+     */
+    struct SharedUsageState;
+
     /**
      * @brief Executes the user function and handles signals
      *
@@ -296,9 +385,11 @@ private:
      * @param func The user function to execute
      * @param socket The socket to use for communication, takes ownership
      * @param exception_state The shared exception state for error handling
+     * @param usage_state The shared usage state of the thread
      */
     void execute(actor_fn_t func, std::unique_ptr<zmq::socket_t> socket,
-                 std::shared_ptr<SharedExceptionState> exception_state) noexcept;
+                 std::shared_ptr<SharedExceptionState> exception_state,
+                 std::shared_ptr<SharedUsageState> usage_state) noexcept;
 
     /**
      * @brief Binds the parent socket to a unique address
@@ -311,12 +402,24 @@ private:
      */
     std::string bind_to_unique_address();
 
+    /**
+     * @brief Records a pipe round trip started at request_time, if a histogram is set
+     */
+    void record_round_trip(std::chrono::steady_clock::time_point request_time) noexcept {
+        if (_round_trip_histogram != nullptr) {
+            _round_trip_histogram->record(std::chrono::steady_clock::now() - request_time);
+        }
+    }
+
     zmq::socket_t _parent_socket;
     std::unique_ptr<zmq::socket_t> _child_socket;
     std::shared_ptr<SharedExceptionState> _exception_state;
+    std::shared_ptr<SharedUsageState> _usage_state;
+    std::unique_ptr<ring_pipe_t> _pipe;
     bool _started;
     bool _stopped;
     std::chrono::milliseconds _timeout_on_destructor{DEFAULT_DESTRUCTOR_TIMEOUT};
+    histogram_t* _round_trip_histogram{nullptr};
 };
 
 }  // namespace zmqzext
@@ -0,0 +1,231 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file broker.h
+ * @brief Majordomo-style service broker running on an event loop
+ *
+ * This header provides the broker_t class, a service-oriented broker that
+ * routes requests from clients to pools of workers by service name, following
+ * the Majordomo Protocol (ZeroMQ RFC 7/MDP). A single broker serves any number
+ * of services on one ROUTER socket.
+ *
+ * Client request:  [envelope...][empty]["MDPC01"][service][body...]
+ * Client reply:    [envelope...][empty]["MDPC01"][service][body...]
+ * Worker commands: [empty]["MDPW01"][command][...]
+ * - READY:      [service]
+ * - REQUEST:    [client envelope...][empty][body...] (broker to worker)
+ * - REPLY:      [client envelope...][empty][body...] (worker to broker)
+ * - HEARTBEAT
+ * - DISCONNECT
+ *
+ * The client envelope is made of every frame before the first empty frame, so
+ * REQ clients as well as DEALER clients adding their own correlation frames
+ * (e.g. reliable_client_t) are supported. Workers echo it back with the reply.
+ *
+ * @details
+ * Key features:
+ * - Hash map of services, each with its queue of waiting workers (least recently used first)
+ *   and its queue of pending requests
+ * - Requests queued until a worker of their service is ready, or dropped after a timeout
+ * - Worker and request expiry driven by a single timer and lists ordered by expiry
+ * - Frames forwarded by moving them between messages, without copying their content
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/// Protocol header of the messages between clients and the broker
+constexpr char mdp_client_header[] = "MDPC01";
+
+/// Protocol header of the messages between workers and the broker
+constexpr char mdp_worker_header[] = "MDPW01";
+
+/**
+ * @brief Commands between workers and the broker, sent as a single byte frame
+ */
+enum class mdp_command_t : std::uint8_t {
+    ready = 1,      ///< Worker is ready to handle requests of a service
+    request = 2,    ///< Request from the broker to a worker
+    reply = 3,      ///< Reply from a worker to the broker
+    heartbeat = 4,  ///< Liveness signal, in both directions
+    disconnect = 5  ///< The peer must consider the connection closed
+};
+
+/**
+ * @brief Options of a broker_t
+ */
+struct broker_options_t {
+    std::chrono::milliseconds heartbeat_interval{2500};  ///< Interval between heartbeats to waiting workers
+    std::size_t heartbeat_liveness{3};                   ///< Intervals without message before a worker expires
+    std::chrono::milliseconds request_timeout{10000};    ///< Time a request waits for a worker before being dropped
+};
+
+/**
+ * @brief Majordomo-style broker routing requests to workers by service name
+ *
+ * Workers only receive a request when they are waiting, i.e. after READY or
+ * after the REPLY to their previous request. Workers that stay silent for
+ * heartbeat_liveness heartbeat intervals are forgotten, busy ones included, so
+ * workers must keep sending heartbeats while handling a request. Requests are
+ * not retried by the broker: the request of a forgotten busy worker is lost,
+ * and requests waiting request_timeout for a worker are dropped, so that
+ * unknown services do not accumulate requests. Clients are expected to retry
+ * requests left without reply.
+ *
+ * @note The broker must be destroyed before the loop.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT broker_t {
+public:
+    /**
+     * @brief Construct a broker with an unbound ROUTER socket
+     *
+     * @param context ZMQ context of the ROUTER socket
+     * @param loop Loop running the socket handler and the heartbeat timer
+     * @param options Broker options
+     * @throws std::invalid_argument If the heartbeat interval or the request timeout is not positive or the
+     * liveness is 0
+     */
+    broker_t(zmq::context_t& context, loop_t& loop, broker_options_t options = broker_options_t{});
+
+    broker_t(broker_t const&) = delete;
+    broker_t& operator=(broker_t const&) = delete;
+
+    /**
+     * @brief Remove the socket and the heartbeat timer from the loop
+     */
+    ~broker_t() noexcept;
+
+    /**
+     * @brief Bind the broker socket to an endpoint, for clients and workers alike
+     *
+     * @param endpoint Endpoint to bind to
+     * @throws zmq::error_t If binding fails
+     */
+    void bind(std::string const& endpoint);
+
+    /**
+     * @brief Get the number of services known, with workers or pending requests
+     */
+    std::size_t service_count() const noexcept { return _services.size(); }
+
+    /**
+     * @brief Get the number of workers connected, waiting or busy
+     */
+    std::size_t worker_count() const noexcept { return _workers.size(); }
+
+    /**
+     * @brief Get the number of workers of a service waiting for a request
+     */
+    std::size_t waiting_workers(std::string const& service) const;
+
+    /**
+     * @brief Get the number of requests of a service waiting for a worker
+     */
+    std::size_t pending_requests(std::string const& service) const;
+
+private:
+    struct worker_t;
+
+    /**
+     * @brief Service with its waiting workers and pending requests
+     */
+    struct service_t {
+        std::list<worker_t*> waiting;                      ///< Waiting workers, least recently used first
+        std::deque<std::vector<zmq::message_t>> requests;  ///< Pending client requests, as received
+        std::size_t workers{0};                            ///< Workers of the service, waiting or busy
+        std::uint64_t queued{0};                           ///< Requests queued so far, numbering them
+        std::uint64_t dequeued{0};                         ///< Requests dispatched or dropped so far
+        std::uint64_t expired{0};                          ///< Requests whose expiry entry was handled
+    };
+
+    /**
+     * @brief Expiry of a queued request, in arrival order
+     */
+    struct request_expiry_t {
+        std::chrono::steady_clock::time_point expiry;  ///< Time at which the request is dropped if still queued
+        std::string const* service_name;               ///< Name of the request service
+        std::uint64_t sequence;                        ///< Number of the request in its service
+    };
+
+    /**
+     * @brief Worker known by the broker
+     */
+    struct worker_t {
+        std::string identity;                             ///< Routing identity
+        std::string const* service_name{nullptr};         ///< Name of the worker service
+        service_t* service{nullptr};                      ///< Worker service
+        std::chrono::steady_clock::time_point expiry;     ///< Time at which the worker expires if silent
+        bool waiting{false};                              ///< Whether the worker waits for a request
+        std::list<worker_t*>::iterator service_position;  ///< Position in the waiting workers of the service
+        std::list<worker_t*>::iterator expiry_position;   ///< Position in the workers by expiry
+    };
+
+    bool on_message(zmq::socket_ref socket);
+    void on_client(std::vector<zmq::message_t>& frames, std::size_t delimiter);
+    void on_worker(std::vector<zmq::message_t>& frames);
+    bool on_heartbeat();
+    void dispatch(service_t& service);
+    void send_request(worker_t& worker, std::vector<zmq::message_t>& request);
+    void send_command(std::string const& identity, mdp_command_t command);
+    void refresh(worker_t& worker);
+    void set_waiting(worker_t& worker);
+    void disconnect(worker_t* worker);
+    void delete_worker(worker_t& worker, bool disconnect);
+    void delete_service_if_unused(std::string const& name);
+
+    loop_t& _loop;                                         ///< Loop running the handlers
+    broker_options_t _options;                             ///< Broker options
+    zmq::socket_t _socket;                                 ///< ROUTER socket of clients and workers
+    timer_id_t _heartbeat_timer{0};                        ///< Heartbeat and expiry timer
+    std::unordered_map<std::string, service_t> _services;  ///< Services by name
+    std::unordered_map<std::string, worker_t> _workers;    ///< Workers by identity
+    std::list<worker_t*> _expiry;                          ///< Workers, waiting or busy, soonest to expire first
+    std::deque<request_expiry_t> _request_expiry;          ///< Queued requests, soonest to expire first
+    std::string _key;                                      ///< Lookup key buffer, reused to avoid allocations
+};
+
+}  // namespace zmqzext
@@ -0,0 +1,201 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file coalescing_sender.h
+ * @brief Coalescing of small records into batch messages, Nagle style
+ *
+ * This header provides the coalescing_sender_t class, which appends small
+ * records to a batch and sends the batch as a single message when it reaches
+ * a size threshold or when a loop_t timer expires, whichever comes first. The
+ * per-message costs of ZMQ (allocation, pipe write, wake-up of the receiver)
+ * are paid once per batch instead of once per record, at the price of a bounded
+ * added latency.
+ *
+ * The batch_reader_t class splits a received batch back into its records,
+ * which are views into the received message, without copying them.
+ *
+ * Batch format: a sequence of records, each one a length encoded as an unsigned
+ * LEB128 varint (one byte for records up to 127 bytes) followed by the bytes of
+ * the record.
+ *
+ * @details
+ * Key features:
+ * - Flush on size threshold or on flush interval, driven by the loop
+ * - Batch buffer reused across flushes, no allocation per record
+ * - Flush retried when the socket is writable again if its high water mark is reached
+ * - Optional bound of the batch growing while the socket is blocked
+ * - Zero-copy splitting of batches on the receiver side
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Options of a coalescing_sender_t
+ */
+struct coalescing_options_t {
+    std::size_t max_batch_size{64 * 1024};        ///< Batch size in bytes that triggers a flush
+    std::chrono::milliseconds flush_interval{1};  ///< Maximum delay of a record before its batch is flushed
+    std::size_t max_blocked_size{0};              ///< Batch size in bytes refusing records while blocked, 0 for none
+};
+
+/**
+ * @brief Sender coalescing small records into batch messages flushed by size or by timer
+ *
+ * Records larger than the threshold are sent in a batch of their own, after
+ * the records pending before them. If the socket cannot take a batch (high
+ * water mark reached), the batch is kept, new records are appended to it and
+ * it is sent as soon as the socket is writable again.
+ *
+ * @note All the records sent on the socket must go through the sender to keep their order.
+ * @note The sender must be destroyed before the loop and the socket.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT coalescing_sender_t {
+public:
+    /**
+     * @brief Construct a sender in front of a socket
+     *
+     * @param loop Loop running the flush timer
+     * @param socket Socket the batches are sent on
+     * @param options Sender options
+     * @throws std::invalid_argument If the socket is invalid, max_batch_size is 0 or flush_interval is negative
+     */
+    coalescing_sender_t(loop_t& loop, zmq::socket_ref socket, coalescing_options_t options = coalescing_options_t{});
+
+    coalescing_sender_t(coalescing_sender_t const&) = delete;
+    coalescing_sender_t& operator=(coalescing_sender_t const&) = delete;
+
+    /**
+     * @brief Remove the flush timer from the loop
+     *
+     * Pending records are sent if the socket can take them now, otherwise discarded.
+     */
+    ~coalescing_sender_t() noexcept;
+
+    /**
+     * @brief Append a record to the batch, flushing it if the size threshold is reached
+     *
+     * While a flush is blocked by the high water mark of the socket, records keep
+     * being appended and the batch is only sent once the socket is writable again.
+     *
+     * @param record Bytes of the record, copied into the batch
+     * @return true if the record was appended, false if it was refused because the
+     *         socket is blocked and the batch reached max_blocked_size
+     * @throws zmq::error_t If sending fails for a reason other than the socket being full
+     */
+    bool send(zmq::const_buffer const& record);
+
+    /**
+     * @brief Send the pending records now
+     *
+     * @return true if the batch was sent or there was none, false if the socket cannot take it now
+     * @throws zmq::error_t If sending fails for a reason other than the socket being full
+     */
+    bool flush();
+
+    /**
+     * @brief Get the number of records waiting to be sent
+     */
+    std::size_t pending_records() const noexcept { return _records; }
+
+    /**
+     * @brief Get the number of bytes of the batch waiting to be sent
+     */
+    std::size_t pending_bytes() const noexcept { return _batch.size(); }
+
+private:
+    bool on_timer();
+    bool on_writable();
+    void cancel_timer() noexcept;
+
+    loop_t& _loop;                     ///< Loop running the flush timer
+    zmq::socket_ref _socket;           ///< Destination socket
+    coalescing_options_t _options;     ///< Sender options
+    std::vector<char> _batch;          ///< Batch being filled, reused across flushes
+    std::size_t _records{0};           ///< Records in the batch
+    timer_id_t _timer{0};              ///< Flush timer, while armed
+    bool _timer_armed{false};          ///< Whether the flush timer is armed
+    bool _writable_registered{false};  ///< Whether the socket is registered in the loop for a blocked flush
+};
+
+/**
+ * @brief Reader splitting a batch received from a coalescing_sender_t into its records
+ *
+ * @code
+ * batch_reader_t reader{msg};
+ * zmq::const_buffer record;
+ * while (reader.next(record)) {
+ *     ...
+ * }
+ * @endcode
+ *
+ * @note The records point into the message, which must outlive them.
+ */
+class CZZE_EXPORT batch_reader_t {
+public:
+    /**
+     * @brief Construct a reader of a batch message
+     */
+    explicit batch_reader_t(zmq::message_t const& batch) noexcept
+        : _position(batch.data<unsigned char>()), _end(_position + batch.size()) {}
+
+    /**
+     * @brief Construct a reader of a batch in a buffer
+     */
+    explicit batch_reader_t(zmq::const_buffer const& batch) noexcept
+        : _position(static_cast<unsigned char const*>(batch.data())), _end(_position + batch.size()) {}
+
+    /**
+     * @brief Get the next record of the batch
+     *
+     * @param record Set to the bytes of the record, in the batch
+     * @return true if a record was read, false at the end of the batch
+     * @throws std::runtime_error If the batch is malformed
+     */
+    bool next(zmq::const_buffer& record);
+
+private:
+    unsigned char const* _position;  ///< Start of the next record
+    unsigned char const* _end;       ///< End of the batch
+};
+
+}  // namespace zmqzext
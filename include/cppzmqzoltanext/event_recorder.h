@@ -0,0 +1,239 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file event_recorder.h
+ * @brief Record and replay of the message and timer events of a loop_t
+ *
+ * This header provides the event_recorder_t and event_replayer_t classes, to
+ * reproduce offline the traffic shape a set of loop_t handlers met in
+ * production. The recorder registers the handlers in the loop and writes every
+ * message they receive and every timer expiration they handle, with its
+ * monotonic time, to a compact binary file before calling them. The replayer
+ * loads such a file and feeds the events back into the same handlers, either
+ * at the recorded pace or as fast as possible, so the handlers can be profiled
+ * against production traffic on a development machine.
+ *
+ * The recorded handlers receive whole messages, all their frames, instead of
+ * a readable socket, so that they can be called the same way on replay. Events
+ * are tagged by a channel number chosen by the application, which maps them to
+ * the handler to call on replay.
+ *
+ * File format: an 8 byte magic ("CZZEREC1") followed by the events. Each event
+ * is a kind byte followed by unsigned LEB128 varints: the channel, the time in
+ * nanoseconds since the previous event and, for a timer, the timer ID or, for
+ * a message, the number of frames then the size and bytes of each frame.
+ *
+ * @details
+ * Key features:
+ * - Messages and timer expirations recorded with their monotonic time
+ * - Compact varint encoding, buffered writes
+ * - Replay at the recorded pace or as fast as possible
+ * - Replay statistics: events and duration, for throughput measurements
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/// Number tagging the events of a handler in a recording
+using event_channel_t = std::uint32_t;
+
+/**
+ * @brief Handler of the messages of a recorded channel
+ *
+ * Called with each message received on the socket of the channel, or read
+ * from the recording on replay. Returning false finishes the loop, or the
+ * replay.
+ *
+ * @param loop Reference to the event loop
+ * @param channel Channel of the message
+ * @param frames Frames of the message, which may be moved from
+ * @return true to continue, false to finish the loop or the replay
+ */
+using fn_message_handler_t = std::function<bool(loop_t&, event_channel_t, std::vector<zmq::message_t>&)>;
+
+/**
+ * @brief Recorder of the messages and timer expirations handled in a loop
+ *
+ * @note The recorder must outlive the handlers it registered, or remove them first.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT event_recorder_t {
+public:
+    /**
+     * @brief Create a recording file
+     *
+     * @param path Path of the file, truncated if it exists
+     * @throws std::system_error If the file cannot be created
+     */
+    explicit event_recorder_t(std::string const& path);
+
+    event_recorder_t(event_recorder_t const&) = delete;
+    event_recorder_t& operator=(event_recorder_t const&) = delete;
+
+    /**
+     * @brief Write the buffered events and close the file
+     */
+    ~event_recorder_t() noexcept;
+
+    /**
+     * @brief Register a socket in a loop, recording each message before passing it to a handler
+     *
+     * The loop handler receives one whole message per call.
+     *
+     * @param loop Loop to register the socket in
+     * @param socket Socket to receive the messages from
+     * @param channel Channel of the messages in the recording
+     * @param fn Handler of the messages
+     * @throws std::invalid_argument If the socket is invalid or already registered in the loop
+     */
+    void add(loop_t& loop, zmq::socket_ref socket, event_channel_t channel, fn_message_handler_t fn);
+
+    /**
+     * @brief Register a timer in a loop, recording each expiration before calling its handler
+     *
+     * @param loop Loop to register the timer in
+     * @param timeout Duration between timer expirations
+     * @param occurences Number of times the timer should fire (0 for infinite)
+     * @param channel Channel of the expirations in the recording
+     * @param fn Handler of the expirations
+     * @return Identifier of the timer in the loop
+     * @see loop_t::add_timer()
+     */
+    timer_id_t add_timer(loop_t& loop, std::chrono::milliseconds timeout, std::size_t occurences,
+                         event_channel_t channel, fn_timer_handler_t fn);
+
+    /**
+     * @brief Write the buffered events to the file
+     *
+     * Events are otherwise written when the buffer is full and when the recorder is destroyed.
+     *
+     * @throws std::system_error If writing fails
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of events recorded
+     */
+    std::uint64_t events() const noexcept { return _events; }
+
+private:
+    void record_timer(event_channel_t channel, timer_id_t timer_id);
+    void record_message(event_channel_t channel, std::vector<zmq::message_t> const& frames);
+    void write_event_header(std::uint8_t kind, event_channel_t channel);
+
+    std::FILE* _file;                                     ///< Recording file
+    std::vector<char> _buffer;                            ///< Events not written yet
+    std::chrono::steady_clock::time_point _last_event{};  ///< Time of the last event, the recorder creation at first
+    std::uint64_t _events{0};                             ///< Events recorded
+};
+
+/**
+ * @brief Pace of a replay
+ */
+enum class replay_speed_t {
+    recorded,  ///< Events are replayed at the times they were recorded, relative to the start of the replay
+    fastest,   ///< Events are replayed back to back
+};
+
+/**
+ * @brief Statistics of a replay
+ */
+struct replay_stats_t {
+    std::uint64_t messages{0};             ///< Messages passed to a handler
+    std::uint64_t timers{0};               ///< Timer expirations passed to a handler
+    std::uint64_t skipped{0};              ///< Events of channels without handler
+    std::chrono::nanoseconds duration{0};  ///< Duration of the replay
+};
+
+/**
+ * @brief Replayer of a recording into message and timer handlers
+ *
+ * Handlers are called directly, in the calling thread, with the loop given to
+ * replay(), which is not run: the timer expirations come from the recording.
+ *
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT event_replayer_t {
+public:
+    /**
+     * @brief Load a recording in memory, so that replaying it does not wait for the disk
+     *
+     * @param path Path of the recording
+     * @throws std::system_error If the file cannot be read
+     * @throws std::runtime_error If the file is not a recording
+     */
+    explicit event_replayer_t(std::string const& path);
+
+    /**
+     * @brief Set the handler of the messages of a channel
+     */
+    void on_message(event_channel_t channel, fn_message_handler_t fn);
+
+    /**
+     * @brief Set the handler of the timer expirations of a channel
+     *
+     * The handler is called with the timer ID of the recording.
+     */
+    void on_timer(event_channel_t channel, fn_timer_handler_t fn);
+
+    /**
+     * @brief Replay the recording, until its end or until a handler returns false
+     *
+     * @param loop Loop passed to the handlers
+     * @param speed Pace of the replay
+     * @return Statistics of the replay
+     * @throws std::runtime_error If the recording is malformed
+     */
+    replay_stats_t replay(loop_t& loop, replay_speed_t speed = replay_speed_t::recorded);
+
+private:
+    std::vector<char> _recording;                               ///< Content of the recording file
+    std::map<event_channel_t, fn_message_handler_t> _messages;  ///< Message handlers by channel
+    std::map<event_channel_t, fn_timer_handler_t> _timers;      ///< Timer handlers by channel
+    std::vector<zmq::message_t> _frames;                        ///< Frames of the message being replayed
+};
+
+}  // namespace zmqzext
@@ -0,0 +1,245 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file green_actor.h
+ * @brief Lightweight actors multiplexed on the thread of a loop_t
+ *
+ * This header provides the green_actor_t and green_scheduler_t classes. A
+ * green actor is a mailbox-driven state machine: instead of a thread and a
+ * pair of PAIR sockets, as actor_t, it has an in-memory lock-free mailbox and
+ * a handler called with each of its messages, run to completion, in the thread
+ * of the loop_t of its scheduler. A green actor costs a small heap allocation,
+ * so hundreds of thousands of them can live on a single loop.
+ *
+ * Messages can be sent to a green actor from any thread. The first message
+ * sent to an idle actor puts it in the ready queue of its scheduler, which is
+ * woken up through a file descriptor registered in the loop (only once for
+ * any number of messages sent before it runs). The scheduler then runs the
+ * ready actors in round robin, a batch of messages at a time each, and yields
+ * back to the loop after a maximum number of messages per wake-up, so neither
+ * a busy actor nor the actors as a whole starve the other loop handlers.
+ *
+ * Scaling to several cores is done by sharding: one loop_t, each with its own
+ * scheduler, per thread (for instance each run by an actor_t), the actors
+ * being assigned to the schedulers by a hash of their key.
+ *
+ * @details
+ * Key features:
+ * - Lock-free multi-producer mailbox, one allocation per message
+ * - Run-to-completion message handling in the loop thread
+ * - Round-robin batch scheduling, bounded work per loop wake-up
+ * - start()/stop()/is_started()/is_stopped() mirroring actor_t
+ *
+ * @note Green actors are not available on Windows.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+namespace detail {
+class wakeup_fd_t;
+class mpsc_queue_t;
+}  // namespace detail
+
+class green_actor_t;
+
+/**
+ * @brief Handler of the messages of a green actor
+ *
+ * Called in the loop thread with each message of the actor, one at a time.
+ * Returning false stops the actor, discarding its pending messages. An
+ * exception thrown by the handler also stops the actor, as an unhandled
+ * exception ends the thread of an actor_t.
+ *
+ * @param self The actor, to stop it or send messages to itself
+ * @param msg The message, which may be moved from
+ * @return true to keep the actor running, false to stop it
+ */
+using green_actor_fn_t = std::function<bool(green_actor_t&, zmq::message_t&)>;
+
+/**
+ * @brief Options of a green_scheduler_t
+ */
+struct green_scheduler_options_t {
+    std::size_t batch_size{64};                 ///< Messages handled per actor before moving to the next one
+    std::size_t max_messages_per_wakeup{4096};  ///< Messages handled before yielding to the other loop handlers
+};
+
+/**
+ * @brief Scheduler running green actors in the thread of a loop
+ *
+ * @note The scheduler must be destroyed after its actors and before the loop.
+ * @note This class is not thread-safe; only the messages sent to its actors may come from other threads.
+ */
+class CZZE_EXPORT green_scheduler_t {
+public:
+    /**
+     * @brief Construct a scheduler registered in a loop
+     *
+     * @param loop Loop whose thread runs the actors
+     * @param options Scheduler options
+     * @throws std::invalid_argument If batch_size or max_messages_per_wakeup is 0
+     * @throws std::system_error If the wake-up descriptor cannot be created
+     * @throws std::runtime_error On Windows
+     */
+    explicit green_scheduler_t(loop_t& loop, green_scheduler_options_t options = green_scheduler_options_t{});
+
+    green_scheduler_t(green_scheduler_t const&) = delete;
+    green_scheduler_t& operator=(green_scheduler_t const&) = delete;
+
+    /**
+     * @brief Remove the scheduler from the loop
+     */
+    ~green_scheduler_t() noexcept;
+
+    /**
+     * @brief Get the number of actors of the scheduler
+     */
+    std::size_t size() const noexcept { return _actors; }
+
+    /**
+     * @brief Get the number of messages handled since the scheduler was created
+     */
+    std::uint64_t handled_messages() const noexcept { return _handled_messages; }
+
+private:
+    friend class green_actor_t;
+    struct state_t;
+
+    void schedule(state_t* state) noexcept;
+    void release(state_t* state) noexcept;
+    bool run();
+    std::size_t run_turn(state_t* state, std::size_t budget);
+
+    loop_t& _loop;                                 ///< Loop running the actors
+    green_scheduler_options_t _options;            ///< Scheduler options
+    std::unique_ptr<detail::wakeup_fd_t> _wakeup;  ///< Readable while actors are ready
+    std::unique_ptr<detail::mpsc_queue_t> _ready;  ///< Actors made ready by a message, from any thread
+    std::deque<state_t*> _run_queue;               ///< Ready actors in round robin order, loop thread only
+    std::atomic<bool> _signaled{false};            ///< Whether the wake-up descriptor was signaled
+    std::size_t _actors{0};                        ///< Actors of the scheduler
+    std::uint64_t _handled_messages{0};            ///< Messages handled
+};
+
+/**
+ * @brief Lightweight actor handling its messages in the loop thread of a green_scheduler_t
+ *
+ * @note The actor must outlive the calls to send() made from other threads.
+ * @note Except send(), methods must be called in the loop thread.
+ */
+class CZZE_EXPORT green_actor_t {
+public:
+    /**
+     * @brief Construct an actor, not started yet, in a scheduler
+     */
+    explicit green_actor_t(green_scheduler_t& scheduler);
+
+    green_actor_t(green_actor_t const&) = delete;
+    green_actor_t& operator=(green_actor_t const&) = delete;
+
+    /**
+     * @brief Move constructor
+     *
+     * The source actor is left in a valid but empty state where is_started() and
+     * is_stopped() return true, as a moved-from actor_t.
+     */
+    green_actor_t(green_actor_t&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator, stopping the actor assigned to
+     */
+    green_actor_t& operator=(green_actor_t&& other) noexcept;
+
+    /**
+     * @brief Stop the actor, discarding its pending messages
+     */
+    ~green_actor_t() noexcept;
+
+    /**
+     * @brief Start handling messages
+     *
+     * @param fn Message handler
+     * @throws std::runtime_error If the actor was already started
+     */
+    void start(green_actor_fn_t fn);
+
+    /**
+     * @brief Stop the actor, discarding its pending messages
+     *
+     * Messages sent afterwards are refused. Stopping an actor not started or
+     * already stopped is a no-op.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Send a message to the actor, from any thread
+     *
+     * @param msg Message, moved from when accepted
+     * @return true if the message was queued, false if the actor is not started or stopped
+     */
+    bool send(zmq::message_t&& msg);
+
+    /**
+     * @brief Send a message copied from a buffer to the actor, from any thread
+     *
+     * @see send(zmq::message_t&&)
+     */
+    bool send(zmq::const_buffer const& data) { return send(zmq::message_t{data.data(), data.size()}); }
+
+    /**
+     * @brief Check if the actor was started
+     */
+    bool is_started() const noexcept;
+
+    /**
+     * @brief Check if the actor was stopped
+     */
+    bool is_stopped() const noexcept;
+
+private:
+    green_scheduler_t* _scheduler;       ///< Scheduler of the actor, nullptr once moved from
+    green_scheduler_t::state_t* _state;  ///< State shared with the scheduler, nullptr once moved from
+};
+
+}  // namespace zmqzext
@@ -70,7 +70,7 @@ namespace zmqzext {
  * @return The send result containing the number of bytes sent
  *
  * @throw zmq::error_t if an error occurs (other than EINTR)
- * @note Overloads are provided for socket parameter types zmq::socket_t and zmq::socket_ref
+ * @note Overloads are provided for socket parameter types zmq::socket_t, zmq::socket_ref and ring_pipe_t
  * @see send_retry_on_eintr(T&, zmq::message_t&, zmq::send_flags)
  * @see send_retry_on_eintr(T&, zmq::message_t&&, zmq::send_flags)
  */
@@ -131,7 +131,7 @@ CZZE_EXPORT zmq::send_result_t send_retry_on_eintr(T& socket, zmq::message_t&& m
  *         the actual buffer used
  *
  * @throw zmq::error_t if an error occurs (other than EINTR)
- * @note Overloads are provided for socket parameter types zmq::socket_t and zmq::socket_ref
+ * @note Overloads are provided for socket parameter types zmq::socket_t, zmq::socket_ref and ring_pipe_t
  * @see recv_retry_on_eintr(T&, zmq::message_t&, zmq::recv_flags)
  */
 template <typename T>
@@ -151,7 +151,7 @@ CZZE_EXPORT zmq::recv_buffer_result_t recv_retry_on_eintr(T& socket, zmq::mutabl
  * @return The receive result containing the number of bytes received
  *
  * @throw zmq::error_t if an error occurs (other than EINTR)
- * @note Overloads are provided for socket parameter types zmq::socket_t and zmq::socket_ref
+ * @note Overloads are provided for socket parameter types zmq::socket_t, zmq::socket_ref and ring_pipe_t
  * @see recv_retry_on_eintr(T&, zmq::mutable_buffer const&, zmq::recv_flags)
  */
 template <typename T>
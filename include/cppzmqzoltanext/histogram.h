@@ -0,0 +1,340 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file histogram.h
+ * @brief Fixed-memory HDR-style histogram with a wait-free record path
+ *
+ * This header provides the histogram_t class, a log-linear histogram in the
+ * style of HdrHistogram, meant for latency measurements such as handler
+ * durations, timer lateness or round trips through actor pipes.
+ *
+ * Values are unsigned 64-bit integers (durations are recorded in nanoseconds).
+ * Values below 256 are counted exactly; larger values are counted in buckets
+ * whose width is at most 1/128 of their lowest value, so any reported value is
+ * within 0.8% of the recorded ones, over the whole 64-bit range and with a
+ * fixed footprint of about 58 KiB.
+ *
+ * Recording is a pair of relaxed atomic increments, so any number of threads
+ * may record into the same histogram without locks. Queries are made on a
+ * histogram_snapshot_t, which can be merged with snapshots of other histograms
+ * (for instance one histogram per thread).
+ *
+ * loop_t can record its handler durations and timer lateness into histograms,
+ * see loop_t::set_handler_histogram() and loop_t::set_timer_lateness_histogram().
+ *
+ * Key features:
+ * - Header-only, fixed memory, no allocation on record
+ * - Wait-free, thread-safe record path
+ * - Mergeable snapshots with percentile, min, max and mean queries
+ * - Snapshot and reset without losing concurrent records
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace zmqzext {
+
+class histogram_t;
+
+/**
+ * @brief Point-in-time copy of the counts of one or more histograms
+ *
+ * @note This class is not thread-safe.
+ */
+class histogram_snapshot_t {
+public:
+    /**
+     * @brief Construct an empty snapshot
+     */
+    histogram_snapshot_t();
+
+    /**
+     * @brief Get the number of recorded values
+     */
+    std::uint64_t count() const noexcept { return _count; }
+
+    /**
+     * @brief Get the sum of the recorded values
+     */
+    std::uint64_t sum() const noexcept { return _sum; }
+
+    /**
+     * @brief Get the mean of the recorded values
+     *
+     * @return The exact mean, or 0 if no value was recorded
+     */
+    double mean() const noexcept { return _count == 0 ? 0.0 : static_cast<double>(_sum) / _count; }
+
+    /**
+     * @brief Get the lowest recorded value
+     *
+     * @return The lowest value equivalent to the smallest recorded one, or 0 if no value was recorded
+     */
+    std::uint64_t min() const noexcept;
+
+    /**
+     * @brief Get the highest recorded value
+     *
+     * @return The highest value equivalent to the largest recorded one, or 0 if no value was recorded
+     */
+    std::uint64_t max() const noexcept;
+
+    /**
+     * @brief Get the value below or at which the given percentage of the recorded values fall
+     *
+     * @param percentile Percentile in the range [0, 100]; values outside are clamped
+     * @return The highest value equivalent to the value at the percentile, or 0 if no value was recorded
+     */
+    std::uint64_t value_at_percentile(double percentile) const noexcept;
+
+    /**
+     * @brief Add the counts of another snapshot to this one
+     *
+     * @param other Snapshot to merge
+     */
+    void merge(histogram_snapshot_t const& other) noexcept;
+
+    /**
+     * @brief Get the count of the bucket with the given index
+     *
+     * @param index Bucket index, lower than histogram_t::bucket_count
+     */
+    std::uint64_t count_at_index(std::size_t index) const noexcept { return _counts[index]; }
+
+private:
+    friend class histogram_t;
+
+    std::vector<std::uint64_t> _counts;  ///< Count per bucket
+    std::uint64_t _count{0};             ///< Total count
+    std::uint64_t _sum{0};               ///< Sum of the recorded values
+};
+
+/**
+ * @brief Log-linear histogram of 64-bit values with a wait-free record path
+ *
+ * @note record(), snapshot() and snapshot_and_reset() are thread-safe. reset() is thread-safe but
+ *       values recorded concurrently may be counted in the bucket counts and
+ *       not in the sum, or the opposite.
+ */
+class histogram_t {
+public:
+    /// Number of bits of the sub-bucket index; values are kept with 2^-(sub_bucket_bits - 1) relative precision
+    static constexpr unsigned sub_bucket_bits = 8;
+    /// Number of sub-buckets covered by each power of two above the exact range
+    static constexpr std::size_t sub_bucket_half_count = std::size_t{1} << (sub_bucket_bits - 1);
+    /// Values below this one are counted exactly
+    static constexpr std::uint64_t exact_limit = std::uint64_t{1} << sub_bucket_bits;
+    /// Total number of buckets covering the whole 64-bit range
+    static constexpr std::size_t bucket_count = (66 - sub_bucket_bits) * sub_bucket_half_count;
+
+    histogram_t() noexcept = default;
+    histogram_t(histogram_t const&) = delete;
+    histogram_t& operator=(histogram_t const&) = delete;
+
+    /**
+     * @brief Record a value
+     *
+     * @param value The value to record
+     */
+    void record(std::uint64_t value) noexcept {
+        _counts[index_of(value)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record a duration in nanoseconds
+     *
+     * @param duration The duration to record; negative durations are recorded as 0
+     */
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration) noexcept {
+        auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(static_cast<std::uint64_t>(std::max<decltype(ns)>(ns, 0)));
+    }
+
+    /**
+     * @brief Copy the current counts
+     *
+     * @return The snapshot
+     * @throws std::bad_alloc If the snapshot cannot be allocated
+     */
+    histogram_snapshot_t snapshot() const {
+        histogram_snapshot_t result;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            result._counts[i] = _counts[i].load(std::memory_order_relaxed);
+            result._count += result._counts[i];
+        }
+        result._sum = _sum.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    /**
+     * @brief Copy the current counts and reset them
+     *
+     * Each count is atomically exchanged with zero, so every value is reported
+     * by exactly one snapshot even with concurrent records.
+     *
+     * @return The snapshot
+     * @throws std::bad_alloc If the snapshot cannot be allocated
+     */
+    histogram_snapshot_t snapshot_and_reset() {
+        histogram_snapshot_t result;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            result._counts[i] = _counts[i].exchange(0, std::memory_order_relaxed);
+            result._count += result._counts[i];
+        }
+        result._sum = _sum.exchange(0, std::memory_order_relaxed);
+        return result;
+    }
+
+    /**
+     * @brief Discard all recorded values
+     */
+    void reset() noexcept {
+        for (auto& count : _counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        _sum.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the index of the bucket counting a value
+     */
+    static std::size_t index_of(std::uint64_t value) noexcept {
+        if (value < exact_limit) {
+            return static_cast<std::size_t>(value);
+        }
+        auto const shift = most_significant_bit(value) - (sub_bucket_bits - 1);
+        return (static_cast<std::size_t>(shift) << (sub_bucket_bits - 1)) + static_cast<std::size_t>(value >> shift);
+    }
+
+    /**
+     * @brief Get the lowest value counted by a bucket
+     */
+    static std::uint64_t lowest_equivalent_value(std::size_t index) noexcept {
+        if (index < exact_limit) {
+            return index;
+        }
+        auto const shift = index / sub_bucket_half_count - 1;
+        return static_cast<std::uint64_t>(index - shift * sub_bucket_half_count) << shift;
+    }
+
+    /**
+     * @brief Get the highest value counted by a bucket
+     */
+    static std::uint64_t highest_equivalent_value(std::size_t index) noexcept {
+        if (index < exact_limit) {
+            return index;
+        }
+        auto const shift = index / sub_bucket_half_count - 1;
+        return lowest_equivalent_value(index) + ((std::uint64_t{1} << shift) - 1);
+    }
+
+private:
+    static unsigned most_significant_bit(std::uint64_t value) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned index = 0;
+        while (value >>= 1) {
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> _counts{};  ///< Count per bucket
+    std::atomic<std::uint64_t> _sum{0};                              ///< Sum of the recorded values
+};
+
+inline histogram_snapshot_t::histogram_snapshot_t() : _counts(histogram_t::bucket_count, 0) {}
+
+inline std::uint64_t histogram_snapshot_t::min() const noexcept {
+    for (std::size_t i = 0; i < _counts.size(); ++i) {
+        if (_counts[i] != 0) {
+            return histogram_t::lowest_equivalent_value(i);
+        }
+    }
+    return 0;
+}
+
+inline std::uint64_t histogram_snapshot_t::max() const noexcept {
+    for (std::size_t i = _counts.size(); i > 0; --i) {
+        if (_counts[i - 1] != 0) {
+            return histogram_t::highest_equivalent_value(i - 1);
+        }
+    }
+    return 0;
+}
+
+inline std::uint64_t histogram_snapshot_t::value_at_percentile(double percentile) const noexcept {
+    if (_count == 0) {
+        return 0;
+    }
+    auto const clamped = std::clamp(percentile, 0.0, 100.0);
+    auto const target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(_count))));
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < _counts.size(); ++i) {
+        cumulative += _counts[i];
+        if (cumulative >= target) {
+            return histogram_t::highest_equivalent_value(i);
+        }
+    }
+    return max();
+}
+
+inline void histogram_snapshot_t::merge(histogram_snapshot_t const& other) noexcept {
+    for (std::size_t i = 0; i < _counts.size(); ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,260 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file journal.h
+ * @brief Durable memory-mapped message journal
+ *
+ * This header provides the journal_t class, an append-only journal of message
+ * frames stored in fixed-size memory-mapped segment files. It is meant to back
+ * at-least-once queues (e.g. Titanic-style brokers) at close to memory speed:
+ * - Appending a frame is a copy into the mapped segment; no system call is
+ *   made until the next commit.
+ * - sync() flushes all frames appended since the previous commit with one
+ *   msync per dirty segment, so a group-commit timer on a loop_t
+ *   (add_commit_timer()) amortizes the cost of durability over many frames.
+ * - A consumer cursor reads the frames in order, without copying them out of
+ *   the mapping, and acknowledgements (cumulative, by sequence number) mark
+ *   the frames that no longer need to be kept.
+ * - Segments whose frames are all acknowledged are recycled for new frames
+ *   instead of being deleted and created again.
+ *
+ * Each frame gets a sequence number, starting at 1 and increasing by one per
+ * frame. The last acknowledged sequence is persisted on commit. When a journal
+ * is opened again after a crash or a restart, the frames appended and
+ * committed after the last persisted acknowledgement are read again, so a
+ * frame is delivered at least once. Each frame carries a CRC32 of its content
+ * so a frame partially written when the process died is discarded on recovery.
+ *
+ * Directory layout:
+ * - journal.meta: last persisted acknowledged sequence
+ * - <index>.seg: segment files, in append order
+ *
+ * @details
+ * Key features:
+ * - Memory-mapped, append-only, segmented storage
+ * - Group commit with one msync per dirty segment, driven by a loop_t timer
+ * - Consumer cursor with cumulative acknowledgements and crash recovery
+ * - Segment recycling
+ *
+ * @note Not available on Windows, where opening a journal throws std::runtime_error.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/// Sequence number of a journal frame; 0 means no frame
+using journal_sequence_t = std::uint64_t;
+
+/**
+ * @brief Frame read from a journal
+ *
+ * The data points into the journal mapping. It stays valid until the frame is
+ * acknowledged and the following commit recycles its segment, or until the
+ * journal is destroyed.
+ */
+struct journal_entry_t {
+    journal_sequence_t sequence{0};  ///< Sequence number of the frame
+    zmq::const_buffer data;          ///< Frame content
+    bool more{false};                ///< Whether more frames of the same message follow
+};
+
+/**
+ * @brief Options of a journal_t
+ */
+struct journal_options_t {
+    std::size_t segment_size{64 * 1024 * 1024};  ///< Size of each segment file, rounded up to whole pages
+    std::size_t max_spare_segments{2};           ///< Acknowledged segments kept for reuse; extra ones are deleted
+    bool durable{true};                          ///< Flush to disk on commit; when false, commits only recycle segments
+};
+
+/**
+ * @brief Callback called after a commit made frames durable
+ *
+ * @param durable_sequence Sequence of the last frame known to be on disk
+ */
+using fn_journal_commit_t = std::function<void(journal_sequence_t durable_sequence)>;
+
+/**
+ * @brief Append-only memory-mapped journal with a consumer cursor
+ *
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT journal_t {
+public:
+    /**
+     * @brief Open a journal, creating it if the directory has none
+     *
+     * Recovers the committed frames and positions the cursor on the first
+     * frame that was not acknowledged.
+     *
+     * @param directory Directory of the journal files, created if it does not exist
+     * @param options Journal options; the segment size of an existing journal must match
+     * @throws std::invalid_argument If the segment size is too small or differs from the existing journal one
+     * @throws std::system_error If the journal files cannot be created, opened or mapped
+     * @throws std::runtime_error If the journal files are not valid, or on Windows
+     */
+    explicit journal_t(std::string const& directory, journal_options_t const& options = journal_options_t{});
+
+    journal_t(journal_t const&) = delete;
+    journal_t& operator=(journal_t const&) = delete;
+
+    /**
+     * @brief Unmap and close the journal
+     *
+     * Frames appended after the last commit are left to the operating system,
+     * which usually writes them later, but they are not guaranteed to be durable.
+     */
+    ~journal_t() noexcept;
+
+    /**
+     * @brief Append a frame
+     *
+     * @param data Frame content
+     * @param more Whether more frames of the same message follow
+     * @return Sequence number of the frame
+     * @throws std::invalid_argument If the frame does not fit in a segment
+     * @throws std::system_error If a new segment cannot be created
+     */
+    journal_sequence_t append(zmq::const_buffer const& data, bool more = false);
+
+    /**
+     * @brief Append a message frame, keeping its more flag
+     *
+     * @param msg Message frame
+     * @return Sequence number of the frame
+     * @throws std::invalid_argument If the frame does not fit in a segment
+     * @throws std::system_error If a new segment cannot be created
+     */
+    journal_sequence_t append(zmq::message_t const& msg) { return append(zmq::buffer(msg.data(), msg.size()), msg.more()); }
+
+    /**
+     * @brief Read the frame at the cursor and advance the cursor
+     *
+     * @param entry Filled with the frame when available
+     * @return true if a frame was read, false if the cursor is at the end of the journal
+     */
+    bool read(journal_entry_t& entry);
+
+    /**
+     * @brief Move the cursor back to the first frame not acknowledged
+     */
+    void rewind();
+
+    /**
+     * @brief Acknowledge all frames up to a sequence
+     *
+     * The acknowledgement is persisted, and the fully acknowledged segments are
+     * recycled, on the next commit. The cursor is moved past the acknowledged
+     * frames if it was behind them.
+     *
+     * @param sequence Sequence of the last frame to acknowledge
+     * @throws std::invalid_argument If no frame with that sequence was appended
+     */
+    void ack(journal_sequence_t sequence);
+
+    /**
+     * @brief Commit: flush the appended frames and persist the acknowledgements
+     *
+     * Calls the commit handler if frames became durable. For journals that are
+     * not durable (e.g. used as spill storage), only recycles the acknowledged segments.
+     *
+     * @throws std::system_error If flushing to disk fails
+     */
+    void sync();
+
+    /**
+     * @brief Add a group-commit timer to a loop
+     *
+     * The timer calls sync() at each interval when there are appended frames
+     * or acknowledgements to commit.
+     *
+     * @param loop Loop running the timer; the journal must outlive the timer
+     * @param interval Commit interval
+     * @return Identifier of the timer, to remove it from the loop
+     */
+    timer_id_t add_commit_timer(loop_t& loop, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Set the handler called after each commit that made frames durable
+     *
+     * @param fn Commit handler, or an empty function to remove it
+     */
+    void set_commit_handler(fn_journal_commit_t fn);
+
+    /**
+     * @brief Check if there are frames or acknowledgements not committed yet
+     */
+    bool has_pending_commit() const noexcept;
+
+    /**
+     * @brief Get the sequence the next appended frame will get
+     */
+    journal_sequence_t next_sequence() const noexcept;
+
+    /**
+     * @brief Get the sequence of the last acknowledged frame, 0 if none
+     */
+    journal_sequence_t acked_sequence() const noexcept;
+
+    /**
+     * @brief Get the sequence of the last committed frame, 0 if none
+     */
+    journal_sequence_t durable_sequence() const noexcept;
+
+    /**
+     * @brief Get the number of segments holding frames not acknowledged yet, plus the segment being written
+     */
+    std::size_t segment_count() const noexcept;
+
+    /**
+     * @brief Get the number of acknowledged segments kept for reuse
+     */
+    std::size_t spare_segment_count() const noexcept;
+
+private:
+    struct impl_t;
+    std::unique_ptr<impl_t> _impl;  ///< Platform implementation
+};
+
+}  // namespace zmqzext
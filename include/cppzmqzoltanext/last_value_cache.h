@@ -0,0 +1,130 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file last_value_cache.h
+ * @brief Last value cache proxy serving snapshots to pub/sub late joiners
+ *
+ * This header provides the last_value_cache_t class, an XSUB/XPUB proxy
+ * running on a loop_t that keeps the last message of each topic it forwards.
+ * When a subscription arrives from a subscriber, the proxy forwards it to the
+ * publishers and immediately sends the cached messages of the topics starting
+ * with the subscribed prefix, so late joiners get a snapshot of the current
+ * values without waiting for the next updates or asking the publishers for a
+ * replay.
+ *
+ * The topic of a message is its first frame. The cache holds copies of the
+ * forwarded frames sharing their content with the frames sent (zmq_msg_copy),
+ * and the snapshots sent are copies of the cached frames, so large frames are
+ * never duplicated.
+ *
+ * @details
+ * Key features:
+ * - Transparent XSUB/XPUB forwarding of messages and subscriptions
+ * - Last message of each topic kept in a hash map, multipart messages included
+ * - Snapshot of the matching topics sent on each subscription
+ *
+ * @note XPUB sends to every subscriber of a topic, so the subscribers already
+ *       subscribed to a prefix also receive the snapshot of a new subscription
+ *       to it; a snapshot only repeats last values already delivered to them.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/**
+ * @brief XSUB/XPUB proxy caching the last message of each topic for new subscribers
+ *
+ * @note The cache must be destroyed before the loop.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT last_value_cache_t {
+public:
+    /**
+     * @brief Construct a proxy with unbound and unconnected sockets, registered in the loop
+     *
+     * @param context ZMQ context of the sockets
+     * @param loop Loop running the socket handlers
+     */
+    last_value_cache_t(zmq::context_t& context, loop_t& loop);
+
+    last_value_cache_t(last_value_cache_t const&) = delete;
+    last_value_cache_t& operator=(last_value_cache_t const&) = delete;
+
+    /**
+     * @brief Remove the sockets from the loop
+     */
+    ~last_value_cache_t() noexcept;
+
+    /**
+     * @brief Get the XSUB socket, to connect or bind to the publishers
+     */
+    zmq::socket_t& frontend() noexcept { return _frontend; }
+
+    /**
+     * @brief Get the XPUB socket, to bind or connect for the subscribers
+     */
+    zmq::socket_t& backend() noexcept { return _backend; }
+
+    /**
+     * @brief Get the number of topics cached
+     */
+    std::size_t size() const noexcept { return _cache.size(); }
+
+    /**
+     * @brief Discard all the cached messages
+     */
+    void clear() noexcept { _cache.clear(); }
+
+private:
+    bool on_message(zmq::socket_ref socket);
+    bool on_subscription(zmq::socket_ref socket);
+    void send_snapshot(char const* prefix, std::size_t size);
+
+    loop_t& _loop;                                                        ///< Loop running the handlers
+    zmq::socket_t _frontend;                                              ///< XSUB socket of the publishers
+    zmq::socket_t _backend;                                               ///< XPUB socket of the subscribers
+    std::unordered_map<std::string, std::vector<zmq::message_t>> _cache;  ///< Last message of each topic
+    std::vector<zmq::message_t> _frames;                                  ///< Frames of the message being forwarded
+    std::string _key;                                                     ///< Lookup key buffer, reused across messages
+};
+
+}  // namespace zmqzext
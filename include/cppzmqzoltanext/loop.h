@@ -43,11 +43,18 @@ SOFTWARE.
  * @details
  * Key features:
  * - Socket registration with I/O callbacks
+ * - Raw file descriptor registration with I/O callbacks
  * - One-shot and recurring timer support
  * - Event loop with interruptible operation
  * - Configurable interrupt checking intervals
  * - Automatic timer management and expiration
  * - Integration with interrupt signal handling
+ * - Optional handler duration and timer lateness histograms
+ * - Optional event counters published through a metrics registry
+ * - Optional per-socket token bucket rate limits, pausing sockets without polling them
+ * - Optional bounded drain of pending work when interrupted
+ * - Optional accounting of wake-ups and of the CPU time and context switches of the running thread
+ * - Registries and poll set allocated from a caller provided memory resource
  *
  * @authors
  * Luan Young (luanpy@gmail.com)
@@ -65,14 +72,21 @@ SOFTWARE.
 #include <functional>
 #include <list>
 #include <map>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
 #include <zmq.hpp>
 
 #include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/histogram.h"
+#include "cppzmqzoltanext/thread_usage.h"
 #include "poller.h"
 
 namespace zmqzext {
 
 class loop_t;
+class counter_t;
+class metrics_registry_t;
 
 /// Unique identifier for timer instances
 using timer_id_t = std::size_t;
@@ -90,6 +104,19 @@ using timer_id_t = std::size_t;
  */
 using fn_socket_handler_t = std::function<bool(loop_t&, zmq::socket_ref)>;
 
+/**
+ * @brief File descriptor event handler callback type
+ *
+ * Function signature for raw file descriptor event handlers. The handler is
+ * called when a registered descriptor becomes ready for reading. Returning
+ * false finishes the loop; returning true continues processing.
+ *
+ * @param loop Reference to the event loop
+ * @param fd The file descriptor that is ready for reading
+ * @return false to finish the loop, true to continue
+ */
+using fn_fd_handler_t = std::function<bool(loop_t&, zmq::fd_t)>;
+
 /**
  * @brief Timer event handler callback type
  *
@@ -103,6 +130,39 @@ using fn_socket_handler_t = std::function<bool(loop_t&, zmq::socket_ref)>;
  */
 using fn_timer_handler_t = std::function<bool(loop_t&, timer_id_t)>;
 
+/**
+ * @brief Token bucket limits of the rate at which a loop consumes from a socket
+ *
+ * Each limit is a bucket refilled continuously at its rate, up to its burst
+ * capacity. A rate of 0 disables the corresponding bucket.
+ *
+ * @see loop_t::add(zmq::socket_ref, fn_socket_handler_t, rate_limit_t const&)
+ */
+struct rate_limit_t {
+    double messages_per_second{0};  ///< Messages consumed per second, 0 for no message limit
+    double bytes_per_second{0};     ///< Bytes consumed per second, 0 for no byte limit
+    double message_burst{0};        ///< Capacity of the message bucket, 0 for one second of messages
+    double byte_burst{0};           ///< Capacity of the byte bucket, 0 for one second of bytes
+};
+
+/**
+ * @brief Wake-ups and thread resource usage of a loop, at some point in time
+ *
+ * @see loop_t::set_accounting()
+ */
+struct loop_usage_t {
+    std::uint64_t wakeups{0};        ///< Returns from polling
+    std::uint64_t empty_wakeups{0};  ///< Returns from polling with no handler to call, such as interrupt checks
+    thread_usage_t thread;           ///< Usage of the thread while running the loop
+
+    /**
+     * @brief Get the usage between an earlier snapshot and this one
+     */
+    loop_usage_t operator-(loop_usage_t const& earlier) const noexcept {
+        return loop_usage_t{wakeups - earlier.wakeups, empty_wakeups - earlier.empty_wakeups, thread - earlier.thread};
+    }
+};
+
 /**
  * @brief Event loop for managing socket and timer events
  *
@@ -146,9 +206,96 @@ private:
         time_point_t next_occurence;        ///< Next scheduled expiration time
         fn_timer_handler_t handler;         ///< Callback function for timer events
         bool removed;                       ///< Flag indicating timer is marked for removal
+        bool rearmed;                       ///< Flag indicating timer was re-armed by its running handler
+    };
+
+    /**
+     * @brief Timer registry, a list of timers indexed by their IDs
+     *
+     * The list keeps the timers in registration order and the index finds a
+     * timer in constant time. Copying rebuilds the index to refer to the copy,
+     * and so does moving to a list with another memory resource, which moves
+     * the timers one by one.
+     */
+    class timer_list_t {
+    public:
+        using iterator = std::pmr::list<timer_t>::iterator;
+        using const_iterator = std::pmr::list<timer_t>::const_iterator;
+
+        explicit timer_list_t(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _timers(resource), _index(resource) {}
+        timer_list_t(timer_list_t const& other);
+        timer_list_t(timer_list_t&& other) = default;
+        timer_list_t& operator=(timer_list_t const& other);
+        timer_list_t& operator=(timer_list_t&& other);
+        ~timer_list_t() = default;
+
+        iterator begin() noexcept { return _timers.begin(); }
+        iterator end() noexcept { return _timers.end(); }
+        const_iterator begin() const noexcept { return _timers.begin(); }
+        const_iterator end() const noexcept { return _timers.end(); }
+        std::size_t size() const noexcept { return _timers.size(); }
+
+        void push_back(timer_t timer);
+        iterator erase(iterator timer_it);
+        void remove_flagged();
+
+        /**
+         * @brief Find a timer, including one marked for removal
+         *
+         * @return Iterator to the timer, end() if it is not registered
+         */
+        iterator find(timer_id_t timer_id);
+        bool contains(timer_id_t timer_id) const { return _index.count(timer_id) != 0; }
+
+    private:
+        void rebuild_index();
+
+        std::pmr::list<timer_t> _timers;                       ///< Timers in registration order
+        std::pmr::unordered_map<timer_id_t, iterator> _index;  ///< Timer of each ID
+    };
+
+    /**
+     * @brief Token buckets of a rate limited socket
+     */
+    struct rate_bucket_t {
+        rate_limit_t limit;        ///< Rates and burst capacities
+        double messages;           ///< Message tokens left
+        double bytes;              ///< Byte tokens left
+        time_point_t last_refill;  ///< Time the buckets were last refilled
+        bool charged;              ///< Whether the running handler reported what it consumed
+        bool paused;               ///< Whether the socket is removed from the poller
     };
 
 public:
+    /**
+     * @brief Construct an empty loop
+     *
+     * The handler registries, the timer list, the rate limit buckets and the
+     * poll set are allocated from the given memory resource, so a monotonic or
+     * pool resource can serve the whole loop thread without touching the
+     * global heap once the registrations are done.
+     *
+     * @param resource Memory resource of the loop, which must outlive it
+     * @note Handlers are std::function objects, which allocate from the global
+     *       heap the callables too large for their small buffer; keep captures
+     *       small (a pointer or a reference) to avoid it.
+     * @note As with the standard pmr containers, a copy of the loop uses the
+     *       default memory resource, while a moved loop keeps its resource.
+     */
+    explicit loop_t(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : _poller(resource),
+          _socket_handlers(resource),
+          _writable_handlers(resource),
+          _fd_handlers(resource),
+          _timer_handlers(resource),
+          _rate_buckets(resource) {}
+
+    /**
+     * @brief Get the memory resource the loop allocates from
+     */
+    std::pmr::memory_resource* resource() const noexcept { return _poller.resource(); }
+
     /**
      * @brief Register a socket with an I/O handler
      *
@@ -159,10 +306,80 @@ public:
      * @param socket The ZMQ socket to register
      * @param fn Callback function to invoke when socket is ready
      * @throws std::invalid_argument if the socket is invalid or already added
+     * @throws std::runtime_error if the loop is draining (see set_drain_on_interrupt())
      * @see remove()
      */
     void add(zmq::socket_ref socket, fn_socket_handler_t fn);
 
+    /**
+     * @brief Register a socket with an I/O handler and limits of the rate it is consumed at
+     *
+     * Each call of the handler is charged to the token buckets of the socket:
+     * the messages and bytes reported with charge() during the call, or one
+     * message if none was reported. Handlers receiving several messages per
+     * call, or limited in bytes, should report what they consume. Buckets may
+     * go into debt when a call consumes more than the tokens left.
+     *
+     * When a bucket has less than one token left after a call, the socket is
+     * removed from the poller until the bucket is refilled, so a paused socket
+     * costs nothing to the loop. One internal timer, armed for the earliest
+     * refill, puts the paused sockets back.
+     *
+     * @param socket The ZMQ socket to register
+     * @param fn Callback function to invoke when socket is ready
+     * @param limit Rate limits; with both rates 0, the socket is not limited
+     * @throws std::invalid_argument if the socket is invalid or already added, or a rate or burst is negative
+     * @see charge()
+     */
+    void add(zmq::socket_ref socket, fn_socket_handler_t fn, rate_limit_t const& limit);
+
+    /**
+     * @brief Report what a handler consumed from a rate limited socket
+     *
+     * @param socket The socket whose handler is running
+     * @param messages Messages received
+     * @param bytes Bytes received
+     * @note Charging a socket that is not rate limited is a no-op
+     */
+    void charge(zmq::socket_ref socket, std::size_t messages, std::size_t bytes);
+
+    /**
+     * @brief Check if a rate limited socket is paused, waiting for its buckets to refill
+     */
+    bool paused(zmq::socket_ref socket) const;
+
+    /**
+     * @brief Register a raw file descriptor with an I/O handler
+     *
+     * Adds a file descriptor to the event loop with an associated callback function.
+     * The callback is invoked whenever the descriptor becomes ready for reading.
+     * Ready descriptors are dispatched after the ready sockets of the same iteration.
+     *
+     * @param fd The file descriptor to register
+     * @param fn Callback function to invoke when the descriptor is ready
+     * @throws std::invalid_argument if the descriptor is already added
+     * @throws std::runtime_error if the loop is draining (see set_drain_on_interrupt())
+     * @see remove_fd()
+     */
+    void add_fd(zmq::fd_t fd, fn_fd_handler_t fn);
+
+    /**
+     * @brief Register a socket with a handler called when it is ready to send
+     *
+     * The callback is invoked whenever the socket can send a message without
+     * blocking, for instance to resume sending after the socket reached its
+     * high water mark. A socket ready to send usually stays ready, so the socket
+     * should only be registered while there is something to send.
+     * Ready sockets are dispatched after the sockets ready for receiving of the
+     * same iteration. A socket may be registered both with add() and add_writable().
+     *
+     * @param socket The ZMQ socket to register
+     * @param fn Callback function to invoke when the socket is ready to send
+     * @throws std::invalid_argument if the socket is invalid or already added for sending
+     * @see remove_writable()
+     */
+    void add_writable(zmq::socket_ref socket, fn_socket_handler_t fn);
+
     /**
      * @brief Register a timer with an expiration handler
      *
@@ -193,6 +410,26 @@ public:
      */
     void remove(zmq::socket_ref socket);
 
+    /**
+     * @brief Unregister a raw file descriptor from the event loop
+     *
+     * @param fd The file descriptor to remove
+     * @note Removing a descriptor that was not registered is a no-op
+     * @note It is safe to remove a descriptor within its own handler callback or from another callback
+     * @see add_fd()
+     */
+    void remove_fd(zmq::fd_t fd);
+
+    /**
+     * @brief Unregister a socket registered with add_writable()
+     *
+     * @param socket The ZMQ socket to remove
+     * @note Removing a socket that was not registered is a no-op
+     * @note It is safe to remove a socket within its own handler callback or from another callback
+     * @see add_writable()
+     */
+    void remove_writable(zmq::socket_ref socket);
+
     /**
      * @brief Unregister a timer from the event loop
      *
@@ -206,6 +443,32 @@ public:
      */
     void remove_timer(timer_id_t timer_id);
 
+    /**
+     * @brief Re-arm a timer to expire one full interval from now
+     *
+     * Postpones the next expiration of a registered timer in place, keeping its
+     * ID, handler and remaining occurrences, without allocating. This is the
+     * cheap way to implement idle timeouts and heartbeats pushed back on every
+     * received message, instead of remove_timer() followed by add_timer().
+     *
+     * @param timer_id The unique identifier of the timer to re-arm
+     * @return true if the timer was re-armed, false if it is not registered or was removed
+     * @note It is safe to re-arm a timer within its own handler callback or from another callback
+     * @note Re-arming a timer within the handler of its last occurrence does not make it fire again
+     * @see reschedule_timer()
+     */
+    bool reset_timer(timer_id_t timer_id);
+
+    /**
+     * @brief Change the interval of a timer and re-arm it to expire one new interval from now
+     *
+     * @param timer_id The unique identifier of the timer to re-arm
+     * @param timeout New duration between timer expirations in milliseconds
+     * @return true if the timer was re-armed, false if it is not registered or was removed
+     * @see reset_timer()
+     */
+    bool reschedule_timer(timer_id_t timer_id, std::chrono::milliseconds timeout);
+
     /**
      * @brief Run the event loop
      *
@@ -238,7 +501,100 @@ public:
      * @return true if the loop is in a terminated state, false otherwise
      * @see run()
      */
-    bool terminated() const noexcept { return _poller.terminated(); }
+    bool terminated() const noexcept { return _poller.terminated() || _drained; }
+
+    /**
+     * @brief Drain pending work instead of returning at once when interrupted
+     *
+     * When enabled and run() is interrupted by a signal, the loop enters drain
+     * mode instead of returning: it stops accepting new sockets and keeps
+     * dispatching, without waiting, the sockets ready for receiving or sending,
+     * the ready descriptors and the expired timers. It returns, as terminated,
+     * as soon as nothing is ready or when the deadline passes, whichever comes
+     * first. Pending input and outbound queues (e.g. an overflow_queue_t) are
+     * then flushed without making the shutdown time unbounded.
+     *
+     * @param deadline Maximum duration of the drain, 0 (default) to return at once when interrupted
+     * @note Timers that expire after the drain started are dispatched only while other work keeps it going.
+     * @note Sockets paused by their rate limit are not dispatched while draining.
+     * @see draining()
+     */
+    void set_drain_on_interrupt(std::chrono::milliseconds deadline) noexcept { _drain_deadline = deadline; }
+
+    /**
+     * @brief Check if the loop is draining after an interrupt
+     *
+     * Handlers can check it to stop producing new work.
+     */
+    bool draining() const noexcept { return _draining; }
+
+    /**
+     * @brief Record the duration of every handler call into a histogram
+     *
+     * When set, the duration of each timer, socket and file descriptor handler
+     * call is recorded in nanoseconds. Calls that throw are not recorded.
+     *
+     * @param histogram Histogram to record into, or nullptr to stop recording.
+     *                  Must outlive the loop or be unset before being destroyed.
+     */
+    void set_handler_histogram(histogram_t* histogram) noexcept { _handler_histogram = histogram; }
+
+    /**
+     * @brief Record the lateness of every timer expiration into a histogram
+     *
+     * When set, the delay between the scheduled expiration of a timer and the
+     * call to its handler is recorded in nanoseconds.
+     *
+     * @param histogram Histogram to record into, or nullptr to stop recording.
+     *                  Must outlive the loop or be unset before being destroyed.
+     */
+    void set_timer_lateness_histogram(histogram_t* histogram) noexcept { _timer_lateness_histogram = histogram; }
+
+    /**
+     * @brief Register the loop counters and histograms in a metrics registry
+     *
+     * Creates (or reuses) the following metrics and records into them:
+     * - <prefix>.iterations: wake-ups of the loop
+     * - <prefix>.timer_events, <prefix>.socket_events, <prefix>.fd_events: handler calls
+     *   (socket events include the calls of handlers registered with add_writable())
+     * - <prefix>.handler_ns: handler durations (see set_handler_histogram())
+     * - <prefix>.timer_lateness_ns: timer lateness (see set_timer_lateness_histogram())
+     *
+     * @param registry Registry owning the metrics; must outlive the loop
+     * @param prefix Prefix of the metric names
+     * @throws std::invalid_argument If a metric name is already used with another type
+     */
+    void set_metrics(metrics_registry_t& registry, std::string const& prefix);
+
+    /**
+     * @brief Account the wake-ups of the loop and the resource usage of its thread
+     *
+     * When enabled, run() counts its wake-ups and the ones with no handler to
+     * call, and samples the CPU time and context switches of the calling thread
+     * when it starts and returns (see current_thread_usage()). A high share of
+     * empty wake-ups points to a too short interrupt check interval or timer;
+     * a high CPU time to busy handlers.
+     *
+     * @param enabled Whether to account, disabled by default
+     * @note Thread usage is accounted from the next call to run() on.
+     * @see usage()
+     */
+    void set_accounting(bool enabled) noexcept { _accounting = enabled; }
+
+    /**
+     * @brief Get the accounted usage of the loop
+     *
+     * Called from a handler, the thread usage includes the current run up to now.
+     *
+     * @return Usage accumulated over the runs since accounting was enabled or reset
+     * @see set_accounting()
+     */
+    loop_usage_t usage() const noexcept;
+
+    /**
+     * @brief Reset the accounted usage to zero
+     */
+    void reset_usage() noexcept;
 
 private:
     /**
@@ -276,13 +632,81 @@ private:
      */
     timer_id_t generate_unique_timer_id();
 
+    /**
+     * @brief Charge a handler call to the buckets of a rate limited socket, pausing it if they are empty
+     */
+    void charge_handler_call(zmq::socket_ref socket);
+
+    /**
+     * @brief Refill the buckets of a rate limited socket
+     *
+     * @return Time until every enabled bucket holds at least one token, 0 if they already do
+     */
+    static time_milliseconds_t refill(rate_bucket_t& bucket, time_point_t const& current_time);
+
+    /**
+     * @brief Arm the rate limit timer to expire after a delay, unless it expires earlier
+     */
+    void arm_rate_timer(time_milliseconds_t delay);
+
+    /**
+     * @brief Put back the paused sockets whose buckets are refilled, re-arming the timer for the others
+     */
+    bool resume_rate_limited();
+
+    /**
+     * @brief Check whether a timer has expired, for the drain mode to go on
+     */
+    bool has_expired_timer(time_point_t const& current_time) const;
+
+    /**
+     * @brief Add the thread usage of the current run to the accounted usage
+     */
+    void finish_accounted_run() noexcept;
+
+    /**
+     * @brief Call a handler, recording its duration when a handler histogram is set
+     *
+     * @param handler Callable returning the handler result
+     * @return The handler result
+     */
+    template <typename Handler>
+    bool call_handler(Handler&& handler) {
+        if (_handler_histogram == nullptr) {
+            return handler();
+        }
+        auto const start_time = now();
+        auto const result = handler();
+        _handler_histogram->record(now() - start_time);
+        return result;
+    }
+
 private:
-    poller_t _poller;                                                 ///< Socket polling mechanism
-    std::map<zmq::socket_ref, fn_socket_handler_t> _socket_handlers;  ///< Socket handler registry
-    std::list<timer_t> _timer_handlers;                               ///< Timer registry
-    timer_id_t _last_timer_id{0};                                     ///< Last allocated timer ID
-    bool _timer_id_has_overflowed{false};                             ///< Flag indicating timer ID wraparound
-    time_milliseconds_t _interruptCheckInterval{-1};                  ///< Interval for interrupt checking
+    poller_t _poller;                                                        ///< Socket polling mechanism
+    std::pmr::map<zmq::socket_ref, fn_socket_handler_t> _socket_handlers;    ///< Socket handler registry
+    std::pmr::map<zmq::socket_ref, fn_socket_handler_t> _writable_handlers;  ///< Socket ready to send handler registry
+    std::pmr::map<zmq::fd_t, fn_fd_handler_t> _fd_handlers;                  ///< File descriptor handler registry
+    timer_list_t _timer_handlers;                                            ///< Timer registry
+    timer_id_t _last_timer_id{0};                                            ///< Last allocated timer ID
+    bool _timer_id_has_overflowed{false};                                    ///< Flag indicating timer ID wraparound
+    time_milliseconds_t _interruptCheckInterval{-1};                         ///< Interval for interrupt checking
+    histogram_t* _handler_histogram{nullptr};                                ///< Handler durations, if recorded
+    histogram_t* _timer_lateness_histogram{nullptr};                         ///< Timer lateness, if recorded
+    counter_t* _iterations_counter{nullptr};                                 ///< Loop wake-ups, if counted
+    counter_t* _timer_events_counter{nullptr};                               ///< Timer handler calls, if counted
+    counter_t* _socket_events_counter{nullptr};                              ///< Socket handler calls, if counted
+    counter_t* _fd_events_counter{nullptr};                                  ///< Descriptor handler calls, if counted
+    std::pmr::map<zmq::socket_ref, rate_bucket_t> _rate_buckets;             ///< Buckets of the rate limited sockets
+    timer_id_t _rate_timer_id{0};                                            ///< Timer resuming paused sockets
+    bool _rate_timer_armed{false};                                           ///< Whether the rate limit timer is armed
+    time_point_t _rate_timer_expiry{};                                       ///< Expiration of the rate limit timer
+    time_milliseconds_t _drain_deadline{0};                                  ///< Maximum drain duration, 0 for no drain
+    bool _draining{false};                                                   ///< Whether the loop is draining
+    bool _drained{false};                                                    ///< Whether the last run drained
+    bool _accounting{false};                                                 ///< Whether usage is accounted
+    bool _accounted_run{false};                                              ///< Whether the current run is accounted
+    thread_usage_t _run_start_usage{};                                       ///< Thread usage at the run start
+    loop_usage_t _usage{};                                                   ///< Usage accounted up to the run start
 };
 
 }  // namespace zmqzext
@@ -0,0 +1,682 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file loop_scheduler.h
+ * @brief Senders/receivers adapter for loop_t, in the style of std::execution
+ *
+ * This header provides the loop_scheduler_t class, a scheduler whose senders
+ * complete in the thread running a loop_t, and the then() and when_all()
+ * algorithms to compose them. It follows the sender/receiver model of P2300
+ * (std::execution) with a small C++17 protocol instead of the full concepts:
+ *
+ * - A receiver has set_value(values...) and set_error(std::exception_ptr) member functions.
+ * - A sender completes with a single value, or none, declared by its value_type
+ *   member type (void for none), and has a connect(receiver) member function
+ *   returning an operation state.
+ * - An operation state can neither be copied nor moved and has a start() member
+ *   function. Nothing happens until start() is called.
+ *
+ * The loop senders register a one-shot timer or a socket handler in the loop
+ * when started and unregister it when they complete, so a chain of senders
+ * runs on ZeroMQ events without extra threads nor queue hops. The schedule()
+ * sender is the exception: it can be started from any thread, to move work
+ * onto the loop thread, and is posted to a lock-free queue whose wake-up
+ * descriptor is registered in the loop. As with a green_scheduler_t, that
+ * descriptor stays registered while the scheduler exists, so the loop does not
+ * return for lack of registrations: a handler returning false stops it.
+ *
+ * @code
+ * loop_scheduler_t scheduler{loop};
+ * auto sender = when_all(scheduler.receive(socket1), scheduler.receive(socket2));
+ * auto op = then(sender, [](auto&& msgs) { return merge(std::get<0>(msgs), std::get<1>(msgs)); })
+ *               .connect(receiver);
+ * op.start();
+ * loop.run();  // Until a handler returns false or the loop is interrupted
+ * @endcode
+ *
+ * @details
+ * Key features:
+ * - schedule() sender moving work onto the loop thread from any thread
+ * - schedule_after() sender completing in the loop thread after a delay
+ * - readable() and receive() senders completing on socket events
+ * - then() and when_all() algorithms
+ * - No allocation besides the loop registrations and the schedule() posts
+ *
+ * @note There is no cancellation: an operation completes with a value or an
+ * error, and destroying a started operation before its completion unregisters
+ * it from the loop without completing it.
+ *
+ * @note On Windows, where wake-up descriptors are not available, schedule()
+ * must be started in the loop thread, as the other senders.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+namespace detail {
+
+/// Type of a completion value stored by when_all(), std::monostate for senders completing without value
+template <typename Value>
+struct stored_value {
+    using type = Value;
+};
+
+template <>
+struct stored_value<void> {
+    using type = std::monostate;
+};
+
+/// Type of the value of a then() sender
+template <typename Value, typename Fn>
+struct then_value {
+    using type = std::invoke_result_t<Fn&, Value>;
+};
+
+template <typename Fn>
+struct then_value<void, Fn> {
+    using type = std::invoke_result_t<Fn&>;
+};
+
+/// Type of the operation state of a sender connected to a receiver
+template <typename Sender, typename Receiver>
+using connect_result_t = decltype(std::declval<Sender const&>().connect(std::declval<Receiver>()));
+
+class wakeup_fd_t;
+class mpsc_queue_t;
+
+/**
+ * @brief Operations posted from any thread and completed in the thread of a loop
+ *
+ * @note push() may be called from any thread, the other methods from the loop thread only.
+ */
+class CZZE_EXPORT loop_post_queue_t {
+public:
+    /// Function completing a posted operation in the loop thread
+    using callback_t = void (*)(void* operation);
+
+    /// Post of an operation, owned by the queue once pushed
+    struct post_t;
+
+    /**
+     * @brief Register the wake-up descriptor of the queue in a loop
+     *
+     * @throws std::system_error If the descriptor cannot be created
+     * @throws std::runtime_error On platforms without wake-up descriptors
+     */
+    explicit loop_post_queue_t(loop_t& loop);
+
+    loop_post_queue_t(loop_post_queue_t const&) = delete;
+    loop_post_queue_t& operator=(loop_post_queue_t const&) = delete;
+
+    /**
+     * @brief Unregister the descriptor, discarding the posts not completed
+     */
+    ~loop_post_queue_t() noexcept;
+
+    /**
+     * @brief Allocate the post of an operation, to be pushed with push()
+     */
+    static post_t* make_post(callback_t callback, void* operation);
+
+    /**
+     * @brief Queue a post and wake up the loop
+     */
+    void push(post_t* post) noexcept;
+
+    /**
+     * @brief Prevent the callback of a pushed post from being called
+     */
+    static void cancel(post_t* post) noexcept;
+
+private:
+    bool run();
+
+    loop_t& _loop;                         ///< Loop completing the posts
+    std::unique_ptr<wakeup_fd_t> _wakeup;  ///< Readable while posts are queued
+    std::unique_ptr<mpsc_queue_t> _posts;  ///< Posts pushed from any thread
+    std::atomic<bool> _signaled{false};    ///< Whether the wake-up descriptor was signaled
+};
+
+}  // namespace detail
+
+/**
+ * @brief Sender completing without value in the loop thread, startable from any thread
+ */
+class schedule_sender_t {
+public:
+    using value_type = void;
+
+    template <typename Receiver>
+    class operation_t {
+    public:
+        operation_t(detail::loop_post_queue_t& queue, Receiver receiver)
+            : _queue(queue), _receiver(std::move(receiver)) {}
+
+        operation_t(operation_t const&) = delete;
+        operation_t& operator=(operation_t const&) = delete;
+
+        ~operation_t() noexcept {
+            if (_post != nullptr) {
+                detail::loop_post_queue_t::cancel(_post);
+            }
+        }
+
+        void start() noexcept {
+            try {
+                _post = detail::loop_post_queue_t::make_post(&operation_t::complete, this);
+            } catch (...) {
+                _receiver.set_error(std::current_exception());
+                return;
+            }
+            // The operation may complete, and be destroyed, as soon as it is pushed
+            _queue.push(_post);
+        }
+
+    private:
+        static void complete(void* operation) {
+            auto* const self = static_cast<operation_t*>(operation);
+            self->_post = nullptr;
+            self->_receiver.set_value();
+        }
+
+        detail::loop_post_queue_t& _queue;           ///< Queue completing the operation in the loop thread
+        Receiver _receiver;                          ///< Receiver of the completion
+        detail::loop_post_queue_t::post_t* _post{};  ///< Post of the operation, until it completes
+    };
+
+    explicit schedule_sender_t(detail::loop_post_queue_t& queue) noexcept : _queue(&queue) {}
+
+    template <typename Receiver>
+    operation_t<Receiver> connect(Receiver receiver) const {
+        return operation_t<Receiver>{*_queue, std::move(receiver)};
+    }
+
+private:
+    detail::loop_post_queue_t* _queue;  ///< Queue completing the operation in the loop thread
+};
+
+/**
+ * @brief Sender completing without value in the loop thread after a delay
+ */
+class timer_sender_t {
+public:
+    using value_type = void;
+
+    template <typename Receiver>
+    class operation_t {
+    public:
+        operation_t(loop_t& loop, std::chrono::milliseconds delay, Receiver receiver)
+            : _loop(loop), _delay(delay), _receiver(std::move(receiver)) {}
+
+        operation_t(operation_t const&) = delete;
+        operation_t& operator=(operation_t const&) = delete;
+
+        ~operation_t() noexcept {
+            if (_armed) {
+                _loop.remove_timer(_timer);
+            }
+        }
+
+        void start() noexcept {
+            try {
+                _timer = _loop.add_timer(_delay, 1, [op = this](loop_t&, timer_id_t) {
+                    op->_armed = false;
+                    op->_receiver.set_value();
+                    return true;
+                });
+                _armed = true;
+            } catch (...) {
+                _receiver.set_error(std::current_exception());
+            }
+        }
+
+    private:
+        loop_t& _loop;                     ///< Loop running the timer
+        std::chrono::milliseconds _delay;  ///< Delay before completion
+        Receiver _receiver;                ///< Receiver of the completion
+        timer_id_t _timer{0};              ///< Timer, while armed
+        bool _armed{false};                ///< Whether the timer is armed
+    };
+
+    timer_sender_t(loop_t& loop, std::chrono::milliseconds delay) noexcept : _loop(&loop), _delay(delay) {}
+
+    template <typename Receiver>
+    operation_t<Receiver> connect(Receiver receiver) const {
+        return operation_t<Receiver>{*_loop, _delay, std::move(receiver)};
+    }
+
+private:
+    loop_t* _loop;                     ///< Loop running the timer
+    std::chrono::milliseconds _delay;  ///< Delay before completion
+};
+
+/**
+ * @brief Sender completing in the loop thread when a socket is ready to receive
+ *
+ * Completes with the socket when Receive is false, with its next message
+ * (a single frame) when Receive is true.
+ */
+template <bool Receive>
+class socket_sender_t {
+public:
+    using value_type = std::conditional_t<Receive, zmq::message_t, zmq::socket_ref>;
+
+    template <typename Receiver>
+    class operation_t {
+    public:
+        operation_t(loop_t& loop, zmq::socket_ref socket, Receiver receiver)
+            : _loop(loop), _socket(socket), _receiver(std::move(receiver)) {}
+
+        operation_t(operation_t const&) = delete;
+        operation_t& operator=(operation_t const&) = delete;
+
+        ~operation_t() noexcept {
+            if (_registered) {
+                _loop.remove(_socket);
+            }
+        }
+
+        void start() noexcept {
+            try {
+                _loop.add(_socket, [op = this](loop_t& loop, zmq::socket_ref socket) {
+                    // The handler is destroyed by remove(), so nothing captured is used afterwards
+                    auto* const self = op;
+                    if constexpr (Receive) {
+                        zmq::message_t msg;
+                        try {
+                            if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+                                return true;
+                            }
+                        } catch (...) {
+                            loop.remove(socket);
+                            self->_registered = false;
+                            self->_receiver.set_error(std::current_exception());
+                            return true;
+                        }
+                        loop.remove(socket);
+                        self->_registered = false;
+                        self->_receiver.set_value(std::move(msg));
+                    } else {
+                        loop.remove(socket);
+                        self->_registered = false;
+                        self->_receiver.set_value(socket);
+                    }
+                    return true;
+                });
+                _registered = true;
+            } catch (...) {
+                _receiver.set_error(std::current_exception());
+            }
+        }
+
+    private:
+        loop_t& _loop;            ///< Loop polling the socket
+        zmq::socket_ref _socket;  ///< Socket waited for
+        Receiver _receiver;       ///< Receiver of the completion
+        bool _registered{false};  ///< Whether the socket is registered in the loop
+    };
+
+    socket_sender_t(loop_t& loop, zmq::socket_ref socket) noexcept : _loop(&loop), _socket(socket) {}
+
+    template <typename Receiver>
+    operation_t<Receiver> connect(Receiver receiver) const {
+        return operation_t<Receiver>{*_loop, _socket, std::move(receiver)};
+    }
+
+private:
+    loop_t* _loop;            ///< Loop polling the socket
+    zmq::socket_ref _socket;  ///< Socket waited for
+};
+
+/**
+ * @brief Scheduler whose senders complete in the thread running a loop_t
+ *
+ * The socket senders register the socket in the loop while they wait, so a
+ * socket can be waited for by one operation at a time and must not be
+ * registered in the loop otherwise.
+ *
+ * Copies of the scheduler share its queue of schedule() operations, so a copy
+ * can be handed to another thread to move work onto the loop thread.
+ *
+ * @note The operations of schedule() can be started in any thread, the other
+ * operations only in the loop thread. A started operation not completed yet
+ * must be destroyed in the loop thread. All operations must be destroyed
+ * before the scheduler and its copies, the last of which must be destroyed in
+ * the loop thread, before the loop.
+ */
+class loop_scheduler_t {
+public:
+#if !defined(WIN32)
+    /**
+     * @brief Construct a scheduler of a loop, registering its wake-up descriptor in the loop
+     *
+     * @throws std::system_error If the wake-up descriptor cannot be created
+     */
+    explicit loop_scheduler_t(loop_t& loop) : _loop(&loop), _posts(std::make_shared<detail::loop_post_queue_t>(loop)) {}
+
+    /**
+     * @brief Get a sender completing without value in the loop thread, startable from any thread
+     */
+    schedule_sender_t schedule() const noexcept { return schedule_sender_t{*_posts}; }
+#else
+    /**
+     * @brief Construct a scheduler of a loop
+     */
+    explicit loop_scheduler_t(loop_t& loop) noexcept : _loop(&loop) {}
+
+    /**
+     * @brief Get a sender completing without value on the next loop iteration, startable in the loop thread only
+     */
+    timer_sender_t schedule() const noexcept { return timer_sender_t{*_loop, std::chrono::milliseconds{0}}; }
+#endif
+
+    /**
+     * @brief Get a sender completing without value when a delay has passed
+     *
+     * @throws std::invalid_argument If the delay is negative
+     */
+    timer_sender_t schedule_after(std::chrono::milliseconds delay) const {
+        if (delay.count() < 0) {
+            throw std::invalid_argument("Cannot schedule after a negative delay");
+        }
+        return timer_sender_t{*_loop, delay};
+    }
+
+    /**
+     * @brief Get a sender completing with the socket when it is ready to receive
+     *
+     * @throws std::invalid_argument If the socket is invalid
+     */
+    socket_sender_t<false> readable(zmq::socket_ref socket) const {
+        check_socket(socket);
+        return socket_sender_t<false>{*_loop, socket};
+    }
+
+    /**
+     * @brief Get a sender completing with the next message received from a socket
+     *
+     * Multipart messages are received one frame per operation.
+     *
+     * @throws std::invalid_argument If the socket is invalid
+     */
+    socket_sender_t<true> receive(zmq::socket_ref socket) const {
+        check_socket(socket);
+        return socket_sender_t<true>{*_loop, socket};
+    }
+
+    /**
+     * @brief Get the loop of the scheduler
+     */
+    loop_t& loop() const noexcept { return *_loop; }
+
+    bool operator==(loop_scheduler_t const& other) const noexcept { return _loop == other._loop; }
+    bool operator!=(loop_scheduler_t const& other) const noexcept { return _loop != other._loop; }
+
+private:
+    static void check_socket(zmq::socket_ref socket) {
+        if (!socket) {
+            throw std::invalid_argument("Cannot wait for a null socket");
+        }
+    }
+
+    loop_t* _loop;  ///< Loop running the operations
+#if !defined(WIN32)
+    std::shared_ptr<detail::loop_post_queue_t> _posts;  ///< Queue of the schedule() operations, shared by the copies
+#endif
+};
+
+/**
+ * @brief Sender transforming the value of another sender with a function
+ */
+template <typename Sender, typename Fn>
+class then_sender_t {
+public:
+    using value_type = typename detail::then_value<typename Sender::value_type, Fn>::type;
+
+    template <typename Receiver>
+    class operation_t {
+    public:
+        operation_t(Sender const& sender, Fn const& fn, Receiver receiver)
+            : _fn(fn), _receiver(std::move(receiver)), _operation(sender.connect(receiver_t{this})) {}
+
+        operation_t(operation_t const&) = delete;
+        operation_t& operator=(operation_t const&) = delete;
+
+        void start() noexcept { _operation.start(); }
+
+    private:
+        struct receiver_t {
+            operation_t* op;  ///< Operation the completion is forwarded to
+
+            template <typename... Values>
+            void set_value(Values&&... values) {
+                op->complete(std::forward<Values>(values)...);
+            }
+
+            void set_error(std::exception_ptr error) noexcept { op->_receiver.set_error(error); }
+        };
+
+        template <typename... Values>
+        void complete(Values&&... values) {
+            // The function is called out of the receiver so that an exception of the receiver is not reported twice
+            if constexpr (std::is_void_v<value_type>) {
+                try {
+                    std::invoke(_fn, std::forward<Values>(values)...);
+                } catch (...) {
+                    _receiver.set_error(std::current_exception());
+                    return;
+                }
+                _receiver.set_value();
+            } else {
+                std::optional<value_type> result;
+                try {
+                    result.emplace(std::invoke(_fn, std::forward<Values>(values)...));
+                } catch (...) {
+                    _receiver.set_error(std::current_exception());
+                    return;
+                }
+                _receiver.set_value(std::move(*result));
+            }
+        }
+
+        Fn _fn;                                                   ///< Function applied to the value
+        Receiver _receiver;                                       ///< Receiver of the result
+        detail::connect_result_t<Sender, receiver_t> _operation;  ///< Operation of the transformed sender
+    };
+
+    then_sender_t(Sender sender, Fn fn) : _sender(std::move(sender)), _fn(std::move(fn)) {}
+
+    template <typename Receiver>
+    operation_t<Receiver> connect(Receiver receiver) const {
+        return operation_t<Receiver>{_sender, _fn, std::move(receiver)};
+    }
+
+private:
+    Sender _sender;  ///< Sender whose value is transformed
+    Fn _fn;          ///< Function applied to the value
+};
+
+/**
+ * @brief Get a sender completing with the result of a function called with the value of another sender
+ *
+ * An exception thrown by the function completes the sender with an error.
+ * Errors of the other sender are forwarded without calling the function.
+ */
+template <typename Sender, typename Fn>
+then_sender_t<Sender, std::decay_t<Fn>> then(Sender sender, Fn&& fn) {
+    return then_sender_t<Sender, std::decay_t<Fn>>{std::move(sender), std::forward<Fn>(fn)};
+}
+
+namespace detail {
+
+/**
+ * @brief Operation of one of the senders of a when_all(), a base of the when_all() operation
+ */
+template <typename Parent, std::size_t Index, typename Sender>
+struct when_all_child_t {
+    struct receiver_t {
+        Parent* parent;  ///< when_all() operation the completion is forwarded to
+
+        template <typename... Values>
+        void set_value(Values&&... values) {
+            parent->template set_child_value<Index>(std::forward<Values>(values)...);
+        }
+
+        void set_error(std::exception_ptr error) noexcept { parent->set_child_error(error); }
+    };
+
+    when_all_child_t(Parent* parent, Sender const& sender) : operation(sender.connect(receiver_t{parent})) {}
+
+    connect_result_t<Sender, receiver_t> operation;  ///< Operation of the sender
+};
+
+template <typename Receiver, typename Indices, typename... Senders>
+class when_all_operation_t;
+
+template <typename Receiver, std::size_t... Indices, typename... Senders>
+class when_all_operation_t<Receiver, std::index_sequence<Indices...>, Senders...>
+    : private when_all_child_t<when_all_operation_t<Receiver, std::index_sequence<Indices...>, Senders...>, Indices,
+                               Senders>... {
+public:
+    using value_type = std::tuple<typename stored_value<typename Senders::value_type>::type...>;
+
+    when_all_operation_t(Receiver receiver, Senders const&... senders)
+        : when_all_child_t<when_all_operation_t, Indices, Senders>(this, senders)...,
+          _receiver(std::move(receiver)) {}
+
+    when_all_operation_t(when_all_operation_t const&) = delete;
+    when_all_operation_t& operator=(when_all_operation_t const&) = delete;
+
+    void start() noexcept {
+        (static_cast<when_all_child_t<when_all_operation_t, Indices, Senders>&>(*this).operation.start(), ...);
+    }
+
+private:
+    template <typename, std::size_t, typename>
+    friend struct when_all_child_t;
+
+    using optional_values_t = std::tuple<std::optional<typename stored_value<typename Senders::value_type>::type>...>;
+
+    template <std::size_t Index, typename... Values>
+    void set_child_value(Values&&... values) {
+        if (!_error) {
+            try {
+                std::get<Index>(_values).emplace(std::forward<Values>(values)...);
+            } catch (...) {
+                _error = std::current_exception();
+            }
+        }
+        child_completed();
+    }
+
+    void set_child_error(std::exception_ptr error) noexcept {
+        if (!_error) {
+            _error = error;
+        }
+        child_completed();
+    }
+
+    void child_completed() {
+        if (--_pending != 0) {
+            return;
+        }
+        if (_error) {
+            _receiver.set_error(_error);
+            return;
+        }
+        _receiver.set_value(value_type{std::move(*std::get<Indices>(_values))...});
+    }
+
+    Receiver _receiver;                        ///< Receiver of the values
+    optional_values_t _values;                 ///< Values of the senders completed so far
+    std::exception_ptr _error;                 ///< First error of the senders
+    std::size_t _pending{sizeof...(Senders)};  ///< Senders not completed yet
+};
+
+}  // namespace detail
+
+/**
+ * @brief Sender completing when all of its senders have completed
+ */
+template <typename... Senders>
+class when_all_sender_t {
+public:
+    template <typename Receiver>
+    using operation_t = detail::when_all_operation_t<Receiver, std::index_sequence_for<Senders...>, Senders...>;
+
+    using value_type = std::tuple<typename detail::stored_value<typename Senders::value_type>::type...>;
+
+    explicit when_all_sender_t(Senders... senders) : _senders(std::move(senders)...) {}
+
+    template <typename Receiver>
+    operation_t<Receiver> connect(Receiver receiver) const {
+        return std::apply(
+            [&receiver](Senders const&... senders) { return operation_t<Receiver>{std::move(receiver), senders...}; },
+            _senders);
+    }
+
+private:
+    std::tuple<Senders...> _senders;  ///< Senders waited for
+};
+
+/**
+ * @brief Get a sender completing with the tuple of the values of several senders once they have all completed
+ *
+ * Senders completing without value contribute a std::monostate to the tuple.
+ * If any sender completes with an error, the first error is reported, still
+ * once all the senders have completed.
+ */
+template <typename... Senders>
+when_all_sender_t<Senders...> when_all(Senders... senders) {
+    static_assert(sizeof...(Senders) > 0, "when_all() needs at least one sender");
+    return when_all_sender_t<Senders...>{std::move(senders)...};
+}
+
+}  // namespace zmqzext
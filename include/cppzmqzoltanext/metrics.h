@@ -0,0 +1,235 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file metrics.h
+ * @brief Metrics registry and publisher actor
+ *
+ * This header provides a small metrics facility made of three parts:
+ * - counter_t: a monotonic counter incremented with a relaxed atomic add
+ * - metrics_registry_t: a thread-safe registry of named counters and histograms
+ * - metrics_publisher_t: an actor that periodically snapshots a registry and
+ *   publishes the metrics on a PUB socket and/or appends them to a file
+ *
+ * Counters and histograms are owned by the registry and keep their address for
+ * the registry lifetime, so hot threads record into them through references
+ * obtained once, without locks or system calls. Only the creation of metrics
+ * and the periodic collection take the registry mutex.
+ *
+ * loop_t can register its own counters and histograms with loop_t::set_metrics().
+ *
+ * Metrics are formatted in the InfluxDB line protocol, one line per metric:
+ * @code
+ * loop.socket_events value=1234i 1767225600000000000
+ * loop.handler_ns count=1234i,min=250i,p50=900i,p90=1500i,p99=4000i,p999=9000i,max=12000i,mean=1020.5 1767225600000000000
+ * @endcode
+ *
+ * Key features:
+ * - Lock-free recording on the data path
+ * - Periodic collection in a dedicated actor thread
+ * - PUB socket and file outputs with a compact line format
+ * - Interval histograms (reset on each collection) or cumulative ones
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/actor.h"
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/histogram.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Monotonic counter safe to increment from any thread
+ */
+class counter_t {
+public:
+    counter_t() noexcept = default;
+    counter_t(counter_t const&) = delete;
+    counter_t& operator=(counter_t const&) = delete;
+
+    /**
+     * @brief Increment the counter
+     *
+     * @param n Amount to add
+     */
+    void add(std::uint64_t n = 1) noexcept { _value.fetch_add(n, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the current value
+     */
+    std::uint64_t value() const noexcept { return _value.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> _value{0};  ///< Own cache line to avoid false sharing
+};
+
+/**
+ * @brief Values of all metrics of a registry at one point in time
+ */
+struct metrics_snapshot_t {
+    std::chrono::system_clock::time_point time;                               ///< Collection time
+    std::vector<std::pair<std::string, std::uint64_t>> counters;              ///< Counter values by name
+    std::vector<std::pair<std::string, histogram_snapshot_t>> histograms;    ///< Histogram snapshots by name
+};
+
+/**
+ * @brief Write a metrics snapshot in the InfluxDB line protocol
+ *
+ * Spaces, commas and backslashes in metric names are escaped with a backslash.
+ *
+ * @param os Output stream
+ * @param snapshot Snapshot to write
+ */
+CZZE_EXPORT void write_metrics_lines(std::ostream& os, metrics_snapshot_t const& snapshot);
+
+/**
+ * @brief Thread-safe registry of named counters and histograms
+ *
+ * @note Metrics are never removed; references returned by counter() and
+ *       histogram() stay valid for the registry lifetime.
+ */
+class CZZE_EXPORT metrics_registry_t {
+public:
+    metrics_registry_t() = default;
+    metrics_registry_t(metrics_registry_t const&) = delete;
+    metrics_registry_t& operator=(metrics_registry_t const&) = delete;
+
+    /**
+     * @brief Get the counter with the given name, creating it if needed
+     *
+     * @param name Metric name
+     * @return Reference to the counter
+     * @throws std::invalid_argument If the name is empty or used by a histogram
+     */
+    counter_t& counter(std::string const& name);
+
+    /**
+     * @brief Get the histogram with the given name, creating it if needed
+     *
+     * @param name Metric name
+     * @return Reference to the histogram
+     * @throws std::invalid_argument If the name is empty or used by a counter
+     */
+    histogram_t& histogram(std::string const& name);
+
+    /**
+     * @brief Collect the current value of all metrics
+     *
+     * @param reset_histograms Whether to reset the histograms, so each snapshot
+     *                         covers only the values recorded since the previous one
+     * @return The snapshot, with metrics sorted by name
+     */
+    metrics_snapshot_t snapshot(bool reset_histograms);
+
+private:
+    std::mutex _mutex;                                                 ///< Protects the maps, not the metrics
+    std::map<std::string, std::unique_ptr<counter_t>> _counters;      ///< Counters by name
+    std::map<std::string, std::unique_ptr<histogram_t>> _histograms;  ///< Histograms by name
+};
+
+/**
+ * @brief Options of a metrics_publisher_t
+ *
+ * At least one of endpoint and file_path must be set.
+ */
+struct metrics_publisher_options_t {
+    std::chrono::milliseconds interval{1000};  ///< Collection interval
+    std::string endpoint;                      ///< Endpoint the PUB socket binds to, if not empty
+    std::string topic{"metrics"};              ///< First frame of each published message
+    std::string file_path;                     ///< File the metrics are appended to, if not empty
+    bool reset_histograms{true};               ///< Publish interval histograms instead of cumulative ones
+};
+
+/**
+ * @brief Actor that periodically collects a metrics registry and publishes it
+ *
+ * Each collection is published as a two-frame message (topic and lines) on a
+ * PUB socket bound to the configured endpoint, and/or appended to the
+ * configured file. The collection runs in the actor thread, so the threads
+ * recording the metrics are never blocked.
+ *
+ * @note The registry must outlive the publisher.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT metrics_publisher_t {
+public:
+    /**
+     * @brief Construct a publisher for a registry
+     *
+     * @param context ZMQ context used by the actor and the PUB socket
+     * @param registry Registry to collect
+     * @param options Publisher options
+     * @throws std::invalid_argument If the interval is not positive or no output is set
+     */
+    metrics_publisher_t(zmq::context_t& context, metrics_registry_t& registry, metrics_publisher_options_t options);
+
+    metrics_publisher_t(metrics_publisher_t const&) = delete;
+    metrics_publisher_t& operator=(metrics_publisher_t const&) = delete;
+
+    /**
+     * @brief Start the actor
+     *
+     * @throws zmq::error_t If the PUB socket cannot bind to the endpoint
+     * @throws std::runtime_error If the file cannot be opened or the actor was already started
+     */
+    void start();
+
+    /**
+     * @brief Stop the actor
+     *
+     * @param timeout Maximum time to wait for the actor, negative to wait indefinitely
+     * @return true if the actor stopped, false on timeout
+     */
+    bool stop(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+private:
+    bool run(zmq::socket_t& pipe);
+
+    zmq::context_t& _context;              ///< Context of the PUB socket
+    metrics_registry_t& _registry;         ///< Collected registry
+    metrics_publisher_options_t _options;  ///< Publisher options
+    actor_t _actor;                        ///< Collection thread
+};
+
+}  // namespace zmqzext
@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file overflow_queue.h
+ * @brief Outbound queue that absorbs bursts beyond the high water mark of a socket
+ *
+ * This header provides the overflow_queue_t class, which sits in front of a
+ * socket registered in a loop_t. Messages are sent directly while the socket
+ * accepts them. When the socket reaches its high water mark, instead of
+ * blocking the loop or dropping the messages, the queue buffers them:
+ * - in memory, up to a configurable number of bytes;
+ * - beyond that, in memory-mapped spill files written sequentially (see journal_t),
+ *   so bursts many times larger than the memory budget are absorbed without loss.
+ *
+ * The queue registers the socket with loop_t::add_writable() while it holds
+ * messages and replays them in order, in batches, whenever the socket is ready
+ * to send again. Multipart messages are kept whole and in order.
+ *
+ * @details
+ * Key features:
+ * - Direct sends while the socket is not full, no copy
+ * - Memory buffer with a byte budget
+ * - Sequential spill to memory-mapped files, recycled as they are replayed
+ * - In-order replay driven by socket readiness, without stalling the loop
+ *
+ * @note Spilling is not available on Windows.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/journal.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Options of an overflow_queue_t
+ */
+struct overflow_queue_options_t {
+    std::size_t memory_limit{16 * 1024 * 1024};        ///< Bytes of frames buffered in memory before spilling
+    std::string spill_directory;                       ///< Directory of the spill files; empty to disable spilling
+    std::size_t spill_segment_size{64 * 1024 * 1024};  ///< Size of each spill file
+    std::size_t replay_batch{1024};                    ///< Maximum frames replayed each time the socket is ready
+};
+
+/**
+ * @brief Outbound queue buffering the messages a socket cannot take yet, in memory then on disk
+ *
+ * When spilling is disabled and the memory limit is reached, new messages are
+ * dropped; frames following an accepted frame of the same message are always
+ * accepted, so messages are never truncated.
+ *
+ * @note All the messages sent on the socket must go through the queue to keep their order.
+ * @note The queue must be destroyed before the loop and the socket.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT overflow_queue_t {
+public:
+    /**
+     * @brief Construct a queue in front of a socket
+     *
+     * @param loop Loop replaying the queued messages when the socket is ready to send
+     * @param socket Socket the messages are sent on
+     * @param options Queue options
+     * @throws std::invalid_argument If the socket is invalid or the replay batch is 0
+     * @throws std::runtime_error If spilling is requested on Windows
+     */
+    overflow_queue_t(loop_t& loop, zmq::socket_ref socket,
+                     overflow_queue_options_t options = overflow_queue_options_t{});
+
+    overflow_queue_t(overflow_queue_t const&) = delete;
+    overflow_queue_t& operator=(overflow_queue_t const&) = delete;
+
+    /**
+     * @brief Unregister the socket from the loop and delete the spill files
+     *
+     * Messages still queued are discarded.
+     */
+    ~overflow_queue_t() noexcept;
+
+    /**
+     * @brief Send a frame, queuing it if the socket cannot take it now
+     *
+     * @param msg Frame to send, moved from when accepted
+     * @param flags zmq::send_flags::sndmore if more frames of the same message follow;
+     *              zmq::send_flags::dontwait is implied
+     * @return true if the frame was sent or queued, false if it was dropped
+     * @throws zmq::error_t If sending fails for a reason other than the socket being full
+     * @throws std::system_error If the spill files cannot be created
+     * @throws std::invalid_argument If a frame to spill is larger than a spill file
+     */
+    bool send(zmq::message_t&& msg, zmq::send_flags flags = zmq::send_flags::none);
+
+    /**
+     * @brief Send a frame copied from a buffer, queuing it if the socket cannot take it now
+     *
+     * @see send(zmq::message_t&&, zmq::send_flags)
+     */
+    bool send(zmq::const_buffer const& data, zmq::send_flags flags = zmq::send_flags::none) {
+        return send(zmq::message_t{data.data(), data.size()}, flags);
+    }
+
+    /**
+     * @brief Check if no frame is queued
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Get the number of frames queued in memory
+     */
+    std::size_t memory_frames() const noexcept { return _memory.size(); }
+
+    /**
+     * @brief Get the number of bytes of the frames queued in memory
+     */
+    std::size_t memory_bytes() const noexcept { return _memory_bytes; }
+
+    /**
+     * @brief Get the number of frames queued in the spill files
+     */
+    std::uint64_t spilled_frames() const noexcept;
+
+    /**
+     * @brief Get the number of frames dropped because the memory limit was reached with spilling disabled
+     */
+    std::uint64_t dropped_frames() const noexcept { return _dropped_frames; }
+
+private:
+    /**
+     * @brief Frame queued in memory
+     */
+    struct frame_t {
+        zmq::message_t msg;  ///< Frame content
+        bool more;           ///< Whether more frames of the same message follow
+    };
+
+    bool spill_pending() const noexcept;
+    void spill(zmq::message_t const& msg, bool more);
+    bool replay();
+
+    loop_t& _loop;                      ///< Loop replaying the queued frames
+    zmq::socket_ref _socket;            ///< Destination socket
+    overflow_queue_options_t _options;  ///< Queue options
+    std::deque<frame_t> _memory;        ///< Frames queued in memory, older than the spilled ones
+    std::size_t _memory_bytes{0};       ///< Bytes of the frames queued in memory
+    std::string _spill_path;            ///< Directory of this queue spill files, once created
+    std::unique_ptr<journal_t> _spill;  ///< Spill files, once created
+    journal_entry_t _spill_entry;       ///< Spilled frame read and not sent yet
+    bool _has_spill_entry{false};       ///< Whether _spill_entry holds a frame
+    bool _in_message{false};            ///< Whether the last accepted frame had more frames following
+    bool _dropping{false};              ///< Whether the frames of the current message are dropped
+    bool _writable_registered{false};   ///< Whether the socket is registered in the loop
+    std::uint64_t _dropped_frames{0};   ///< Frames dropped
+};
+
+}  // namespace zmqzext
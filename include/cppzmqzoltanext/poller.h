@@ -37,10 +37,13 @@ SOFTWARE.
  * @details
  * Key features:
  * - Dynamic socket registration and deregistration
+ * - Raw file descriptor registration (e.g. eventfd) alongside sockets
+ * - Monitoring of sockets for readiness to send
  * - Wait for single or multiple ready sockets
  * - Configurable timeout values
  * - Interruptible polling for signal handling
  * - Termination detection
+ * - Poll set and ready lists allocated from a caller provided memory resource
  *
  * @authors
  * Luan Young (luanpy@gmail.com)
@@ -54,6 +57,7 @@ SOFTWARE.
 #pragma once
 
 #include <chrono>
+#include <memory_resource>
 #include <vector>
 #include <zmq.hpp>
 
@@ -69,6 +73,14 @@ namespace zmqzext {
  * and wait for data availability on any or all of them.
  *
  * The poller supports adding and removing sockets to be monitored at any time.
+ * Raw file descriptors (for example the notification descriptor of a ring_pipe_t)
+ * can be monitored together with the sockets. Since the wait operations return
+ * socket references, the descriptors found ready are reported by ready_fds().
+ *
+ * Sockets can also be monitored for readiness to send (for example to resume
+ * sending after reaching the high water mark) with add_writable(), independently
+ * of their monitoring for receiving. The sockets found ready to send are reported
+ * by writable_sockets().
  *
  * When used in conjunction with the interrupt handling module and the application receives a SIINT
  * or SIGTERM signal, the poller will return early from wait operations, allowing the application
@@ -81,6 +93,9 @@ namespace zmqzext {
  * events before receiving a stop request from the main application. So the main application
  * can perform a graceful shutdown without the actors loosing any messages that are already in their queues.
  *
+ * Other signals caught during a wait (for example the trace dump signal, see tracer.h)
+ * also make the wait return early, but never terminate the poller.
+ *
  * @note This class is not thread-safe.
  * @note On Windows, the waiting calls to ZMQ functions do not return early on signals,
  * no matter if the signal handlers are installed or not. Still, the interrupt flag
@@ -90,6 +105,14 @@ namespace zmqzext {
  */
 class CZZE_EXPORT poller_t {
 public:
+    /**
+     * @brief Construct an empty poller
+     *
+     * @param resource Memory resource of the poll set and of the ready lists, which must outlive the poller
+     */
+    explicit poller_t(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : _poll_items(resource), _ready_sockets(resource), _ready_fds(resource), _writable_sockets(resource) {}
+
     /**
      * @brief Add a socket to the polling set
      *
@@ -114,6 +137,50 @@ public:
      */
     void remove(zmq::socket_ref socket);
 
+    /**
+     * @brief Add a raw file descriptor to the polling set
+     *
+     * Registers a file descriptor with the poller for monitoring. The descriptor will be
+     * polled in subsequent wait operations to detect readiness for reading.
+     *
+     * @param fd The file descriptor to add
+     * @throws std::invalid_argument if the descriptor is already added
+     * @see remove_fd()
+     * @see ready_fds()
+     */
+    void add_fd(zmq::fd_t fd);
+
+    /**
+     * @brief Remove a raw file descriptor from the polling set
+     *
+     * @param fd The file descriptor to remove
+     * @note Removing a descriptor that was not added is a no-op
+     * @see add_fd()
+     */
+    void remove_fd(zmq::fd_t fd);
+
+    /**
+     * @brief Monitor a socket for readiness to send
+     *
+     * The socket is polled in subsequent wait operations to detect when it can
+     * send a message without blocking. It may also be monitored for receiving.
+     *
+     * @param socket The ZMQ socket reference to monitor
+     * @throws std::invalid_argument if the socket is invalid or already monitored for sending
+     * @see remove_writable()
+     * @see writable_sockets()
+     */
+    void add_writable(zmq::socket_ref socket);
+
+    /**
+     * @brief Stop monitoring a socket for readiness to send
+     *
+     * @param socket The ZMQ socket reference
+     * @note Removing a socket that is not monitored for sending is a no-op
+     * @see add_writable()
+     */
+    void remove_writable(zmq::socket_ref socket);
+
     /**
      * @brief Set whether polling should be interruptible
      *
@@ -152,7 +219,7 @@ public:
     /**
      * @brief Get the number of sockets in the polling set
      *
-     * @return The count of registered sockets
+     * @return The count of registered sockets and file descriptors
      */
     std::size_t size() const noexcept { return _poll_items.size(); }
 
@@ -215,19 +282,104 @@ public:
      */
     std::vector<zmq::socket_ref> wait_all(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    /**
+     * @brief Wait for all sockets ready to receive, without allocating a result
+     *
+     * Same as wait_all(), but the ready sockets are kept in the poller and read
+     * with ready_sockets(). The list reuses its capacity from one wait to the
+     * next, so a poller waiting in a loop stops allocating once it has seen
+     * its largest set of ready sockets.
+     *
+     * @param timeout Maximum time to wait in milliseconds (-1 for infinite)
+     * @return The number of sockets ready to receive
+     * @note When interrupted, it returns early, no matter the interruptible setting
+     * @see ready_sockets()
+     */
+    std::size_t wait_ready(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /**
+     * @brief Get the sockets found ready to receive in the last wait_ready() or wait_all() call
+     *
+     * The list keeps the order in which the sockets were added to the poller.
+     *
+     * @return A vector with the sockets ready to receive
+     * @see wait_ready()
+     */
+    std::pmr::vector<zmq::socket_ref> const& ready_sockets() const noexcept { return _ready_sockets; }
+
+    /**
+     * @brief Get the memory resource of the poller
+     */
+    std::pmr::memory_resource* resource() const noexcept { return _poll_items.get_allocator().resource(); }
+
+    /**
+     * @brief Get the file descriptors found ready for reading in the last wait operation
+     *
+     * The list is reset on each wait operation and keeps the order in which the
+     * descriptors were added to the poller.
+     *
+     * @return A vector with the ready file descriptors
+     * @see add_fd()
+     */
+    std::pmr::vector<zmq::fd_t> const& ready_fds() const noexcept { return _ready_fds; }
+
+    /**
+     * @brief Get the sockets found ready to send in the last wait operation
+     *
+     * The list is reset on each wait operation and keeps the order in which the
+     * sockets were added to the poller.
+     *
+     * @return A vector with the sockets ready to send
+     * @see add_writable()
+     */
+    std::pmr::vector<zmq::socket_ref> const& writable_sockets() const noexcept { return _writable_sockets; }
+
 private:
     /**
-     * @brief Check if a socket is already registered in the poll set
+     * @brief Find the poll item of a socket
      *
      * @param socket_handle The raw socket handle to search for
-     * @return true if the socket is registered, false otherwise
+     * @return Iterator to the poll item, or end() if the socket is not registered
+     */
+    std::pmr::vector<zmq::pollitem_t>::iterator find_socket(void* socket_handle);
+
+    /**
+     * @brief Add events to the poll item of a socket, creating it if needed
+     *
+     * @param socket The ZMQ socket reference
+     * @param events Events to add
+     * @param error Message of the exception thrown if the events are already monitored
+     */
+    void add_socket_events(zmq::socket_ref socket, short events, char const* error);
+
+    /**
+     * @brief Remove events from the poll item of a socket, removing it when no event is left
+     *
+     * @param socket The ZMQ socket reference
+     * @param events Events to remove
+     */
+    void remove_socket_events(zmq::socket_ref socket, short events);
+
+    /**
+     * @brief Check if a file descriptor is already registered in the poll set
+     *
+     * @param fd The file descriptor to search for
+     * @return true if the descriptor is registered, false otherwise
+     */
+    bool has_fd(zmq::fd_t fd) const;
+
+    /**
+     * @brief Collect the file descriptors and the writable sockets reported ready by the last poll call
      */
-    bool has_socket(void* socket_handle) const;
+    void collect_ready_fds();
 
 private:
-    std::vector<zmq::pollitem_t> _poll_items;  ///< Vector of poll items for ZMQ polling
-    bool _interruptible{true};                 ///< Whether interrupt signals are considered as termination
-    bool _terminated{false};                   ///< Termination state flag
+    std::pmr::vector<zmq::pollitem_t> _poll_items;        ///< Vector of poll items for ZMQ polling
+    std::pmr::vector<zmq::socket_ref> _ready_sockets;     ///< Sockets ready to receive in the last wait operation
+    std::pmr::vector<zmq::fd_t> _ready_fds;               ///< File descriptors ready in the last wait operation
+    std::pmr::vector<zmq::socket_ref> _writable_sockets;  ///< Sockets ready to send in the last wait operation
+    bool _interruptible{true};                            ///< Whether interrupt signals are considered as termination
+    bool _terminated{false};                              ///< Termination state flag
 };
 
 }  // namespace zmqzext
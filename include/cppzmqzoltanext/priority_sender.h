@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file priority_sender.h
+ * @brief Outbound scheduler sending control messages ahead of bulk data on one socket
+ *
+ * This header provides the priority_sender_t class, which sits in front of a
+ * socket registered in a loop_t and feeds it from several priority queues.
+ * Once a message is in the socket pipe, nothing can overtake it: a small
+ * control message sent after megabytes of bulk data waits until they are
+ * transmitted. The sender thus keeps the backlog in its own queues, where it
+ * can still be reordered, and only hands the socket messages it can take
+ * without blocking, whenever the loop reports it ready to send
+ * (loop_t::add_writable()).
+ *
+ * Queues are served in deficit round robin: each round, every queue with
+ * messages earns its quantum of bytes and sends messages while they fit in its
+ * accumulated deficit. Queue 0 has the highest priority and is visited first;
+ * giving it a large quantum makes control messages go out as soon as the
+ * socket is writable, while the quanta of the other queues guarantee them a
+ * share of the bandwidth, so bulk data is never starved.
+ *
+ * @code
+ * // Control traffic first, bulk traffic gets at least 64 KiB per round
+ * socket.set(zmq::sockopt::sndhwm, 16);
+ * priority_sender_t sender{loop, socket, priority_sender_options_t{{1024 * 1024, 64 * 1024}}};
+ * sender.send(1, zmq::buffer(chunk));
+ * sender.send(0, zmq::buffer(heartbeat));
+ * @endcode
+ *
+ * @details
+ * Key features:
+ * - Any number of priority queues, each with its own deficit round robin quantum
+ * - Direct sends while nothing is queued, no copy
+ * - Pushes only what the socket takes without blocking, when the loop reports it writable
+ * - Multipart messages queued and sent whole
+ *
+ * @note The lower the send high water mark of the socket, the less data is
+ * queued in the socket pipe out of reach of the scheduler, and the lower the
+ * latency of control messages under bulk load.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Options of a priority_sender_t
+ */
+struct priority_sender_options_t {
+    std::vector<std::size_t> quanta{1024 * 1024, 64 * 1024};  ///< Bytes earned each round by each queue, 0 first
+    std::size_t send_batch{1024};                             ///< Maximum messages sent each time the socket is ready
+};
+
+/**
+ * @brief Scheduler of the messages of several priority queues on one socket
+ *
+ * @note All the messages sent on the socket must go through the sender to keep their order.
+ * @note The sender must be destroyed before the loop and the socket.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT priority_sender_t {
+public:
+    /**
+     * @brief Construct a sender in front of a socket
+     *
+     * @param loop Loop sending the queued messages when the socket is ready to send
+     * @param socket Socket the messages are sent on
+     * @param options Sender options, with one quantum per priority queue
+     * @throws std::invalid_argument If the socket is invalid, there is no queue, a quantum is 0 or the batch is 0
+     */
+    priority_sender_t(loop_t& loop, zmq::socket_ref socket,
+                      priority_sender_options_t options = priority_sender_options_t{});
+
+    priority_sender_t(priority_sender_t const&) = delete;
+    priority_sender_t& operator=(priority_sender_t const&) = delete;
+
+    /**
+     * @brief Unregister the socket from the loop
+     *
+     * Messages still queued are discarded.
+     */
+    ~priority_sender_t() noexcept;
+
+    /**
+     * @brief Send a multipart message, queuing it if it cannot be sent now
+     *
+     * The message is sent at once if nothing is queued and the socket takes it
+     * without blocking, otherwise it is queued and sent in its turn.
+     *
+     * @param priority Index of the queue, 0 being the highest priority
+     * @param frames Frames of the message, moved from
+     * @throws std::invalid_argument If the priority is out of range or the message has no frame
+     * @throws zmq::error_t If sending fails for a reason other than the socket being full
+     */
+    void send(std::size_t priority, std::vector<zmq::message_t>&& frames);
+
+    /**
+     * @brief Send a single frame message, queuing it if it cannot be sent now
+     *
+     * @see send(std::size_t, std::vector<zmq::message_t>&&)
+     */
+    void send(std::size_t priority, zmq::message_t&& msg);
+
+    /**
+     * @brief Send a single frame message copied from a buffer, queuing it if it cannot be sent now
+     *
+     * @see send(std::size_t, std::vector<zmq::message_t>&&)
+     */
+    void send(std::size_t priority, zmq::const_buffer const& data) {
+        send(priority, zmq::message_t{data.data(), data.size()});
+    }
+
+    /**
+     * @brief Get the number of priority queues
+     */
+    std::size_t priorities() const noexcept { return _queues.size(); }
+
+    /**
+     * @brief Check if no message is queued
+     */
+    bool empty() const noexcept { return _queued_messages == 0; }
+
+    /**
+     * @brief Get the number of messages queued with a priority
+     *
+     * @throws std::invalid_argument If the priority is out of range
+     */
+    std::size_t queued_messages(std::size_t priority) const;
+
+    /**
+     * @brief Get the number of bytes of the messages queued with a priority
+     *
+     * @throws std::invalid_argument If the priority is out of range
+     */
+    std::size_t queued_bytes(std::size_t priority) const;
+
+private:
+    /**
+     * @brief Message queued whole, with its size in bytes
+     */
+    struct queued_message_t {
+        std::vector<zmq::message_t> frames;  ///< Frames of the message
+        std::size_t bytes;                   ///< Sum of the frame sizes
+    };
+
+    /**
+     * @brief Priority queue with its deficit round robin state
+     */
+    struct queue_t {
+        std::deque<queued_message_t> messages;  ///< Queued messages, oldest first
+        std::size_t bytes{0};                   ///< Bytes of the queued messages
+        std::size_t quantum{0};                 ///< Bytes earned each round
+        std::size_t deficit{0};                 ///< Bytes the queue may still send in the current round
+    };
+
+    queue_t& queue(std::size_t priority);
+    queue_t const& queue(std::size_t priority) const;
+    bool try_send(std::vector<zmq::message_t>& frames);
+    bool send_queued();
+
+    loop_t& _loop;                     ///< Loop sending the queued messages
+    zmq::socket_ref _socket;           ///< Destination socket
+    std::size_t _send_batch;           ///< Maximum messages sent each time the socket is ready
+    std::vector<queue_t> _queues;      ///< Queues by priority
+    std::size_t _current{0};           ///< Queue served in the current round
+    bool _quantum_granted{false};      ///< Whether the current queue earned its quantum in this visit
+    std::size_t _queued_messages{0};   ///< Messages queued in all queues
+    bool _writable_registered{false};  ///< Whether the socket is registered in the loop
+};
+
+}  // namespace zmqzext
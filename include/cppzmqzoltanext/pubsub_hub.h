@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file pubsub_hub.h
+ * @brief In-process publish/subscribe hub matching topics with a radix tree
+ *
+ * This header provides the pubsub_hub_t class, an actor fanning out published
+ * messages to in-process subscribers. Instead of a SUB socket per subscriber,
+ * each with its own subscriptions, the hub keeps the subscriptions of all its
+ * subscribers in a compressed prefix tree (radix tree). Each published message
+ * is matched once and its frames are sent to the matching subscribers only, as
+ * copies sharing the same content (zmq_msg_copy), so large frames are never
+ * duplicated.
+ *
+ * Publishers connect PUSH sockets to publish_endpoint() and send multipart
+ * messages whose first frame is the topic. Subscribers connect DEALER sockets
+ * to subscribe_endpoint() and send single frame commands with the same format
+ * as XPUB subscriptions:
+ * - [0x01][prefix]: subscribe to the topics starting with prefix
+ * - [0x00][prefix]: cancel a subscription to prefix
+ *
+ * Subscriptions are reference counted per subscriber, as with SUB sockets. A
+ * subscriber receives each matching message once, whatever the number of its
+ * subscriptions matching it. Subscribers that disconnect are forgotten the next
+ * time a message is routed to them; messages are dropped for subscribers whose
+ * high water mark is reached.
+ *
+ * @details
+ * Key features:
+ * - Single match per message against a radix tree of all the subscriptions
+ * - Zero-copy fan-out of the frames to the matching subscribers
+ * - Subscription protocol compatible with XPUB
+ * - Runs in its own thread (see actor_t)
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <string>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/actor.h"
+#include "cppzmqzoltanext/czze_export.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Actor routing published messages to the in-process subscribers of their topic
+ *
+ * @note This class is not thread-safe; publishers and subscribers may run in any thread.
+ */
+class CZZE_EXPORT pubsub_hub_t {
+public:
+    /**
+     * @brief Start the hub actor and bind its inproc endpoints
+     *
+     * @param context ZMQ context of the hub, publisher and subscriber sockets
+     * @throws zmq::error_t If the endpoints cannot be bound
+     */
+    explicit pubsub_hub_t(zmq::context_t& context);
+
+    pubsub_hub_t(pubsub_hub_t const&) = delete;
+    pubsub_hub_t& operator=(pubsub_hub_t const&) = delete;
+
+    /**
+     * @brief Stop the hub actor
+     */
+    ~pubsub_hub_t() noexcept;
+
+    /**
+     * @brief Get the endpoint publishers connect PUSH sockets to
+     */
+    std::string const& publish_endpoint() const noexcept { return _publish_endpoint; }
+
+    /**
+     * @brief Get the endpoint subscribers connect DEALER sockets to
+     */
+    std::string const& subscribe_endpoint() const noexcept { return _subscribe_endpoint; }
+
+private:
+    std::string _publish_endpoint;    ///< Endpoint of the PULL socket receiving published messages
+    std::string _subscribe_endpoint;  ///< Endpoint of the ROUTER socket of the subscribers
+    actor_t _actor;                   ///< Actor running the hub
+};
+
+}  // namespace zmqzext
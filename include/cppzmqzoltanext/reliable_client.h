@@ -0,0 +1,213 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file reliable_client.h
+ * @brief Asynchronous request client with pipelining, retries and failover
+ *
+ * This header provides the reliable_client_t class, a DEALER-based client
+ * running on a loop_t that replaces hand-written Lazy Pirate loops around REQ
+ * sockets. Many requests can be outstanding at once on a single connection,
+ * so the request rate is not bound by the round trip time.
+ *
+ * Each request is sent as a message made of a correlation id frame, an empty
+ * delimiter frame and the request frames. REP servers, and ROUTER servers that
+ * echo the envelope, return the correlation id with the reply, which is how
+ * replies are matched to their requests, in any order.
+ *
+ * Reliability:
+ * - Each attempt has a deadline, enforced with a loop_t timer.
+ * - A request whose attempt timed out is retried after an exponential backoff,
+ *   up to a maximum number of retries, then fails.
+ * - A timeout on the current connection is taken as a sign of a dead server:
+ *   the socket is closed (discarding its queued messages, as in Lazy Pirate),
+ *   a new one is connected to the next endpoint, and the requests in flight are
+ *   sent again on it.
+ * - Late or duplicated replies (for requests already completed) are discarded.
+ *
+ * @details
+ * Key features:
+ * - Up to N outstanding requests, matched to replies by correlation id
+ * - Backlog of requests waiting for a free slot
+ * - Per-request deadlines, retries with exponential backoff
+ * - Failover across endpoints
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+#include "cppzmqzoltanext/loop.h"
+
+namespace zmqzext {
+
+/// Identifier of a request of a reliable_client_t, also used as its correlation id
+using request_id_t = std::uint64_t;
+
+/**
+ * @brief Outcome of a request
+ */
+enum class request_result_t {
+    reply,   ///< A reply was received
+    timeout  ///< No reply was received after all the retries
+};
+
+/**
+ * @brief Handler called when a request completes
+ *
+ * @param result Outcome of the request
+ * @param reply Reply frames, empty on timeout
+ */
+using fn_reply_handler_t = std::function<void(request_result_t result, std::vector<zmq::message_t>& reply)>;
+
+/**
+ * @brief Options of a reliable_client_t
+ */
+struct reliable_client_options_t {
+    std::vector<std::string> endpoints;              ///< Server endpoints, in failover order
+    std::size_t max_outstanding{64};                 ///< Requests in flight at once; others wait in a backlog
+    std::chrono::milliseconds timeout{2500};         ///< Default deadline of each attempt
+    std::size_t max_retries{3};                      ///< Attempts after the first one before a request fails
+    std::chrono::milliseconds initial_backoff{100};  ///< Delay before the first retry, doubled on each retry
+    std::chrono::milliseconds max_backoff{5000};     ///< Maximum delay before a retry
+};
+
+/**
+ * @brief DEALER-based asynchronous request client with retries and failover
+ *
+ * @note Handlers run in the loop thread; they may send or cancel requests.
+ * @note The client must be destroyed before the loop.
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT reliable_client_t {
+public:
+    /**
+     * @brief Construct a client connected to the first endpoint
+     *
+     * @param context ZMQ context of the DEALER socket
+     * @param loop Loop running the socket handler and the timers
+     * @param options Client options
+     * @throws std::invalid_argument If there is no endpoint, max_outstanding is 0 or timeout is not positive
+     * @throws zmq::error_t If the socket cannot be created or connected
+     */
+    reliable_client_t(zmq::context_t& context, loop_t& loop, reliable_client_options_t options);
+
+    reliable_client_t(reliable_client_t const&) = delete;
+    reliable_client_t& operator=(reliable_client_t const&) = delete;
+
+    /**
+     * @brief Remove the socket and the timers from the loop
+     *
+     * Pending requests are dropped without calling their handlers.
+     */
+    ~reliable_client_t() noexcept;
+
+    /**
+     * @brief Send a request
+     *
+     * The request is sent at once if fewer than max_outstanding requests are in
+     * flight, otherwise when a slot frees up; its deadline starts when it is sent.
+     *
+     * @param frames Request frames
+     * @param fn Handler called with the reply or the timeout
+     * @param timeout Deadline of each attempt, or a negative value for the default one
+     * @return Identifier of the request
+     * @throws std::invalid_argument If there are no frames
+     */
+    request_id_t request(std::vector<zmq::message_t> frames, fn_reply_handler_t fn,
+                         std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /**
+     * @brief Cancel a request without calling its handler
+     *
+     * @param id Identifier of the request
+     * @return true if the request was pending, false if it already completed
+     */
+    bool cancel(request_id_t id);
+
+    /**
+     * @brief Get the number of requests sent and not completed, including those waiting for a retry
+     */
+    std::size_t outstanding() const noexcept { return _requests.size(); }
+
+    /**
+     * @brief Get the number of requests waiting for a free slot
+     */
+    std::size_t backlog() const noexcept { return _backlog.size(); }
+
+    /**
+     * @brief Get the endpoint the client is connected to
+     */
+    std::string const& endpoint() const noexcept { return _options.endpoints[_endpoint_index]; }
+
+private:
+    /**
+     * @brief State of a request
+     */
+    struct request_t {
+        request_id_t id;                     ///< Identifier and correlation id
+        std::vector<zmq::message_t> frames;  ///< Request frames, kept for retries
+        fn_reply_handler_t handler;          ///< Completion handler
+        std::chrono::milliseconds timeout;   ///< Deadline of each attempt
+        std::size_t attempts{0};             ///< Attempts sent so far
+        std::uint64_t generation{0};         ///< Connection the last attempt was sent on
+        timer_id_t timer{0};                 ///< Deadline or backoff timer, 0 if none
+        bool in_flight{false};               ///< Whether waiting for a reply rather than for a retry
+    };
+
+    void connect();
+    void send(request_t& request);
+    void fill_slots();
+    void complete(request_id_t id, request_result_t result, std::vector<zmq::message_t>& reply);
+    bool on_reply(zmq::socket_ref socket);
+    void on_timer(request_id_t id);
+
+    zmq::context_t& _context;                               ///< Context of the socket
+    loop_t& _loop;                                          ///< Loop running the handlers
+    reliable_client_options_t _options;                     ///< Client options
+    zmq::socket_t _socket;                                  ///< DEALER socket of the current connection
+    std::size_t _endpoint_index{0};                         ///< Endpoint of the current connection
+    std::uint64_t _generation{0};                           ///< Current connection, incremented on failover
+    request_id_t _last_id{0};                               ///< Last allocated request identifier
+    std::unordered_map<request_id_t, request_t> _requests;  ///< Outstanding requests
+    std::deque<request_t> _backlog;                         ///< Requests waiting for a free slot
+};
+
+}  // namespace zmqzext
@@ -0,0 +1,399 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file router_table.h
+ * @brief Routing table of ROUTER peers keyed by their raw identity bytes
+ *
+ * This header provides the router_table_t class template, a hash table mapping
+ * the routing identities of the peers of a ROUTER socket to per-peer state, and
+ * the router_message_t class, which receives multipart messages from a ROUTER
+ * socket into reused frames and locates their envelope.
+ *
+ * Lookups take the identity frame as received, with no conversion to a
+ * std::string, so routing a message is a single hash probe without allocation:
+ * @code
+ * router_message_t msg;
+ * while (msg.recv(socket, zmq::recv_flags::dontwait)) {
+ *     auto* peer = peers.find(msg.identity());
+ *     ...
+ * }
+ * @endcode
+ *
+ * The table uses open addressing with linear probing and backward shift
+ * deletion, so there are no tombstones and probe sequences stay short. Keys
+ * up to inline_key_capacity bytes (libzmq generated identities are 5 bytes)
+ * are stored inline in the table slots; longer keys are allocated once, when
+ * the peer is added.
+ *
+ * Key features:
+ * - Header-only
+ * - Lookup by raw identity bytes, without copy or allocation
+ * - Inline storage of small keys, cached hashes
+ * - Envelope access to received messages without copying frames
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <zmq.hpp>
+
+namespace zmqzext {
+
+/**
+ * @brief Hash table from ROUTER peer identities to per-peer state
+ *
+ * Pointers to states are invalidated by insertions and removals.
+ *
+ * @tparam State Per-peer state, default constructible and movable
+ * @note This class is not thread-safe.
+ */
+template <typename State>
+class router_table_t {
+public:
+    /// Keys up to this size are stored inline in the table
+    static constexpr std::size_t inline_key_capacity = 16;
+
+    router_table_t() = default;
+    router_table_t(router_table_t&&) noexcept = default;
+    router_table_t& operator=(router_table_t&&) noexcept = default;
+    router_table_t(router_table_t const&) = delete;
+    router_table_t& operator=(router_table_t const&) = delete;
+
+    /**
+     * @brief Find the state of a peer
+     *
+     * @return Pointer to the state, nullptr if the peer is unknown
+     */
+    State* find(void const* identity, std::size_t size) noexcept {
+        auto const index = find_index(identity, size);
+        return index != npos ? &_slots[index].state : nullptr;
+    }
+
+    /**
+     * @brief Find the state of the peer of an identity frame
+     */
+    State* find(zmq::message_t const& identity) noexcept { return find(identity.data(), identity.size()); }
+
+    /**
+     * @brief Add a peer if unknown
+     *
+     * @param args Arguments of the constructor of the state, used only if the peer is added
+     * @return Pointer to the state of the peer and whether it was added
+     */
+    template <typename... Args>
+    std::pair<State*, bool> try_emplace(void const* identity, std::size_t size, Args&&... args) {
+        if (auto* const state = find(identity, size)) {
+            return {state, false};
+        }
+        if ((_size + 1) * 4 > _slots.size() * 3) {
+            rehash(_slots.empty() ? min_capacity : _slots.size() * 2);
+        }
+        auto const hash = hash_bytes(identity, size);
+        auto index = hash & mask();
+        while (_slots[index].used) {
+            index = (index + 1) & mask();
+        }
+        auto& slot = _slots[index];
+        slot.used = true;
+        slot.hash = hash;
+        slot.key.assign(identity, size);
+        slot.state = State(std::forward<Args>(args)...);
+        ++_size;
+        return {&slot.state, true};
+    }
+
+    /**
+     * @brief Add the peer of an identity frame if unknown
+     */
+    template <typename... Args>
+    std::pair<State*, bool> try_emplace(zmq::message_t const& identity, Args&&... args) {
+        return try_emplace(identity.data(), identity.size(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Remove a peer
+     *
+     * @return true if the peer was removed, false if it was unknown
+     */
+    bool erase(void const* identity, std::size_t size) {
+        auto hole = find_index(identity, size);
+        if (hole == npos) {
+            return false;
+        }
+        // Backward shift: move back the following entries of the probe sequence that can fill the hole
+        for (auto index = (hole + 1) & mask(); _slots[index].used; index = (index + 1) & mask()) {
+            auto const ideal = _slots[index].hash & mask();
+            if (((index - ideal) & mask()) >= ((index - hole) & mask())) {
+                _slots[hole] = std::move(_slots[index]);
+                hole = index;
+            }
+        }
+        _slots[hole] = slot_t{};
+        --_size;
+        return true;
+    }
+
+    /**
+     * @brief Remove the peer of an identity frame
+     */
+    bool erase(zmq::message_t const& identity) { return erase(identity.data(), identity.size()); }
+
+    /**
+     * @brief Call a function with the identity and the state of each peer, in no particular order
+     *
+     * @param fn Function taking a zmq::const_buffer and a State&; it must not add or remove peers
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        for (auto& slot : _slots) {
+            if (slot.used) {
+                fn(zmq::const_buffer(slot.key.data(), slot.key.size), slot.state);
+            }
+        }
+    }
+
+    /**
+     * @brief Make room for a number of peers without rehashing
+     */
+    void reserve(std::size_t count) {
+        auto capacity = _slots.empty() ? min_capacity : _slots.size();
+        while (count * 4 > capacity * 3) {
+            capacity *= 2;
+        }
+        if (capacity != _slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    /**
+     * @brief Remove all the peers
+     */
+    void clear() {
+        _slots.clear();
+        _size = 0;
+    }
+
+    /**
+     * @brief Get the number of peers
+     */
+    std::size_t size() const noexcept { return _size; }
+
+    /**
+     * @brief Check if there is no peer
+     */
+    bool empty() const noexcept { return _size == 0; }
+
+private:
+    static constexpr std::size_t min_capacity = 16;
+
+    /**
+     * @brief Identity bytes, inline when small
+     */
+    struct key_t {
+        std::size_t size{0};                    ///< Number of bytes
+        char inline_data[inline_key_capacity];  ///< Bytes of a small key
+        std::unique_ptr<char[]> heap_data;      ///< Bytes of a large key
+
+        char const* data() const noexcept { return size <= inline_key_capacity ? inline_data : heap_data.get(); }
+
+        void assign(void const* bytes, std::size_t count) {
+            size = count;
+            if (count <= inline_key_capacity) {
+                heap_data.reset();
+                std::memcpy(inline_data, bytes, count);
+            } else {
+                heap_data.reset(new char[count]);
+                std::memcpy(heap_data.get(), bytes, count);
+            }
+        }
+
+        bool equals(void const* bytes, std::size_t count) const noexcept {
+            return size == count && std::memcmp(data(), bytes, count) == 0;
+        }
+    };
+
+    /**
+     * @brief Table slot
+     */
+    struct slot_t {
+        State state{};        ///< State of the peer
+        key_t key;            ///< Identity of the peer
+        std::size_t hash{0};  ///< Hash of the identity
+        bool used{false};     ///< Whether the slot holds a peer
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::size_t mask() const noexcept { return _slots.size() - 1; }
+
+    std::size_t find_index(void const* identity, std::size_t size) const noexcept {
+        if (_size == 0) {
+            return npos;
+        }
+        auto const hash = hash_bytes(identity, size);
+        for (auto index = hash & mask();; index = (index + 1) & mask()) {
+            auto const& slot = _slots[index];
+            if (!slot.used) {
+                return npos;
+            }
+            if (slot.hash == hash && slot.key.equals(identity, size)) {
+                return index;
+            }
+        }
+    }
+
+    /// FNV-1a with a final mix, so that identities differing in their last bytes spread over the low bits
+    static std::size_t hash_bytes(void const* bytes, std::size_t size) noexcept {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto const* const data = static_cast<unsigned char const*>(bytes);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return static_cast<std::size_t>(hash);
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<slot_t> slots(capacity);
+        std::swap(slots, _slots);
+        for (auto& slot : slots) {
+            if (slot.used) {
+                auto index = slot.hash & mask();
+                while (_slots[index].used) {
+                    index = (index + 1) & mask();
+                }
+                _slots[index] = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<slot_t> _slots;  ///< Slots, a power of two of them
+    std::size_t _size{0};        ///< Number of peers
+};
+
+/**
+ * @brief Multipart message received from a ROUTER socket, with its envelope located
+ *
+ * The frames are kept between messages and received into again, so receiving
+ * does not allocate once the message has reached its largest number of frames.
+ * The envelope is made of the frames up to the first empty frame after the
+ * identity; messages without empty frame have the identity alone as envelope.
+ *
+ * @note This class is not thread-safe.
+ */
+class router_message_t {
+public:
+    /**
+     * @brief Receive all the frames of a message
+     *
+     * @return true if a message was received, false if none was available (zmq::recv_flags::dontwait)
+     * @throws zmq::error_t If receiving fails
+     */
+    bool recv(zmq::socket_ref socket, zmq::recv_flags flags = zmq::recv_flags::none) {
+        _count = 0;
+        _delimiter = 0;
+        do {
+            if (_count == _frames.size()) {
+                _frames.emplace_back();
+            }
+            if (!socket.recv(_frames[_count], _count == 0 ? flags : zmq::recv_flags::none)) {
+                return false;
+            }
+            if (_delimiter == 0 && _count > 0 && _frames[_count].size() == 0) {
+                _delimiter = _count;
+            }
+            ++_count;
+        } while (_frames[_count - 1].more());
+        return true;
+    }
+
+    /**
+     * @brief Send the frames of the message, from first, leaving them empty
+     *
+     * @param first Index of the first frame to send, e.g. 0 to return a reply with its envelope
+     * @return true if the message was sent, false if it could not be sent now (zmq::send_flags::dontwait)
+     * @throws zmq::error_t If sending fails
+     */
+    bool send(zmq::socket_ref socket, std::size_t first = 0, zmq::send_flags flags = zmq::send_flags::none) {
+        for (auto i = first; i < _count; ++i) {
+            auto const more = i + 1 < _count ? zmq::send_flags::sndmore : zmq::send_flags::none;
+            if (!socket.send(_frames[i], flags | more) && i == first) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the identity frame of the sender
+     */
+    zmq::message_t& identity() noexcept { return _frames.front(); }
+
+    /**
+     * @brief Get the number of frames of the envelope, including the identity and the empty delimiter frame
+     */
+    std::size_t envelope_size() const noexcept { return _delimiter == 0 ? 1 : _delimiter + 1; }
+
+    /**
+     * @brief Get the number of frames after the envelope
+     */
+    std::size_t body_size() const noexcept { return _count - envelope_size(); }
+
+    /**
+     * @brief Get a frame after the envelope
+     */
+    zmq::message_t& body(std::size_t index) noexcept { return _frames[envelope_size() + index]; }
+
+    /**
+     * @brief Get the number of frames of the message
+     */
+    std::size_t size() const noexcept { return _count; }
+
+    /**
+     * @brief Get a frame of the message
+     */
+    zmq::message_t& operator[](std::size_t index) noexcept { return _frames[index]; }
+
+private:
+    std::vector<zmq::message_t> _frames;  ///< Frames, reused between messages
+    std::size_t _count{0};                ///< Frames of the current message
+    std::size_t _delimiter{0};            ///< Index of the empty delimiter frame, 0 if none
+};
+
+}  // namespace zmqzext
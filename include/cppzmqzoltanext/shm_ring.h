@@ -0,0 +1,218 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file shm_ring.h
+ * @brief Pipe between two processes of the same host backed by shared memory rings
+ *
+ * This header provides the shm_ring_t class, the inter-process counterpart of
+ * ring_pipe_t. A named POSIX shared memory segment (in /dev/shm on Linux)
+ * holds two lock-free single-producer/single-consumer rings, one per direction,
+ * so sending a frame is a memory copy into the mapped ring and receiving it a
+ * copy out of it: no system call and no kernel copy per message, unlike the
+ * ipc:// transport.
+ *
+ * Each endpoint exposes a file descriptor that becomes readable when there are
+ * frames to receive, a named FIFO next to the segment, so it can be registered
+ * in a poller_t or loop_t (add_fd()) together with regular ZMQ sockets. As with
+ * ring_pipe_t, the descriptor is only signaled when the ring goes from empty to
+ * non-empty, so a busy stream of frames costs no system calls.
+ *
+ * One process creates the pipe with create() and another one opens it by name
+ * with open(). The send and receive API mirrors the cppzmq socket API, so the
+ * EINTR retrying helpers can be used with shared memory rings as well.
+ *
+ * @code
+ * // Process A
+ * auto ring = shm_ring_t::create("orders");
+ * loop.add_fd(ring.fd(), [&ring](loop_t&, zmq::fd_t) { ... ring.recv(msg, zmq::recv_flags::dontwait) ... });
+ *
+ * // Process B
+ * auto ring = shm_ring_t::open("orders");
+ * ring.send(zmq::buffer(order));
+ * @endcode
+ *
+ * @details
+ * Key features:
+ * - Same ring algorithm and frame format as ring_pipe_t, placed in shared memory
+ * - Inline variable-sized frames, multipart messages through zmq::send_flags::sndmore
+ * - Pollable notification descriptor, signaled only on empty to non-empty transitions
+ * - Segment and FIFOs removed by the creator when it is destroyed
+ *
+ * @note Each direction has a single producer and a single consumer: a pipe
+ * connects exactly two processes, and each endpoint must be used by one thread
+ * at a time.
+ * @note A blocking send() or recv() checks every 100 ms that the peer endpoint
+ * is still attached and its process still exists, and throws zmq::error_t with
+ * EPIPE otherwise. A peer process that exited but was not reaped yet, or whose
+ * pid was reused, still counts as alive; use a heartbeat to monitor it when
+ * that matters. Non-blocking calls and the descriptor do not report the death.
+ * @note Not available on Windows, where creating a ring throws std::runtime_error.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/czze_export.h"
+
+namespace zmqzext {
+
+namespace detail {
+class spsc_ring_t;
+}
+
+/**
+ * @brief One endpoint of a bidirectional pipe between two processes, over shared memory
+ *
+ * @note This class is not thread-safe.
+ */
+class CZZE_EXPORT shm_ring_t {
+public:
+    /// Default capacity in bytes of each direction of the pipe
+    static constexpr std::size_t DEFAULT_CAPACITY{4 * 1024 * 1024};
+
+    /**
+     * @brief Create a named pipe and get its first endpoint
+     *
+     * @param name Name of the pipe, a non-empty string without '/'
+     * @param capacity Capacity in bytes of each direction, rounded up to a power of two
+     * @return The endpoint of the creating process
+     * @throws std::invalid_argument if the name is invalid
+     * @throws std::system_error if the pipe already exists or the segment or FIFOs cannot be created
+     * @throws std::runtime_error if the platform does not support shared memory rings
+     */
+    static shm_ring_t create(std::string const& name, std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Open a pipe created by another process and get its second endpoint
+     *
+     * @param name Name given to create()
+     * @return The endpoint of the opening process
+     * @throws std::invalid_argument if the name is invalid
+     * @throws std::system_error if the pipe does not exist or cannot be mapped
+     * @throws std::runtime_error if the pipe is not initialized yet or already opened by another endpoint
+     */
+    static shm_ring_t open(std::string const& name);
+
+    /**
+     * @brief Remove the segment and FIFOs of a pipe left behind by a process that did not exit cleanly
+     *
+     * Endpoints already opened keep working. Removing a pipe that does not exist is a no-op.
+     *
+     * @param name Name given to create()
+     */
+    static void remove(std::string const& name) noexcept;
+
+    shm_ring_t(shm_ring_t const&) = delete;
+    shm_ring_t& operator=(shm_ring_t const&) = delete;
+    shm_ring_t(shm_ring_t&& other) noexcept;
+    shm_ring_t& operator=(shm_ring_t&& other) noexcept;
+
+    /**
+     * @brief Unmap the pipe, removing its segment and FIFOs if this endpoint created it
+     */
+    ~shm_ring_t() noexcept;
+
+    /**
+     * @brief Send a frame to the other endpoint
+     *
+     * A blocking send on a full ring sleeps until the peer frees space.
+     *
+     * @throws zmq::error_t with EPIPE if a blocking send waits for a peer endpoint that is gone
+     * @see ring_pipe_t::send()
+     */
+    zmq::send_result_t send(zmq::const_buffer const& buf, zmq::send_flags flags = zmq::send_flags::none);
+
+    /**
+     * @brief Receive a frame into a buffer
+     *
+     * @throws zmq::error_t with EPIPE if a blocking receive waits for a peer endpoint that is gone
+     * @see ring_pipe_t::recv(zmq::mutable_buffer const&, zmq::recv_flags)
+     */
+    zmq::recv_buffer_result_t recv(zmq::mutable_buffer const& buf, zmq::recv_flags flags = zmq::recv_flags::none);
+
+    /**
+     * @brief Receive a frame into a message
+     *
+     * @throws zmq::error_t with EPIPE if a blocking receive waits for a peer endpoint that is gone
+     * @see ring_pipe_t::recv(zmq::message_t&, zmq::recv_flags)
+     */
+    zmq::recv_result_t recv(zmq::message_t& msg, zmq::recv_flags flags = zmq::recv_flags::none);
+
+    /**
+     * @brief Check if the last received frame is followed by more frames of the same message
+     */
+    bool more() const noexcept { return _more; }
+
+    /**
+     * @brief Get the notification descriptor, readable when there are frames to receive
+     *
+     * It must only be polled, never read or written directly.
+     */
+    zmq::fd_t fd() const noexcept;
+
+    /**
+     * @brief Get the capacity in bytes of each direction of the pipe
+     */
+    std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Get the largest frame size accepted by send()
+     */
+    std::size_t max_message_size() const noexcept;
+
+    /**
+     * @brief Get the name of the pipe
+     */
+    std::string const& name() const noexcept;
+
+private:
+    struct segment_t;
+
+    shm_ring_t(std::unique_ptr<segment_t> segment, std::size_t side);
+
+    /**
+     * @brief Check whether the peer endpoint is attached, or not attached yet, and its process exists
+     */
+    bool peer_alive() const noexcept;
+
+    std::unique_ptr<segment_t> _segment;       ///< Mapping and notifications of the pipe
+    std::unique_ptr<detail::spsc_ring_t> _tx;  ///< Producer view of the outgoing ring
+    std::unique_ptr<detail::spsc_ring_t> _rx;  ///< Consumer view of the incoming ring
+    std::size_t _side{0};                      ///< Endpoint index (0 creator, 1 opener)
+    bool _more{false};                         ///< Whether the last received frame had more frames
+};
+
+}  // namespace zmqzext
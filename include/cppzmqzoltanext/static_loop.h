@@ -0,0 +1,360 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file static_loop.h
+ * @brief Event loop over a fixed set of sockets and timers known at compile time
+ *
+ * This header provides the static_loop_t class template, an event loop for
+ * the common case of a loop whose sockets and timers never change, such as
+ * a simple actor reading its pipe and one data socket. The handlers are
+ * template parameters instead of std::function objects, the poll items live
+ * in a std::array and the ready sockets are dispatched by index, without
+ * any registry lookup, so the compiler can inline the handlers into the loop.
+ *
+ * The set is given at construction as a list of slots, made with
+ * static_socket() and static_timer(). Handlers are called in slot order:
+ * the expired timers first, then the sockets ready to receive, as loop_t does.
+ *
+ * @code
+ * static_loop_t loop{static_socket(pipe, [&](zmq::socket_ref socket) { return handle_command(socket); }),
+ *                    static_socket(data, [&](zmq::socket_ref socket) { return handle_data(socket); }),
+ *                    static_timer(std::chrono::seconds{1}, 0, [&]() { return send_heartbeat(); })};
+ * loop.run();
+ * @endcode
+ *
+ * @details
+ * Key features:
+ * - Sockets and timers fixed at compile time, with no allocation
+ * - Handlers called directly, inlinable, without std::function
+ * - Poll items kept in a std::array, ready sockets dispatched by index
+ * - Same run, timer and termination semantics as loop_t::run()
+ *
+ * @note Sockets cannot be added or removed, and the rate limits, drain,
+ * metrics and accounting of loop_t are not available: use loop_t for those.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <zmq.hpp>
+
+#include "cppzmqzoltanext/interrupt.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Slot of a static_loop_t calling a handler when a socket is ready to receive
+ *
+ * @tparam Handler Callable as bool(zmq::socket_ref), returning false to stop the loop
+ */
+template <typename Handler>
+struct static_socket_t {
+    zmq::socket_ref socket;  ///< Socket polled for receiving
+    Handler handler;         ///< Handler called when the socket is ready
+};
+
+/**
+ * @brief Slot of a static_loop_t calling a handler at regular intervals
+ *
+ * @tparam Handler Callable as bool(), returning false to stop the loop
+ */
+template <typename Handler>
+struct static_timer_t {
+    std::chrono::milliseconds timeout;  ///< Interval between the calls
+    std::size_t occurences;             ///< Number of calls, 0 for infinite
+    Handler handler;                    ///< Handler called when the timer expires
+};
+
+/**
+ * @brief Make a socket slot of a static_loop_t
+ *
+ * @param socket Socket polled for receiving
+ * @param handler Callable as bool(zmq::socket_ref), returning false to stop the loop
+ */
+template <typename Handler>
+static_socket_t<std::decay_t<Handler>> static_socket(zmq::socket_ref socket, Handler&& handler) {
+    return static_socket_t<std::decay_t<Handler>>{socket, std::forward<Handler>(handler)};
+}
+
+/**
+ * @brief Make a timer slot of a static_loop_t
+ *
+ * @param timeout Interval between the calls, the first one being a timeout after the loop construction
+ * @param occurences Number of calls, 0 for infinite
+ * @param handler Callable as bool(), returning false to stop the loop
+ */
+template <typename Handler>
+static_timer_t<std::decay_t<Handler>> static_timer(std::chrono::milliseconds timeout, std::size_t occurences,
+                                                   Handler&& handler) {
+    return static_timer_t<std::decay_t<Handler>>{timeout, occurences, std::forward<Handler>(handler)};
+}
+
+namespace detail {
+
+template <typename Slot>
+struct is_static_socket : std::false_type {};
+
+template <typename Handler>
+struct is_static_socket<static_socket_t<Handler>> : std::true_type {};
+
+template <typename Slot>
+struct is_static_timer : std::false_type {};
+
+template <typename Handler>
+struct is_static_timer<static_timer_t<Handler>> : std::true_type {};
+
+}  // namespace detail
+
+/**
+ * @brief Event loop over a fixed set of socket and timer slots
+ *
+ * Timers are armed at construction. As in loop_t, they are fixed-rate, a
+ * timer whose handler returned false fires again on the next run, and the
+ * run returns once no socket is left to poll and all the timers have fired
+ * their occurrences.
+ *
+ * @tparam Slots static_socket_t and static_timer_t slots, deduced from the constructor arguments
+ * @note The sockets must outlive the loop.
+ * @note This class is not thread-safe.
+ * @see loop_t
+ */
+template <typename... Slots>
+class static_loop_t {
+private:
+    static_assert(sizeof...(Slots) > 0, "A static loop needs at least one slot");
+    static_assert(((detail::is_static_socket<Slots>::value || detail::is_static_timer<Slots>::value) && ...),
+                  "Slots must be made with static_socket() or static_timer()");
+
+    using time_point_t = std::chrono::time_point<std::chrono::steady_clock>;
+    using time_milliseconds_t = std::chrono::milliseconds;
+
+    static constexpr std::array<bool, sizeof...(Slots)> k_is_socket{detail::is_static_socket<Slots>::value...};
+    static constexpr std::size_t k_socket_count = (std::size_t{detail::is_static_socket<Slots>::value} + ...);
+    static constexpr std::size_t k_timer_count = sizeof...(Slots) - k_socket_count;
+
+    /**
+     * @brief Position of a slot among the slots of its kind, its index in the poll items or in the timers
+     */
+    static constexpr std::size_t position(std::size_t slot) {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < slot; ++i) {
+            if (k_is_socket[i] == k_is_socket[slot]) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Internal timer state
+     */
+    struct timer_state_t {
+        time_point_t next_occurence;  ///< Next scheduled expiration time
+        std::size_t occurences;       ///< Remaining occurrences (0 for infinite)
+        bool active;                  ///< Whether the timer still has occurrences to fire
+    };
+
+public:
+    /**
+     * @brief Construct the loop over its slots, arming the timers
+     *
+     * @param slots Slots made with static_socket() and static_timer()
+     * @throws std::invalid_argument if a socket is invalid
+     */
+    explicit static_loop_t(Slots... slots) : _slots(std::move(slots)...) {
+        auto const current_time = std::chrono::steady_clock::now();
+        init_slots(current_time, std::index_sequence_for<Slots...>{});
+    }
+
+    /**
+     * @brief Run the loop until a handler returns false, the loop is terminated or nothing is left to wait for
+     *
+     * @param interruptible Whether interrupt signals terminate the loop, see loop_t::run()
+     * @param interruptCheckInterval Maximum time to wait before checking for interrupts, -1 for no limit
+     * @see loop_t::run()
+     */
+    void run(bool interruptible = true, time_milliseconds_t interruptCheckInterval = time_milliseconds_t{-1}) {
+        auto should_continue = true;
+        while (should_continue) {
+            if (k_socket_count == 0 && _active_timers == 0) {
+                break;
+            }
+            auto const next_timeout = find_next_timeout(std::chrono::steady_clock::now(), interruptCheckInterval);
+            if (!wait(next_timeout, interruptible)) {
+                break;
+            }
+            auto const current_time = std::chrono::steady_clock::now();
+            should_continue = dispatch_timers(current_time, std::index_sequence_for<Slots...>{}) &&
+                              dispatch_sockets(std::index_sequence_for<Slots...>{});
+        }
+    }
+
+    /**
+     * @brief Check if the last run was terminated by an interrupt signal or the context termination
+     */
+    bool terminated() const noexcept { return _terminated; }
+
+private:
+    template <std::size_t... I>
+    void init_slots(time_point_t const& current_time, std::index_sequence<I...>) {
+        (init_slot<I>(current_time), ...);
+    }
+
+    template <std::size_t I>
+    void init_slot(time_point_t const& current_time) {
+        auto& slot = std::get<I>(_slots);
+        if constexpr (k_is_socket[I]) {
+            if (!slot.socket) {
+                throw std::invalid_argument("Cannot add null socket to static loop");
+            }
+            constexpr auto index = position(I);
+            _poll_items[index] = zmq::pollitem_t{slot.socket.handle(), 0, ZMQ_POLLIN, 0};
+        } else {
+            constexpr auto index = position(I);
+            _timers[index] = timer_state_t{current_time + slot.timeout, slot.occurences, true};
+            ++_active_timers;
+        }
+    }
+
+    /**
+     * @brief Poll the sockets, with the termination rules of poller_t
+     *
+     * @return false if the loop is terminated
+     */
+    bool wait(time_milliseconds_t timeout, bool interruptible) {
+        _terminated = false;
+        if (is_interrupted() && interruptible) {
+            _terminated = true;
+            return false;
+        }
+        try {
+            zmq::poll(_poll_items.data(), _poll_items.size(), timeout);
+            // interrupt may have happened between is_interrupted() and poll() calls
+            if (is_interrupted() && interruptible) {
+                _terminated = true;
+                return false;
+            }
+        } catch (zmq::error_t const& e) {
+            auto const error = e.num();
+            if (error == ETERM || (error == EINTR && interruptible && is_interrupted())) {
+                _terminated = true;
+                return false;
+            }
+            if (error != EINTR) {
+                throw;
+            }
+            // other signals only wake up the wait
+            for (auto& item : _poll_items) {
+                item.revents = 0;
+            }
+        }
+        return true;
+    }
+
+    time_milliseconds_t find_next_timeout(time_point_t const& actual_time,
+                                          time_milliseconds_t interruptCheckInterval) const {
+        auto const next_timer_it = std::min_element(
+            _timers.begin(), _timers.end(), [](timer_state_t const& a, timer_state_t const& b) {
+                return a.active && (!b.active || a.next_occurence < b.next_occurence);
+            });
+        if (next_timer_it == _timers.end() || !next_timer_it->active) {
+            if (interruptCheckInterval > time_milliseconds_t{0}) {
+                return interruptCheckInterval;
+            }
+            return time_milliseconds_t{-1};
+        }
+        auto const time_left = next_timer_it->next_occurence - actual_time;
+        if (interruptCheckInterval > time_milliseconds_t{0} && time_left > interruptCheckInterval) {
+            return interruptCheckInterval;
+        }
+        return std::max(time_milliseconds_t{0}, std::chrono::ceil<time_milliseconds_t>(time_left));
+    }
+
+    template <std::size_t... I>
+    bool dispatch_timers(time_point_t const& current_time, std::index_sequence<I...>) {
+        return (dispatch_timer<I>(current_time) && ...);
+    }
+
+    template <std::size_t I>
+    bool dispatch_timer(time_point_t const& current_time) {
+        if constexpr (!k_is_socket[I]) {
+            auto& slot = std::get<I>(_slots);
+            constexpr auto index = position(I);
+            auto& timer = _timers[index];
+            if (timer.active && current_time >= timer.next_occurence) {
+                if (!slot.handler()) {
+                    return false;
+                }
+                if (timer.occurences > 0 && --timer.occurences == 0) {
+                    timer.active = false;
+                    --_active_timers;
+                } else {
+                    timer.next_occurence += slot.timeout;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <std::size_t... I>
+    bool dispatch_sockets(std::index_sequence<I...>) {
+        return (dispatch_socket<I>() && ...);
+    }
+
+    template <std::size_t I>
+    bool dispatch_socket() {
+        if constexpr (k_is_socket[I]) {
+            auto& slot = std::get<I>(_slots);
+            constexpr auto index = position(I);
+            if ((_poll_items[index].revents & ZMQ_POLLIN) != 0) {
+                return slot.handler(slot.socket);
+            }
+        }
+        return true;
+    }
+
+    std::tuple<Slots...> _slots;                               ///< Sockets, timers and their handlers
+    std::array<zmq::pollitem_t, k_socket_count> _poll_items{};  ///< Poll items of the sockets, in slot order
+    std::array<timer_state_t, k_timer_count> _timers{};        ///< State of the timers, in slot order
+    std::size_t _active_timers{0};                             ///< Timers with occurrences left
+    bool _terminated{false};                                   ///< Whether the last run was terminated
+};
+
+}  // namespace zmqzext
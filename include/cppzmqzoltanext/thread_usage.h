@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file thread_usage.h
+ * @brief CPU time and context switches of a thread
+ *
+ * This header provides the thread_usage_t snapshot struct and the
+ * current_thread_usage() function, which samples the CPU time consumed by the
+ * calling thread (CLOCK_THREAD_CPUTIME_ID) and its voluntary and involuntary
+ * context switches (getrusage(RUSAGE_THREAD)).
+ *
+ * Snapshots are meant to be compared over time: the difference between two
+ * snapshots of the same thread tells how much CPU it burnt and how often it
+ * was switched out in between. loop_t and actor_t expose the usage of their
+ * threads as such snapshots, see loop_t::usage() and actor_t::usage().
+ *
+ * @details
+ * Key features:
+ * - CPU time of the thread, user and system
+ * - Voluntary context switches (blocking waits) and involuntary ones (preemptions)
+ * - Snapshot differences with operator-
+ *
+ * @note Context switches are only counted on Linux, and CPU time on POSIX and
+ * Windows; the other fields are left at 0.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "cppzmqzoltanext/czze_export.h"
+
+namespace zmqzext {
+
+/**
+ * @brief Resource usage of a thread at some point in time
+ */
+struct thread_usage_t {
+    std::chrono::nanoseconds cpu_time{0};   ///< CPU time consumed, user and system
+    std::uint64_t voluntary_switches{0};    ///< Context switches while waiting for a resource
+    std::uint64_t involuntary_switches{0};  ///< Context switches by preemption
+
+    /**
+     * @brief Get the usage between an earlier snapshot and this one
+     */
+    thread_usage_t operator-(thread_usage_t const& earlier) const noexcept {
+        return thread_usage_t{cpu_time - earlier.cpu_time, voluntary_switches - earlier.voluntary_switches,
+                              involuntary_switches - earlier.involuntary_switches};
+    }
+
+    /**
+     * @brief Accumulate the usage of another snapshot difference
+     */
+    thread_usage_t& operator+=(thread_usage_t const& other) noexcept {
+        cpu_time += other.cpu_time;
+        voluntary_switches += other.voluntary_switches;
+        involuntary_switches += other.involuntary_switches;
+        return *this;
+    }
+};
+
+/**
+ * @brief Sample the resource usage of the calling thread
+ *
+ * Costs two system calls.
+ *
+ * @return Usage of the calling thread since it started
+ */
+CZZE_EXPORT thread_usage_t current_thread_usage() noexcept;
+
+}  // namespace zmqzext
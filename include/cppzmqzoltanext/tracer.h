@@ -0,0 +1,223 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file tracer.h
+ * @brief In-process event tracer with Chrome trace export
+ *
+ * This header provides an opt-in tracer that records begin/end events into
+ * per-thread lock-free ring buffers and exports them in the Chrome
+ * trace_event JSON format, which can be loaded in chrome://tracing or Perfetto.
+ *
+ * When the library is built with the CZZE_ENABLE_TRACING option, loop_t records
+ * the poll waits ("loop.poll") and the timer, socket and file descriptor handler
+ * calls ("loop.timer", "loop.socket", "loop.writable", "loop.fd"), and actor_t records its start
+ * and stop operations ("actor.start", "actor.stop") and the execution of the
+ * actor function in the child thread ("actor.run"). Recording only happens while
+ * the tracer is enabled at runtime with enable_tracing().
+ *
+ * Each thread writes to its own ring buffer, so recording needs no locks: a
+ * timestamp read (TSC on x86) and a few stores. When a ring buffer is full, the
+ * oldest events of that thread are overwritten. Buffers of finished threads are
+ * kept until clear_trace() is called, so their events can still be exported.
+ *
+ * The trace can be written on demand with write_chrome_trace() or
+ * dump_chrome_trace(), or when the process receives a signal after
+ * install_trace_dump_handler() (POSIX only).
+ *
+ * Applications can record their own events with CZZE_TRACE_SCOPE, or with
+ * trace_begin() and trace_end(). When tracing is compiled out, CZZE_TRACE_SCOPE
+ * expands to nothing and the functions are no-ops.
+ *
+ * Key features:
+ * - Per-thread lock-free ring buffers
+ * - TSC timestamps converted to microseconds at export time
+ * - Chrome trace_event JSON export on demand or on signal
+ * - Zero cost when compiled out
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#if !defined(WIN32)
+#include <signal.h>
+#endif
+
+#include "cppzmqzoltanext/czze_export.h"
+
+namespace zmqzext {
+
+/// Size of the per-thread ring buffers; the last k_trace_buffer_events - 1 events of each thread are exported.
+constexpr std::size_t k_trace_buffer_events = 8192;
+
+/**
+ * @brief Check if the library was built with tracing support
+ *
+ * @return true if built with CZZE_ENABLE_TRACING, false otherwise
+ */
+CZZE_EXPORT bool is_tracing_compiled_in() noexcept;
+
+/**
+ * @brief Start recording trace events
+ *
+ * Also takes the timestamp reference used to convert TSC ticks to time.
+ *
+ * @note This function is thread-safe. Does nothing if tracing is compiled out.
+ */
+CZZE_EXPORT void enable_tracing() noexcept;
+
+/**
+ * @brief Stop recording trace events
+ *
+ * Already recorded events are kept and can still be exported.
+ *
+ * @note This function is thread-safe.
+ */
+CZZE_EXPORT void disable_tracing() noexcept;
+
+/**
+ * @brief Check if trace events are being recorded
+ *
+ * @return true if tracing is compiled in and enabled, false otherwise
+ * @note This function is thread-safe and non-blocking.
+ */
+CZZE_EXPORT bool is_tracing_enabled() noexcept;
+
+/**
+ * @brief Record the beginning of an event in the calling thread
+ *
+ * @param name Event name; must outlive the tracer (typically a string literal)
+ * @return true if the event was recorded, false if tracing is disabled
+ */
+CZZE_EXPORT bool trace_begin(char const* name) noexcept;
+
+/**
+ * @brief Record the end of an event in the calling thread
+ *
+ * @param name Event name; must be the same used in the matching trace_begin()
+ * @return true if the event was recorded, false if tracing is disabled
+ */
+CZZE_EXPORT bool trace_end(char const* name) noexcept;
+
+/**
+ * @brief Discard all recorded events and the buffers of finished threads
+ *
+ * @note Events being recorded concurrently by other threads may be kept.
+ */
+CZZE_EXPORT void clear_trace();
+
+/**
+ * @brief Write the recorded events in Chrome trace_event JSON format
+ *
+ * May be called while other threads are recording; events overwritten during
+ * the export are skipped.
+ *
+ * @param os Output stream
+ */
+CZZE_EXPORT void write_chrome_trace(std::ostream& os);
+
+/**
+ * @brief Write the recorded events in Chrome trace_event JSON format to a file
+ *
+ * @param path Output file path, overwritten if it exists
+ * @throws std::runtime_error If the file cannot be written
+ */
+CZZE_EXPORT void dump_chrome_trace(std::string const& path);
+
+#if !defined(WIN32)
+/**
+ * @brief Dump the trace to a file whenever the process receives a signal
+ *
+ * Installs a handler for the given signal that wakes up a background thread,
+ * which writes the trace with dump_chrome_trace(). The handler itself is
+ * async-signal-safe. Calling it again replaces the path and the signal.
+ *
+ * Poller and loop waits interrupted by this signal resume without being
+ * terminated.
+ *
+ * @param path Output file path, overwritten on each dump
+ * @param signum Signal that requests the dump
+ * @throws std::system_error If the background thread cannot be created
+ * @note This function is not thread-safe.
+ * @see restore_trace_dump_handler()
+ */
+CZZE_EXPORT void install_trace_dump_handler(std::string const& path, int signum = SIGUSR1);
+
+/**
+ * @brief Restore the signal handler replaced by install_trace_dump_handler()
+ *
+ * Also stops the background thread. Does nothing if no handler is installed.
+ *
+ * @note This function is not thread-safe.
+ */
+CZZE_EXPORT void restore_trace_dump_handler() noexcept;
+#endif
+
+/**
+ * @brief Records a begin event on construction and the matching end event on destruction
+ *
+ * @note Prefer CZZE_TRACE_SCOPE, which compiles out when tracing is disabled.
+ */
+class trace_scope_t {
+public:
+    explicit trace_scope_t(char const* name) noexcept : _name(name), _recorded(trace_begin(name)) {}
+
+    trace_scope_t(trace_scope_t const&) = delete;
+    trace_scope_t& operator=(trace_scope_t const&) = delete;
+
+    ~trace_scope_t() noexcept {
+        if (_recorded) {
+            trace_end(_name);
+        }
+    }
+
+private:
+    char const* _name;  ///< Event name
+    bool _recorded;     ///< Whether the begin event was recorded
+};
+
+}  // namespace zmqzext
+
+#define CZZE_TRACE_CONCAT_IMPL(a, b) a##b
+#define CZZE_TRACE_CONCAT(a, b) CZZE_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(CZZE_ENABLE_TRACING)
+/**
+ * @brief Trace the enclosing scope as an event with the given name
+ */
+#define CZZE_TRACE_SCOPE(name) \
+    ::zmqzext::trace_scope_t const CZZE_TRACE_CONCAT(czze_trace_scope_, __LINE__) { name }
+#else
+#define CZZE_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -47,6 +47,7 @@ SOFTWARE.
  * - Throwing lookup functions signal missing properties or invalid paths.
  * - try_* functions return empty optionals instead of throwing.
  * - children() returns direct children in source order.
+ * - The tree can be allocated from a caller provided memory resource; lookups do not allocate.
  *
  * Error model:
  * - zpl_parse_error for syntax/structure violations (with line number).
@@ -67,6 +68,7 @@ SOFTWARE.
 #include <cstddef>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -141,34 +143,53 @@ public:
      */
     zpl_config_t() noexcept;
 
+    /**
+     * @brief Construct an empty configuration allocating its tree from a memory resource
+     *
+     * The nodes of the trees later loaded, their child lists and lookup tables
+     * and the configuration objects returned by child lookups are allocated
+     * from the resource. Names and values longer than the small string buffer
+     * of std::string still come from the global heap, as they are returned by
+     * reference to std::string.
+     *
+     * @param resource Memory resource of the tree, which must outlive the
+     *        configuration and all the configurations obtained from it
+     */
+    explicit zpl_config_t(std::pmr::memory_resource* resource);
+
     /**
      * @brief Construct and parse a configuration from a stream
      *
      * @param input Input stream containing ZPL text
+     * @param resource Memory resource of the tree, see zpl_config_t(std::pmr::memory_resource*)
      * @throws zpl_parse_error on parse errors
      * @throws std::ios_base::failure if any error during input reading occurs
      */
-    explicit zpl_config_t(std::istream& input);
+    explicit zpl_config_t(std::istream& input, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Parse and return a configuration from a stream
      *
      * @param input Input stream containing ZPL text
+     * @param resource Memory resource of the tree, see zpl_config_t(std::pmr::memory_resource*)
      * @return Parsed configuration
      * @throws zpl_parse_error on parse errors
      * @throws std::ios_base::failure if any error during input reading occurs
      */
-    static zpl_config_t from_stream(std::istream& input);
+    static zpl_config_t from_stream(std::istream& input,
+                                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Parse and return a configuration from a file
      *
      * @param file_path Path to the ZPL file
+     * @param resource Memory resource of the tree, see zpl_config_t(std::pmr::memory_resource*)
      * @return Parsed configuration
      * @throws zpl_parse_error on parse errors
      * @throws std::ios_base::failure if the path is invalid or any error during file reading occurs
      */
-    static zpl_config_t from_file(const std::string& file_path);
+    static zpl_config_t from_file(const std::string& file_path,
+                                  std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Load configuration data from a stream
@@ -276,6 +297,12 @@ private:
      * @brief Pimpl for configuration storage
      */
     struct impl_t;
+
+    /**
+     * @brief Construct a configuration over a tree state
+     */
+    explicit zpl_config_t(std::shared_ptr<impl_t> impl) noexcept;
+
     std::shared_ptr<impl_t> _impl;  ///< Shared parsed-tree state
 };
 
@@ -43,13 +43,29 @@ SOFTWARE.
 
 #include "cppzmqzoltanext/helpers.h"
 #include "cppzmqzoltanext/signal.h"
+#include "cppzmqzoltanext/tracer.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#endif
 
 namespace zmqzext {
 
+struct actor_t::SharedUsageState {
+    std::mutex usage_mutex;
+    bool running{false};         ///< Whether the thread runs the actor function, so its CPU clock can be read
+    thread_usage_t final_usage;  ///< Usage sampled by the thread when the actor function returned
+#if defined(__linux__)
+    clockid_t cpu_clock{};  ///< CPU clock of the thread
+#endif
+};
+
 actor_t::actor_t(zmq::context_t& context)
     : _parent_socket(context, ZMQ_PAIR),
       _child_socket(std::make_unique<zmq::socket_t>(context, ZMQ_PAIR)),
       _exception_state(std::make_shared<SharedExceptionState>()),
+      _usage_state(std::make_shared<SharedUsageState>()),
       _started(false),
       _stopped(false) {
     std::string address = bind_to_unique_address();
@@ -62,9 +78,12 @@ actor_t& actor_t::operator=(actor_t&& other) noexcept {
     _parent_socket = std::move(other._parent_socket);
     _child_socket = std::move(other._child_socket);
     _exception_state = std::move(other._exception_state);
+    _usage_state = std::move(other._usage_state);
+    _pipe = std::move(other._pipe);
     _started = other._started;
     _stopped = other._stopped;
     _timeout_on_destructor = other._timeout_on_destructor;
+    _round_trip_histogram = other._round_trip_histogram;
 
     other._started = true;
     other._stopped = true;
@@ -83,9 +102,12 @@ void actor_t::start(actor_fn_t func) {
     if (_started) {
         throw std::runtime_error("Actor already started");
     }
+    CZZE_TRACE_SCOPE("actor.start");
 
-    std::thread thread([this, exception_state = _exception_state, func, socket = std::move(_child_socket)]() mutable {
-        this->execute(func, std::move(socket), exception_state);
+    auto const request_time = std::chrono::steady_clock::now();
+    std::thread thread([this, exception_state = _exception_state, usage_state = _usage_state, func,
+                        socket = std::move(_child_socket)]() mutable {
+        this->execute(func, std::move(socket), exception_state, usage_state);
     });
     thread.detach();  // Thread will run independently
 
@@ -95,6 +117,7 @@ void actor_t::start(actor_fn_t func) {
     if (recv_retry_on_eintr(_parent_socket, msg, zmq::recv_flags::none)) {  // blocking
         auto signal = signal_t::check_signal(msg);
         if (signal && signal->is_success()) {
+            record_round_trip(request_time);
             return;  // Success case
         }
         // Failure case - get exception if any
@@ -115,11 +138,32 @@ void actor_t::start(actor_fn_t func) {
     throw std::runtime_error("Failed to receive initialization signal");
 }
 
+void actor_t::start(actor_pipe_fn_t func, std::size_t pipe_capacity) {
+    if (_started) {
+        throw std::runtime_error("Actor already started");
+    }
+
+    auto endpoints = ring_pipe_t::create_pair(pipe_capacity);
+    auto child_pipe = std::make_shared<ring_pipe_t>(std::move(endpoints.second));
+    _pipe = std::make_unique<ring_pipe_t>(std::move(endpoints.first));
+
+    start([func, child_pipe](zmq::socket_t& socket) { return func(socket, *child_pipe); });
+}
+
+ring_pipe_t& actor_t::pipe() {
+    if (!_pipe) {
+        throw std::runtime_error("Actor has no ring pipe");
+    }
+    return *_pipe;
+}
+
 bool actor_t::stop(std::chrono::milliseconds timeout /* = std::chrono::milliseconds{-1}*/) {
     if (!_started || _stopped) {
         return true;
     }
+    CZZE_TRACE_SCOPE("actor.stop");
 
+    auto const request_time = std::chrono::steady_clock::now();
     auto msg_send = signal_t::create_stop();
     auto const result_send = send_retry_on_eintr(_parent_socket, msg_send, zmq::send_flags::dontwait);
     if (!result_send) {
@@ -143,6 +187,7 @@ bool actor_t::stop(std::chrono::milliseconds timeout /* = std::chrono::milliseco
             return false;
         }
         if (signal_t::check_signal(msg_recv)) {
+            record_round_trip(request_time);
             break;
         }
         if (confined_timeout.count() >= 0) {
@@ -157,14 +202,52 @@ bool actor_t::stop(std::chrono::milliseconds timeout /* = std::chrono::milliseco
     return true;
 }
 
+thread_usage_t actor_t::usage() const {
+    if (!_usage_state) {
+        return thread_usage_t{};
+    }
+    std::lock_guard<std::mutex> lock(_usage_state->usage_mutex);
+#if defined(__linux__)
+    if (_usage_state->running) {
+        // The thread cannot exit while the lock is held, so its clock is valid
+        thread_usage_t usage;
+        struct timespec time {};
+        if (::clock_gettime(_usage_state->cpu_clock, &time) == 0) {
+            usage.cpu_time = std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+        }
+        return usage;
+    }
+#endif
+    return _usage_state->final_usage;
+}
+
 void actor_t::execute(actor_fn_t func, std::unique_ptr<zmq::socket_t> socket,
-                      std::shared_ptr<SharedExceptionState> exception_state) noexcept {
+                      std::shared_ptr<SharedExceptionState> exception_state,
+                      std::shared_ptr<SharedUsageState> usage_state) noexcept {
+    {
+        std::lock_guard<std::mutex> lock(usage_state->usage_mutex);
+#if defined(__linux__)
+        usage_state->running = ::pthread_getcpuclockid(::pthread_self(), &usage_state->cpu_clock) == 0;
+#endif
+    }
+    // Sampled before the final signal, so the usage is complete once stop() returns
+    auto const finish_usage = [&usage_state]() {
+        std::lock_guard<std::mutex> lock(usage_state->usage_mutex);
+        usage_state->final_usage = current_thread_usage();
+        usage_state->running = false;
+    };
     try {
-        auto const success = func(*socket);
+        auto success = false;
+        {
+            CZZE_TRACE_SCOPE("actor.run");
+            success = func(*socket);
+        }
+        finish_usage();
 
         auto signal = success ? signal_t::create_success() : signal_t::create_failure();
         send_retry_on_eintr(*socket, signal, zmq::send_flags::none);  // blocking
     } catch (...) {
+        finish_usage();
         // Save exception to be rethrown in start() if needed
         {
             std::lock_guard<std::mutex> lock(_exception_state->exception_mutex);
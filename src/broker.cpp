@@ -0,0 +1,311 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file broker.cpp
+ * @brief Majordomo-style service broker running on an event loop
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/broker.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace zmqzext {
+
+namespace {
+
+/// Messages handled each time the socket is ready, so that timers are not starved under load
+constexpr std::size_t max_messages_per_wakeup = 256;
+
+bool frame_equals(zmq::message_t const& frame, char const* text, std::size_t size) noexcept {
+    return frame.size() == size && std::memcmp(frame.data(), text, size) == 0;
+}
+
+/// Index of the first empty frame at or after first, or the number of frames if there is none
+std::size_t find_delimiter(std::vector<zmq::message_t> const& frames, std::size_t first) noexcept {
+    while (first < frames.size() && frames[first].size() != 0) {
+        ++first;
+    }
+    return first;
+}
+
+}  // namespace
+
+broker_t::broker_t(zmq::context_t& context, loop_t& loop, broker_options_t options)
+    : _loop(loop), _options(options), _socket(context, zmq::socket_type::router) {
+    if (_options.heartbeat_interval <= std::chrono::milliseconds{0}) {
+        throw std::invalid_argument("Broker heartbeat interval must be positive");
+    }
+    if (_options.heartbeat_liveness == 0) {
+        throw std::invalid_argument("Broker heartbeat liveness must be positive");
+    }
+    if (_options.request_timeout <= std::chrono::milliseconds{0}) {
+        throw std::invalid_argument("Broker request timeout must be positive");
+    }
+    _socket.set(zmq::sockopt::linger, 0);
+    _loop.add(_socket, [this](loop_t&, zmq::socket_ref socket) { return on_message(socket); });
+    _heartbeat_timer =
+        _loop.add_timer(_options.heartbeat_interval, 0, [this](loop_t&, timer_id_t) { return on_heartbeat(); });
+}
+
+broker_t::~broker_t() noexcept {
+    _loop.remove_timer(_heartbeat_timer);
+    _loop.remove(_socket);
+}
+
+void broker_t::bind(std::string const& endpoint) { _socket.bind(endpoint); }
+
+std::size_t broker_t::waiting_workers(std::string const& service) const {
+    auto const service_it = _services.find(service);
+    return service_it != _services.end() ? service_it->second.waiting.size() : 0;
+}
+
+std::size_t broker_t::pending_requests(std::string const& service) const {
+    auto const service_it = _services.find(service);
+    return service_it != _services.end() ? service_it->second.requests.size() : 0;
+}
+
+bool broker_t::on_message(zmq::socket_ref socket) {
+    std::vector<zmq::message_t> frames;
+    for (std::size_t n = 0; n < max_messages_per_wakeup; ++n) {
+        frames.clear();
+        do {
+            frames.emplace_back();
+            if (!socket.recv(frames.back(), zmq::recv_flags::dontwait)) {
+                return true;
+            }
+        } while (frames.back().more());
+
+        // Frames before the first empty frame are the envelope, the routing identity of the peer first
+        auto const delimiter = find_delimiter(frames, 1);
+        if (delimiter + 1 >= frames.size()) {
+            continue;
+        }
+        auto const& header = frames[delimiter + 1];
+        if (frame_equals(header, mdp_client_header, sizeof(mdp_client_header) - 1)) {
+            on_client(frames, delimiter);
+        } else if (delimiter == 1 && frame_equals(header, mdp_worker_header, sizeof(mdp_worker_header) - 1)) {
+            on_worker(frames);
+        }
+    }
+    return true;
+}
+
+void broker_t::on_client(std::vector<zmq::message_t>& frames, std::size_t delimiter) {
+    if (delimiter + 2 >= frames.size()) {
+        return;
+    }
+    auto const& service_frame = frames[delimiter + 2];
+    _key.assign(service_frame.data<char>(), service_frame.size());
+    auto const service_it = _services.try_emplace(_key).first;
+    auto& service = service_it->second;
+    service.requests.push_back(std::move(frames));
+    _request_expiry.push_back(
+        {std::chrono::steady_clock::now() + _options.request_timeout, &service_it->first, service.queued++});
+    dispatch(service);
+}
+
+void broker_t::on_worker(std::vector<zmq::message_t>& frames) {
+    // [identity][empty][header][command][...]
+    if (frames.size() < 4 || frames[3].size() != 1) {
+        return;
+    }
+    _key.assign(frames[0].data<char>(), frames[0].size());
+    auto const worker_it = _workers.find(_key);
+    auto* const worker = worker_it != _workers.end() ? &worker_it->second : nullptr;
+
+    switch (static_cast<mdp_command_t>(*frames[3].data<std::uint8_t>())) {
+        case mdp_command_t::ready: {
+            if (worker != nullptr || frames.size() < 5) {
+                // Protocol error: a known worker cannot become ready again
+                disconnect(worker);
+                return;
+            }
+            auto& new_worker = _workers.emplace(_key, worker_t{}).first->second;
+            new_worker.identity = _key;
+            auto const service_it = _services.try_emplace(frames[4].to_string()).first;
+            new_worker.service_name = &service_it->first;
+            new_worker.service = &service_it->second;
+            ++new_worker.service->workers;
+            new_worker.expiry_position = _expiry.insert(_expiry.end(), &new_worker);
+            refresh(new_worker);
+            set_waiting(new_worker);
+            dispatch(*new_worker.service);
+            return;
+        }
+        case mdp_command_t::reply: {
+            auto const delimiter = find_delimiter(frames, 4);
+            if (worker == nullptr || worker->waiting || delimiter == 4 || delimiter >= frames.size()) {
+                disconnect(worker);
+                return;
+            }
+            // [client envelope...][empty][header][service][body...]
+            auto const flags = zmq::send_flags::dontwait | zmq::send_flags::sndmore;
+            for (std::size_t i = 4; i <= delimiter; ++i) {
+                _socket.send(frames[i], flags);
+            }
+            _socket.send(zmq::const_buffer(mdp_client_header, sizeof(mdp_client_header) - 1), flags);
+            auto const has_body = delimiter + 1 < frames.size();
+            _socket.send(zmq::buffer(*worker->service_name), has_body ? flags : zmq::send_flags::dontwait);
+            for (std::size_t i = delimiter + 1; i < frames.size(); ++i) {
+                _socket.send(frames[i], i + 1 < frames.size() ? flags : zmq::send_flags::dontwait);
+            }
+            refresh(*worker);
+            set_waiting(*worker);
+            dispatch(*worker->service);
+            return;
+        }
+        case mdp_command_t::heartbeat:
+            if (worker == nullptr) {
+                disconnect(worker);
+            } else {
+                refresh(*worker);
+            }
+            return;
+        case mdp_command_t::disconnect:
+            if (worker != nullptr) {
+                delete_worker(*worker, false);
+            }
+            return;
+        default:
+            return;
+    }
+}
+
+bool broker_t::on_heartbeat() {
+    auto const now = std::chrono::steady_clock::now();
+    // A busy worker expiring takes its request with it: the client retries it
+    while (!_expiry.empty() && _expiry.front()->expiry <= now) {
+        delete_worker(*_expiry.front(), false);
+    }
+    while (!_request_expiry.empty() && _request_expiry.front().expiry <= now) {
+        auto const entry = _request_expiry.front();
+        _request_expiry.pop_front();
+        auto& service = _services.find(*entry.service_name)->second;
+        // Requests are dequeued in order, so a request still queued is the first one of its service
+        if (entry.sequence >= service.dequeued) {
+            service.requests.pop_front();
+            ++service.dequeued;
+        }
+        ++service.expired;
+        delete_service_if_unused(*entry.service_name);
+    }
+    for (auto* worker : _expiry) {
+        send_command(worker->identity, mdp_command_t::heartbeat);
+    }
+    return true;
+}
+
+void broker_t::dispatch(service_t& service) {
+    while (!service.waiting.empty() && !service.requests.empty()) {
+        auto& worker = *service.waiting.front();
+        service.waiting.pop_front();
+        worker.waiting = false;
+        send_request(worker, service.requests.front());
+        service.requests.pop_front();
+        ++service.dequeued;
+    }
+}
+
+void broker_t::send_request(worker_t& worker, std::vector<zmq::message_t>& request) {
+    // Request as received: [client envelope...][empty][header][service][body...]
+    // Sent as: [worker][empty][header][REQUEST][client envelope...][empty][body...]
+    auto const flags = zmq::send_flags::dontwait | zmq::send_flags::sndmore;
+    auto const command = static_cast<std::uint8_t>(mdp_command_t::request);
+    _socket.send(zmq::buffer(worker.identity), flags);
+    _socket.send(zmq::message_t{}, flags);
+    _socket.send(zmq::const_buffer(mdp_worker_header, sizeof(mdp_worker_header) - 1), flags);
+    _socket.send(zmq::const_buffer(&command, sizeof(command)), flags);
+
+    auto const delimiter = find_delimiter(request, 1);
+    auto const body = delimiter + 3;
+    for (std::size_t i = 0; i < delimiter; ++i) {
+        _socket.send(request[i], flags);
+    }
+    _socket.send(request[delimiter], body < request.size() ? flags : zmq::send_flags::dontwait);
+    for (std::size_t i = body; i < request.size(); ++i) {
+        _socket.send(request[i], i + 1 < request.size() ? flags : zmq::send_flags::dontwait);
+    }
+}
+
+void broker_t::send_command(std::string const& identity, mdp_command_t command) {
+    auto const flags = zmq::send_flags::dontwait | zmq::send_flags::sndmore;
+    auto const command_byte = static_cast<std::uint8_t>(command);
+    _socket.send(zmq::buffer(identity), flags);
+    _socket.send(zmq::message_t{}, flags);
+    _socket.send(zmq::const_buffer(mdp_worker_header, sizeof(mdp_worker_header) - 1), flags);
+    _socket.send(zmq::const_buffer(&command_byte, sizeof(command_byte)), zmq::send_flags::dontwait);
+}
+
+void broker_t::refresh(worker_t& worker) {
+    // Any message refreshes the expiry, so the list of workers stays ordered by expiry
+    worker.expiry = std::chrono::steady_clock::now() +
+                    _options.heartbeat_interval * static_cast<std::chrono::milliseconds::rep>(_options.heartbeat_liveness);
+    _expiry.splice(_expiry.end(), _expiry, worker.expiry_position);
+}
+
+void broker_t::set_waiting(worker_t& worker) {
+    worker.waiting = true;
+    worker.service_position = worker.service->waiting.insert(worker.service->waiting.end(), &worker);
+}
+
+void broker_t::disconnect(worker_t* worker) {
+    if (worker != nullptr) {
+        delete_worker(*worker, true);
+    } else {
+        send_command(_key, mdp_command_t::disconnect);
+    }
+}
+
+void broker_t::delete_worker(worker_t& worker, bool disconnect) {
+    if (disconnect) {
+        send_command(worker.identity, mdp_command_t::disconnect);
+    }
+    if (worker.waiting) {
+        worker.service->waiting.erase(worker.service_position);
+    }
+    _expiry.erase(worker.expiry_position);
+    --worker.service->workers;
+    auto const* const service_name = worker.service_name;
+    _workers.erase(_workers.find(worker.identity));
+    delete_service_if_unused(*service_name);
+}
+
+void broker_t::delete_service_if_unused(std::string const& name) {
+    auto const service_it = _services.find(name);
+    // Every queued request has an expiry entry, so a service without them has no requests either
+    if (service_it->second.workers == 0 && service_it->second.expired == service_it->second.queued) {
+        _services.erase(service_it);
+    }
+}
+
+}  // namespace zmqzext
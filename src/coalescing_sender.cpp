@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file coalescing_sender.cpp
+ * @brief Coalescing of small records into batch messages, Nagle style
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/coalescing_sender.h"
+
+#include <stdexcept>
+
+namespace zmqzext {
+
+namespace {
+
+/// Maximum bytes of a LEB128 encoded size_t
+constexpr std::size_t max_varint_size = (sizeof(std::size_t) * 8 + 6) / 7;
+
+void append_varint(std::vector<char>& batch, std::size_t value) {
+    while (value >= 0x80) {
+        batch.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    batch.push_back(static_cast<char>(value));
+}
+
+}  // namespace
+
+coalescing_sender_t::coalescing_sender_t(loop_t& loop, zmq::socket_ref socket, coalescing_options_t options)
+    : _loop(loop), _socket(socket), _options(options) {
+    if (!_socket) {
+        throw std::invalid_argument("Cannot create a coalescing sender for a null socket");
+    }
+    if (_options.max_batch_size == 0) {
+        throw std::invalid_argument("Coalescing sender max_batch_size must be positive");
+    }
+    if (_options.flush_interval.count() < 0) {
+        throw std::invalid_argument("Coalescing sender flush_interval must not be negative");
+    }
+    _batch.reserve(_options.max_batch_size + max_varint_size);
+}
+
+coalescing_sender_t::~coalescing_sender_t() noexcept {
+    cancel_timer();
+    if (_writable_registered) {
+        _loop.remove_writable(_socket);
+    }
+    if (!_batch.empty()) {
+        try {
+            zmq::message_t msg{_batch.data(), _batch.size()};
+            _socket.send(msg, zmq::send_flags::dontwait);
+        } catch (...) {
+        }
+    }
+}
+
+bool coalescing_sender_t::send(zmq::const_buffer const& record) {
+    if (_writable_registered) {
+        if (_options.max_blocked_size != 0 && _batch.size() >= _options.max_blocked_size) {
+            return false;
+        }
+    } else if (!_batch.empty() && record.size() >= _options.max_batch_size) {
+        // A large record goes in a batch of its own, so flush the small ones first to keep the order
+        flush();
+    }
+    append_varint(_batch, record.size());
+    auto const* const data = static_cast<char const*>(record.data());
+    _batch.insert(_batch.end(), data, data + record.size());
+    ++_records;
+
+    if (_writable_registered) {
+        // Blocked: on_writable() sends the batch, retrying now would only copy the growing batch again
+        return true;
+    }
+    if (_batch.size() >= _options.max_batch_size) {
+        flush();
+    } else if (!_timer_armed) {
+        _timer = _loop.add_timer(_options.flush_interval, 1, [this](loop_t&, timer_id_t) { return on_timer(); });
+        _timer_armed = true;
+    }
+    return true;
+}
+
+bool coalescing_sender_t::flush() {
+    if (_batch.empty()) {
+        return true;
+    }
+    zmq::message_t msg{_batch.data(), _batch.size()};
+    if (!_socket.send(msg, zmq::send_flags::dontwait)) {
+        cancel_timer();
+        if (!_writable_registered) {
+            _loop.add_writable(_socket, [this](loop_t&, zmq::socket_ref) { return on_writable(); });
+            _writable_registered = true;
+        }
+        return false;
+    }
+    _batch.clear();
+    _records = 0;
+    cancel_timer();
+    return true;
+}
+
+bool coalescing_sender_t::on_timer() {
+    // The timer fired its only occurence and is removed by the loop
+    _timer_armed = false;
+    flush();
+    return true;
+}
+
+bool coalescing_sender_t::on_writable() {
+    if (flush()) {
+        _loop.remove_writable(_socket);
+        _writable_registered = false;
+    }
+    return true;
+}
+
+void coalescing_sender_t::cancel_timer() noexcept {
+    if (_timer_armed) {
+        _loop.remove_timer(_timer);
+        _timer_armed = false;
+    }
+}
+
+bool batch_reader_t::next(zmq::const_buffer& record) {
+    if (_position == _end) {
+        return false;
+    }
+    std::size_t size = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        if (_position == _end || shift >= sizeof(std::size_t) * 8) {
+            throw std::runtime_error("Malformed batch: truncated record size");
+        }
+        auto const byte = *_position++;
+        size |= static_cast<std::size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    if (size > static_cast<std::size_t>(_end - _position)) {
+        throw std::runtime_error("Malformed batch: truncated record");
+    }
+    record = zmq::const_buffer{_position, size};
+    _position += size;
+    return true;
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,277 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file event_recorder.cpp
+ * @brief Record and replay of the message and timer events of a loop_t
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "cppzmqzoltanext/event_recorder.h"
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace zmqzext {
+
+namespace {
+
+constexpr char k_magic[] = {'C', 'Z', 'Z', 'E', 'R', 'E', 'C', '1'};
+constexpr std::uint8_t k_kind_message = 1;
+constexpr std::uint8_t k_kind_timer = 2;
+constexpr std::size_t k_buffer_size = 64 * 1024;
+
+[[noreturn]] void throw_errno(char const* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+void write_varint(std::vector<char>& buffer, std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+/// Reader of the events of a recording, throwing std::runtime_error at truncated or invalid content
+class event_reader_t {
+public:
+    event_reader_t(char const* begin, char const* end) : _pos{begin}, _end{end} {}
+
+    bool at_end() const noexcept { return _pos == _end; }
+
+    std::uint8_t read_byte() {
+        if (_pos == _end) {
+            throw std::runtime_error("Truncated event recording");
+        }
+        return static_cast<std::uint8_t>(*_pos++);
+    }
+
+    std::uint64_t read_varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            auto const byte = read_byte();
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Invalid varint in event recording");
+    }
+
+    char const* read_bytes(std::uint64_t size) {
+        if (size > static_cast<std::uint64_t>(_end - _pos)) {
+            throw std::runtime_error("Truncated event recording");
+        }
+        auto const* bytes = _pos;
+        _pos += size;
+        return bytes;
+    }
+
+private:
+    char const* _pos;
+    char const* _end;
+};
+
+}  // namespace
+
+event_recorder_t::event_recorder_t(std::string const& path)
+    : _file{std::fopen(path.c_str(), "wb")}, _last_event{std::chrono::steady_clock::now()} {
+    if (!_file) {
+        throw_errno("Failed to create event recording");
+    }
+    _buffer.reserve(k_buffer_size);
+    _buffer.insert(_buffer.end(), std::begin(k_magic), std::end(k_magic));
+}
+
+event_recorder_t::~event_recorder_t() noexcept {
+    try {
+        flush();
+    } catch (...) {
+    }
+    std::fclose(_file);
+}
+
+void event_recorder_t::add(loop_t& loop, zmq::socket_ref socket, event_channel_t channel, fn_message_handler_t fn) {
+    // The frames are reused from one message to the next; std::function needs a copyable handler
+    auto frames = std::make_shared<std::vector<zmq::message_t>>();
+    loop.add(socket, [this, channel, fn = std::move(fn), frames](loop_t& loop_ref, zmq::socket_ref readable) {
+        std::size_t count = 0;
+        do {
+            if (count == frames->size()) {
+                frames->emplace_back();
+            }
+            if (!readable.recv((*frames)[count], zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            ++count;
+        } while ((*frames)[count - 1].more());
+        frames->resize(count);
+        record_message(channel, *frames);
+        return fn(loop_ref, channel, *frames);
+    });
+}
+
+timer_id_t event_recorder_t::add_timer(loop_t& loop, std::chrono::milliseconds timeout, std::size_t occurences,
+                                       event_channel_t channel, fn_timer_handler_t fn) {
+    return loop.add_timer(timeout, occurences,
+                          [this, channel, fn = std::move(fn)](loop_t& loop_ref, timer_id_t timer_id) {
+                              record_timer(channel, timer_id);
+                              return fn(loop_ref, timer_id);
+                          });
+}
+
+void event_recorder_t::flush() {
+    if (_buffer.empty()) {
+        return;
+    }
+    if (std::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size() || std::fflush(_file) != 0) {
+        throw_errno("Failed to write event recording");
+    }
+    _buffer.clear();
+}
+
+void event_recorder_t::record_timer(event_channel_t channel, timer_id_t timer_id) {
+    write_event_header(k_kind_timer, channel);
+    write_varint(_buffer, static_cast<std::uint64_t>(timer_id));
+    if (_buffer.size() >= k_buffer_size) {
+        flush();
+    }
+}
+
+void event_recorder_t::record_message(event_channel_t channel, std::vector<zmq::message_t> const& frames) {
+    write_event_header(k_kind_message, channel);
+    write_varint(_buffer, frames.size());
+    for (auto const& frame : frames) {
+        write_varint(_buffer, frame.size());
+        auto const* data = frame.data<char>();
+        _buffer.insert(_buffer.end(), data, data + frame.size());
+    }
+    if (_buffer.size() >= k_buffer_size) {
+        flush();
+    }
+}
+
+void event_recorder_t::write_event_header(std::uint8_t kind, event_channel_t channel) {
+    auto const now = std::chrono::steady_clock::now();
+    auto const delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _last_event);
+    _last_event = now;
+    ++_events;
+    _buffer.push_back(static_cast<char>(kind));
+    write_varint(_buffer, channel);
+    write_varint(_buffer, static_cast<std::uint64_t>(delta.count()));
+}
+
+event_replayer_t::event_replayer_t(std::string const& path) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{std::fopen(path.c_str(), "rb"), &std::fclose};
+    if (!file) {
+        throw_errno("Failed to open event recording");
+    }
+    char chunk[k_buffer_size];
+    std::size_t size = 0;
+    while ((size = std::fread(chunk, 1, sizeof(chunk), file.get())) > 0) {
+        _recording.insert(_recording.end(), chunk, chunk + size);
+    }
+    if (std::ferror(file.get())) {
+        throw_errno("Failed to read event recording");
+    }
+    if (_recording.size() < sizeof(k_magic) || std::memcmp(_recording.data(), k_magic, sizeof(k_magic)) != 0) {
+        throw std::runtime_error("Not an event recording");
+    }
+}
+
+void event_replayer_t::on_message(event_channel_t channel, fn_message_handler_t fn) {
+    _messages[channel] = std::move(fn);
+}
+
+void event_replayer_t::on_timer(event_channel_t channel, fn_timer_handler_t fn) { _timers[channel] = std::move(fn); }
+
+replay_stats_t event_replayer_t::replay(loop_t& loop, replay_speed_t speed) {
+    replay_stats_t stats;
+    event_reader_t reader{_recording.data() + sizeof(k_magic), _recording.data() + _recording.size()};
+    auto const start = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds offset{0};
+    bool proceed = true;
+    while (proceed && !reader.at_end()) {
+        auto const kind = reader.read_byte();
+        auto const channel = static_cast<event_channel_t>(reader.read_varint());
+        offset += std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(reader.read_varint())};
+
+        // The event is decoded before waiting for its time, so the wait absorbs the decoding
+        fn_message_handler_t const* message_handler = nullptr;
+        fn_timer_handler_t const* timer_handler = nullptr;
+        timer_id_t timer_id = 0;
+        if (kind == k_kind_message) {
+            auto const count = reader.read_varint();
+            auto const it = _messages.find(channel);
+            if (it != _messages.end()) {
+                message_handler = &it->second;
+                _frames.resize(0);
+            }
+            for (std::uint64_t i = 0; i < count; ++i) {
+                auto const size = reader.read_varint();
+                auto const* bytes = reader.read_bytes(size);
+                if (message_handler) {
+                    _frames.emplace_back(bytes, static_cast<std::size_t>(size));
+                }
+            }
+        } else if (kind == k_kind_timer) {
+            timer_id = static_cast<timer_id_t>(reader.read_varint());
+            auto const it = _timers.find(channel);
+            if (it != _timers.end()) {
+                timer_handler = &it->second;
+            }
+        } else {
+            throw std::runtime_error("Unknown event in event recording");
+        }
+
+        if (!message_handler && !timer_handler) {
+            ++stats.skipped;
+            continue;
+        }
+        if (speed == replay_speed_t::recorded) {
+            std::this_thread::sleep_until(start + offset);
+        }
+        if (message_handler) {
+            ++stats.messages;
+            proceed = (*message_handler)(loop, channel, _frames);
+        } else {
+            ++stats.timers;
+            proceed = (*timer_handler)(loop, timer_id);
+        }
+    }
+    stats.duration = std::chrono::steady_clock::now() - start;
+    return stats;
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,259 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file green_actor.cpp
+ * @brief Lightweight actors multiplexed on the thread of a loop_t
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/green_actor.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "mpsc_queue.h"
+#include "wakeup_fd.h"
+
+namespace zmqzext {
+
+namespace {
+
+/**
+ * @brief Message in the mailbox of a green actor
+ */
+struct message_node_t : detail::mpsc_node_t {
+    zmq::message_t msg;  ///< Message content
+};
+
+}  // namespace
+
+/**
+ * @brief State of a green actor, shared by its handle and its scheduler
+ *
+ * The state outlives its handle while it is in the queues of the scheduler.
+ */
+struct green_scheduler_t::state_t : detail::mpsc_node_t {
+    enum status_t : int { idle, running, stopped };
+
+    std::atomic<int> status{idle};       ///< Lifecycle status, read by the senders
+    std::atomic<bool> scheduled{false};  ///< Whether the actor is queued in its scheduler or running
+    bool released{false};                ///< Whether the handle was destroyed while the actor was scheduled
+    detail::mpsc_queue_t mailbox;        ///< Pending messages
+    green_actor_fn_t handler;            ///< Message handler
+    green_actor_t* owner{nullptr};       ///< Handle of the actor, passed to the handler
+
+    ~state_t() { discard_messages(); }
+
+    void discard_messages() noexcept {
+        while (auto* const node = mailbox.pop()) {
+            delete static_cast<message_node_t*>(node);
+        }
+    }
+};
+
+green_scheduler_t::green_scheduler_t(loop_t& loop, green_scheduler_options_t options)
+    : _loop(loop), _options(options) {
+    if (_options.batch_size == 0) {
+        throw std::invalid_argument("Green scheduler batch_size must be positive");
+    }
+    if (_options.max_messages_per_wakeup == 0) {
+        throw std::invalid_argument("Green scheduler max_messages_per_wakeup must be positive");
+    }
+    _wakeup = std::make_unique<detail::wakeup_fd_t>();
+    _ready = std::make_unique<detail::mpsc_queue_t>();
+    _loop.add_fd(_wakeup->fd(), [this](loop_t&, zmq::fd_t) { return run(); });
+}
+
+green_scheduler_t::~green_scheduler_t() noexcept {
+    _loop.remove_fd(_wakeup->fd());
+    // Only the states of destroyed actors waiting for their turn are left, the live actors must be destroyed first
+    while (auto* const node = _ready->pop()) {
+        _run_queue.push_back(static_cast<state_t*>(node));
+    }
+    for (auto* const state : _run_queue) {
+        if (state->released) {
+            delete state;
+        }
+    }
+}
+
+void green_scheduler_t::schedule(state_t* state) noexcept {
+    _ready->push(state);
+    if (!_signaled.exchange(true)) {
+        _wakeup->signal();
+    }
+}
+
+void green_scheduler_t::release(state_t* state) noexcept {
+    state->status.store(state_t::stopped);
+    state->discard_messages();
+    state->owner = nullptr;
+    --_actors;
+    if (state->scheduled.load()) {
+        state->released = true;
+    } else {
+        delete state;
+    }
+}
+
+bool green_scheduler_t::run() {
+    // Clear before resetting the flag: a sender that finds it reset signals again, so no wake-up is lost
+    _wakeup->clear();
+    _signaled.exchange(false);
+    while (auto* const node = _ready->pop()) {
+        _run_queue.push_back(static_cast<state_t*>(node));
+    }
+
+    auto budget = _options.max_messages_per_wakeup;
+    while (budget > 0 && !_run_queue.empty()) {
+        auto* const state = _run_queue.front();
+        _run_queue.pop_front();
+        budget -= std::min(budget, run_turn(state, std::min(budget, _options.batch_size)));
+    }
+
+    // Yield to the other handlers of the loop and come back for the actors still ready
+    if ((!_run_queue.empty() || !_ready->empty()) && !_signaled.exchange(true)) {
+        _wakeup->signal();
+    }
+    return true;
+}
+
+std::size_t green_scheduler_t::run_turn(state_t* state, std::size_t limit) {
+    std::size_t handled = 0;
+    while (handled < limit && !state->released && state->status.load(std::memory_order_relaxed) == state_t::running) {
+        std::unique_ptr<message_node_t> node{static_cast<message_node_t*>(state->mailbox.pop())};
+        if (!node) {
+            break;
+        }
+        ++handled;
+        auto keep_running = false;
+        try {
+            keep_running = state->handler(*state->owner, node->msg);
+        } catch (...) {
+            // As an unhandled exception ends the thread of an actor_t, it stops the green actor
+        }
+        if (!keep_running && !state->released && state->owner != nullptr) {
+            state->owner->stop();
+        }
+    }
+    _handled_messages += handled;
+
+    if (state->released) {
+        // The handle was destroyed while the actor was scheduled, possibly by its own handler
+        delete state;
+    } else if (state->status.load(std::memory_order_relaxed) != state_t::running) {
+        state->discard_messages();
+        state->scheduled.store(false);
+    } else if (!state->mailbox.empty()) {
+        _run_queue.push_back(state);
+    } else {
+        state->scheduled.store(false);
+        // A message sent since the mailbox was found empty may have seen the actor still scheduled
+        if (!state->mailbox.empty() && !state->scheduled.exchange(true)) {
+            _run_queue.push_back(state);
+        }
+    }
+    // A turn without message still costs one unit, so that a turn waiting for a push in progress cannot spin
+    return std::max<std::size_t>(handled, 1);
+}
+
+green_actor_t::green_actor_t(green_scheduler_t& scheduler)
+    : _scheduler(&scheduler), _state(new green_scheduler_t::state_t) {
+    _state->owner = this;
+    ++_scheduler->_actors;
+}
+
+green_actor_t::green_actor_t(green_actor_t&& other) noexcept
+    : _scheduler(std::exchange(other._scheduler, nullptr)), _state(std::exchange(other._state, nullptr)) {
+    if (_state != nullptr) {
+        _state->owner = this;
+    }
+}
+
+green_actor_t& green_actor_t::operator=(green_actor_t&& other) noexcept {
+    if (this != &other) {
+        if (_state != nullptr) {
+            _scheduler->release(_state);
+        }
+        _scheduler = std::exchange(other._scheduler, nullptr);
+        _state = std::exchange(other._state, nullptr);
+        if (_state != nullptr) {
+            _state->owner = this;
+        }
+    }
+    return *this;
+}
+
+green_actor_t::~green_actor_t() noexcept {
+    if (_state != nullptr) {
+        _scheduler->release(_state);
+    }
+}
+
+void green_actor_t::start(green_actor_fn_t fn) {
+    if (_state == nullptr || _state->status.load() != green_scheduler_t::state_t::idle) {
+        throw std::runtime_error("Green actor already started");
+    }
+    _state->handler = std::move(fn);
+    _state->status.store(green_scheduler_t::state_t::running);
+}
+
+void green_actor_t::stop() noexcept {
+    if (_state == nullptr || _state->status.load() != green_scheduler_t::state_t::running) {
+        return;
+    }
+    _state->status.store(green_scheduler_t::state_t::stopped);
+    _state->discard_messages();
+}
+
+bool green_actor_t::send(zmq::message_t&& msg) {
+    auto* const state = _state;
+    if (state == nullptr || state->status.load(std::memory_order_acquire) != green_scheduler_t::state_t::running) {
+        return false;
+    }
+    auto node = std::make_unique<message_node_t>();
+    node->msg = std::move(msg);
+    state->mailbox.push(node.release());
+    if (!state->scheduled.exchange(true)) {
+        _scheduler->schedule(state);
+    }
+    return true;
+}
+
+bool green_actor_t::is_started() const noexcept {
+    return _state == nullptr || _state->status.load() != green_scheduler_t::state_t::idle;
+}
+
+bool green_actor_t::is_stopped() const noexcept {
+    return _state == nullptr || _state->status.load() == green_scheduler_t::state_t::stopped;
+}
+
+}  // namespace zmqzext
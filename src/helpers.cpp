@@ -37,6 +37,8 @@ SOFTWARE.
 
 #include <cerrno>
 
+#include "cppzmqzoltanext/ring_pipe.h"
+
 namespace zmqzext {
 
 template <typename T>
@@ -139,4 +141,11 @@ template CZZE_EXPORT zmq::recv_buffer_result_t recv_retry_on_eintr<zmq::socket_r
 template CZZE_EXPORT zmq::recv_result_t recv_retry_on_eintr<zmq::socket_ref>(
     zmq::socket_ref& socket, zmq::message_t& msg, zmq::recv_flags flags = zmq::recv_flags::none);
 
+template CZZE_EXPORT zmq::send_result_t send_retry_on_eintr<ring_pipe_t>(
+    ring_pipe_t& socket, zmq::const_buffer const& buf, zmq::send_flags flags = zmq::send_flags::none);
+template CZZE_EXPORT zmq::recv_buffer_result_t recv_retry_on_eintr<ring_pipe_t>(
+    ring_pipe_t& socket, zmq::mutable_buffer const& buf, zmq::recv_flags flags = zmq::recv_flags::none);
+template CZZE_EXPORT zmq::recv_result_t recv_retry_on_eintr<ring_pipe_t>(
+    ring_pipe_t& socket, zmq::message_t& msg, zmq::recv_flags flags = zmq::recv_flags::none);
+
 }  // namespace zmqzext
@@ -0,0 +1,686 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file journal.cpp
+ * @brief Durable memory-mapped message journal
+ *
+ * Segment layout: a segment header in the first k_records_offset bytes, then
+ * records aligned to 8 bytes, each made of a record_header_t and the frame
+ * content. A record is valid when its segment index, sequence and CRC match, so
+ * stale records left in a recycled segment, or records torn by a crash, end the
+ * recovery scan.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/journal.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(WIN32)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace zmqzext {
+
+#if !defined(WIN32)
+
+namespace {
+
+constexpr std::uint64_t k_segment_magic = 0x31474553455a5a43;  // "CZZESEG1"
+constexpr std::uint64_t k_meta_magic = 0x3141544d455a5a43;     // "CZZEMTA1"
+constexpr std::size_t k_records_offset = 64;
+constexpr std::uint32_t k_flag_valid = 1u << 0;
+constexpr std::uint32_t k_flag_more = 1u << 1;
+constexpr char const* k_meta_file = "journal.meta";
+constexpr char const* k_segment_suffix = ".seg";
+constexpr char const* k_spare_suffix = ".spare";
+
+struct segment_header_t {
+    std::uint64_t magic;
+    std::uint64_t segment_size;
+};
+
+struct record_header_t {
+    std::uint32_t size;
+    std::uint32_t flags;
+    std::uint64_t sequence;
+    std::uint64_t segment_index;
+    std::uint32_t crc;
+    std::uint32_t reserved;
+};
+
+struct meta_t {
+    std::uint64_t magic;
+    std::uint64_t acked_sequence;
+};
+
+static_assert(sizeof(segment_header_t) <= k_records_offset, "Segment header must fit before the records");
+static_assert(sizeof(record_header_t) % 8 == 0, "Record header must keep records aligned");
+
+constexpr std::size_t align8(std::size_t size) noexcept { return (size + 7) & ~std::size_t{7}; }
+
+constexpr std::size_t record_size(std::size_t data_size) noexcept {
+    return sizeof(record_header_t) + align8(data_size);
+}
+
+std::array<std::uint32_t, 256> make_crc32_table() noexcept {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        auto c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+std::uint32_t crc32_update(std::uint32_t crc, void const* data, std::size_t size) noexcept {
+    static auto const table = make_crc32_table();
+    auto const* bytes = static_cast<unsigned char const*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/// CRC32 of the record header fields before the CRC and of the frame content
+std::uint32_t record_crc(record_header_t const& header, void const* data) noexcept {
+    auto crc = crc32_update(0xffffffffu, &header, offsetof(record_header_t, crc));
+    crc = crc32_update(crc, data, header.size);
+    return crc ^ 0xffffffffu;
+}
+
+[[noreturn]] void throw_errno(char const* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+/// Parse "<index><suffix>" file names
+bool parse_file_name(std::string const& name, char const* suffix, std::uint64_t& index) {
+    auto const suffix_size = std::strlen(suffix);
+    if (name.size() <= suffix_size || name.compare(name.size() - suffix_size, suffix_size, suffix) != 0) {
+        return false;
+    }
+    auto const digits = name.substr(0, name.size() - suffix_size);
+    if (digits.find_first_not_of("0123456789") != std::string::npos || digits.size() > 19) {
+        return false;
+    }
+    index = std::stoull(digits);
+    return true;
+}
+
+}  // namespace
+
+struct journal_t::impl_t {
+    struct segment_t {
+        std::uint64_t index{0};                      ///< File index, never reused by another segment
+        int fd{-1};                                  ///< Segment file
+        char* base{nullptr};                         ///< Mapping of the whole file
+        std::size_t write_offset{k_records_offset};  ///< End of the last record
+        journal_sequence_t last_sequence{0};         ///< Sequence of the last record, 0 if none
+        std::size_t dirty_begin{0};                  ///< Start of the range not flushed yet
+        std::size_t dirty_end{0};                    ///< End of the range not flushed yet, dirty_begin if none
+    };
+
+    struct cursor_t {
+        std::uint64_t segment_index{0};        ///< File index of the segment being read
+        std::size_t offset{k_records_offset};  ///< Offset of the next record in the segment
+    };
+
+    impl_t(std::string const& directory, journal_options_t const& options);
+    ~impl_t() noexcept;
+
+    void open();
+    std::string path(std::uint64_t index, char const* suffix) const;
+    segment_t open_segment(std::uint64_t index, char const* suffix, bool create);
+    void close_segment(segment_t& segment) noexcept;
+    void scan_segment(segment_t& segment, journal_sequence_t& expected) const;
+    void add_segment();
+    void retire_segment(segment_t segment);
+    void recycle_acked_segments();
+    record_header_t const* next_record(cursor_t& cursor) const noexcept;
+    void write_meta();
+    void sync_directory();
+
+    journal_sequence_t append(zmq::const_buffer const& data, bool more);
+    bool read(journal_entry_t& entry) noexcept;
+    void rewind() noexcept;
+    void ack(journal_sequence_t sequence);
+    void sync();
+
+    std::string _directory;                           ///< Journal directory
+    std::size_t _segment_size;                        ///< Size of each segment file
+    std::size_t _max_spare_segments;                  ///< Spare segments kept for reuse
+    bool _durable;                                    ///< Whether commits flush to disk
+    int _directory_fd{-1};                            ///< Directory, to make file creations and renames durable
+    int _meta_fd{-1};                                 ///< Persisted acknowledgement
+    std::deque<segment_t> _segments;                  ///< Segments in use, the last one being written
+    std::vector<segment_t> _spares;                   ///< Recycled segments ready for reuse
+    std::uint64_t _next_index{0};                     ///< File index of the next segment
+    cursor_t _cursor;                                 ///< Position of the next record to read
+    journal_sequence_t _next_sequence{1};             ///< Sequence of the next appended record
+    journal_sequence_t _acked_sequence{0};            ///< Last acknowledged sequence
+    journal_sequence_t _persisted_acked_sequence{0};  ///< Last acknowledged sequence on disk
+    journal_sequence_t _durable_sequence{0};          ///< Last committed sequence
+    journal_sequence_t _cursor_sequence{1};           ///< Sequence of the next record to read
+    bool _directory_dirty{false};                     ///< Files created or renamed since the last commit
+    fn_journal_commit_t _commit_handler;              ///< Called after each commit that made records durable
+};
+
+journal_t::impl_t::impl_t(std::string const& directory, journal_options_t const& options)
+    : _directory(directory), _max_spare_segments(options.max_spare_segments), _durable(options.durable) {
+    if (options.segment_size < k_records_offset + record_size(1)) {
+        throw std::invalid_argument("Journal segment size is too small");
+    }
+    auto const page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    _segment_size = (options.segment_size + page_size - 1) / page_size * page_size;
+}
+
+journal_t::impl_t::~impl_t() noexcept {
+    for (auto& segment : _segments) {
+        close_segment(segment);
+    }
+    for (auto& spare : _spares) {
+        close_segment(spare);
+    }
+    if (_meta_fd >= 0) {
+        ::close(_meta_fd);
+    }
+    if (_directory_fd >= 0) {
+        ::close(_directory_fd);
+    }
+}
+
+void journal_t::impl_t::open() {
+    if (::mkdir(_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw_errno("Failed to create journal directory");
+    }
+    _directory_fd = ::open(_directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (_directory_fd < 0) {
+        throw_errno("Failed to open journal directory");
+    }
+
+    _meta_fd = ::open((_directory + "/" + k_meta_file).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (_meta_fd < 0) {
+        throw_errno("Failed to open journal meta file");
+    }
+    meta_t meta{};
+    auto const meta_size = ::pread(_meta_fd, &meta, sizeof(meta), 0);
+    if (meta_size < 0) {
+        throw_errno("Failed to read journal meta file");
+    }
+    if (meta_size != 0) {
+        if (meta_size != static_cast<ssize_t>(sizeof(meta)) || meta.magic != k_meta_magic) {
+            throw std::runtime_error("Invalid journal meta file");
+        }
+        _acked_sequence = meta.acked_sequence;
+        _persisted_acked_sequence = meta.acked_sequence;
+    }
+
+    std::vector<std::uint64_t> segment_indexes;
+    std::vector<std::uint64_t> spare_indexes;
+    auto* dir = ::opendir(_directory.c_str());
+    if (dir == nullptr) {
+        throw_errno("Failed to list journal directory");
+    }
+    while (auto const* entry = ::readdir(dir)) {
+        std::uint64_t index;
+        std::string const name = entry->d_name;
+        if (parse_file_name(name, k_segment_suffix, index)) {
+            segment_indexes.push_back(index);
+        } else if (parse_file_name(name, k_spare_suffix, index)) {
+            spare_indexes.push_back(index);
+        } else {
+            continue;
+        }
+        _next_index = std::max(_next_index, index + 1);
+    }
+    ::closedir(dir);
+    std::sort(segment_indexes.begin(), segment_indexes.end());
+
+    for (auto const index : spare_indexes) {
+        if (_spares.size() < _max_spare_segments) {
+            _spares.push_back(open_segment(index, k_spare_suffix, false));
+        } else {
+            ::unlink(path(index, k_spare_suffix).c_str());
+            _directory_dirty = true;
+        }
+    }
+
+    // Recover the chain of consecutive valid records; the segments after its end hold no
+    // committed record and are recycled
+    journal_sequence_t expected = 0;
+    bool chain_ended = false;
+    for (auto const index : segment_indexes) {
+        auto segment = open_segment(index, k_segment_suffix, false);
+        if (!chain_ended) {
+            // A missing segment file breaks the chain, the cursor walks segments by consecutive indexes
+            chain_ended = !_segments.empty() && index != _segments.back().index + 1;
+        }
+        if (!chain_ended) {
+            scan_segment(segment, expected);
+            chain_ended = segment.last_sequence == 0;
+        }
+        if (chain_ended) {
+            retire_segment(segment);
+        } else {
+            _segments.push_back(segment);
+        }
+    }
+    if (!_segments.empty()) {
+        // The retired trailing segments, such as one added just before a crash and never flushed,
+        // must not leave a gap in the indexes of the next segments
+        _next_index = _segments.back().index + 1;
+    }
+    if (expected != 0) {
+        _next_sequence = expected;
+    }
+    _next_sequence = std::max(_next_sequence, _acked_sequence + 1);
+    _durable_sequence = _next_sequence - 1;
+
+    // Clear what follows the chain in the last segment, so that a stale record of this segment
+    // cannot be taken for the continuation of the records appended from now on
+    if (!_segments.empty()) {
+        auto& tail = _segments.back();
+        auto const* next = reinterpret_cast<record_header_t const*>(tail.base + tail.write_offset);
+        if (tail.write_offset + sizeof(record_header_t) <= _segment_size && next->flags != 0) {
+            std::memset(tail.base + tail.write_offset, 0, _segment_size - tail.write_offset);
+            if (::msync(tail.base, _segment_size, MS_SYNC) != 0) {
+                throw_errno("Failed to flush journal segment");
+            }
+        }
+    }
+
+    recycle_acked_segments();
+    if (_segments.empty()) {
+        add_segment();
+    }
+    if (_directory_dirty) {
+        sync_directory();
+    }
+    rewind();
+}
+
+std::string journal_t::impl_t::path(std::uint64_t index, char const* suffix) const {
+    return _directory + "/" + std::to_string(index) + suffix;
+}
+
+journal_t::impl_t::segment_t journal_t::impl_t::open_segment(std::uint64_t index, char const* suffix, bool create) {
+    auto const file_path = path(index, suffix);
+    segment_t segment;
+    segment.index = index;
+    segment.fd = ::open(file_path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0644);
+    if (segment.fd < 0) {
+        throw_errno("Failed to open journal segment");
+    }
+    try {
+        if (create) {
+            if (::ftruncate(segment.fd, static_cast<off_t>(_segment_size)) != 0) {
+                throw_errno("Failed to size journal segment");
+            }
+        } else {
+            struct stat st;
+            if (::fstat(segment.fd, &st) != 0) {
+                throw_errno("Failed to stat journal segment");
+            }
+            if (static_cast<std::size_t>(st.st_size) != _segment_size) {
+                throw std::invalid_argument("Journal segment size differs from the existing journal one");
+            }
+        }
+        auto* base = ::mmap(nullptr, _segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if (base == MAP_FAILED) {
+            throw_errno("Failed to map journal segment");
+        }
+        segment.base = static_cast<char*>(base);
+    } catch (...) {
+        ::close(segment.fd);
+        if (create) {
+            ::unlink(file_path.c_str());
+        }
+        throw;
+    }
+
+    // A header never flushed reads as zeros; the segment then holds no valid record either
+    auto const* header = reinterpret_cast<segment_header_t const*>(segment.base);
+    if (!create && header->magic != 0 && (header->magic != k_segment_magic || header->segment_size != _segment_size)) {
+        close_segment(segment);
+        throw std::runtime_error("Invalid journal segment");
+    }
+    return segment;
+}
+
+void journal_t::impl_t::close_segment(segment_t& segment) noexcept {
+    if (segment.base != nullptr) {
+        ::munmap(segment.base, _segment_size);
+        segment.base = nullptr;
+    }
+    if (segment.fd >= 0) {
+        ::close(segment.fd);
+        segment.fd = -1;
+    }
+}
+
+void journal_t::impl_t::scan_segment(segment_t& segment, journal_sequence_t& expected) const {
+    auto offset = k_records_offset;
+    while (offset + sizeof(record_header_t) <= _segment_size) {
+        auto const* header = reinterpret_cast<record_header_t const*>(segment.base + offset);
+        if ((header->flags & k_flag_valid) == 0 || header->segment_index != segment.index ||
+            header->size > _segment_size - offset - sizeof(record_header_t) ||
+            (expected == 0 ? header->sequence == 0 : header->sequence != expected) ||
+            header->crc != record_crc(*header, header + 1)) {
+            break;
+        }
+        segment.last_sequence = header->sequence;
+        expected = header->sequence + 1;
+        offset += record_size(header->size);
+    }
+    segment.write_offset = offset;
+}
+
+void journal_t::impl_t::add_segment() {
+    segment_t segment;
+    if (_spares.empty()) {
+        segment = open_segment(_next_index, k_segment_suffix, true);
+    } else {
+        if (::rename(path(_spares.back().index, k_spare_suffix).c_str(), path(_next_index, k_segment_suffix).c_str()) !=
+            0) {
+            throw_errno("Failed to reuse journal segment");
+        }
+        segment = _spares.back();
+        _spares.pop_back();
+        segment.index = _next_index;
+        segment.write_offset = k_records_offset;
+        segment.last_sequence = 0;
+    }
+    ++_next_index;
+    _directory_dirty = true;
+
+    segment_header_t const header{k_segment_magic, _segment_size};
+    std::memcpy(segment.base, &header, sizeof(header));
+    segment.dirty_begin = 0;
+    segment.dirty_end = sizeof(header);
+    _segments.push_back(segment);
+}
+
+void journal_t::impl_t::retire_segment(segment_t segment) {
+    _directory_dirty = true;
+    if (_spares.size() >= _max_spare_segments) {
+        close_segment(segment);
+        ::unlink(path(segment.index, k_segment_suffix).c_str());
+        return;
+    }
+    if (::rename(path(segment.index, k_segment_suffix).c_str(), path(segment.index, k_spare_suffix).c_str()) != 0) {
+        auto const error = errno;
+        close_segment(segment);
+        throw std::system_error(error, std::generic_category(), "Failed to recycle journal segment");
+    }
+    segment.dirty_begin = segment.dirty_end = 0;
+    _spares.push_back(segment);
+}
+
+void journal_t::impl_t::recycle_acked_segments() {
+    while (_segments.size() > 1 && _segments.front().last_sequence <= _persisted_acked_sequence) {
+        auto const segment = _segments.front();
+        _segments.pop_front();
+        retire_segment(segment);
+    }
+    if (_cursor.segment_index < _segments.front().index) {
+        _cursor = cursor_t{_segments.front().index, k_records_offset};
+    }
+}
+
+record_header_t const* journal_t::impl_t::next_record(cursor_t& cursor) const noexcept {
+    while (true) {
+        auto const position = static_cast<std::size_t>(cursor.segment_index - _segments.front().index);
+        auto const& segment = _segments[position];
+        if (cursor.offset < segment.write_offset) {
+            auto const* header = reinterpret_cast<record_header_t const*>(segment.base + cursor.offset);
+            cursor.offset += record_size(header->size);
+            return header;
+        }
+        if (position + 1 == _segments.size()) {
+            return nullptr;
+        }
+        cursor = cursor_t{_segments[position + 1].index, k_records_offset};
+    }
+}
+
+void journal_t::impl_t::write_meta() {
+    meta_t const meta{k_meta_magic, _acked_sequence};
+    if (::pwrite(_meta_fd, &meta, sizeof(meta), 0) != static_cast<ssize_t>(sizeof(meta))) {
+        throw_errno("Failed to write journal meta file");
+    }
+    if (::fdatasync(_meta_fd) != 0) {
+        throw_errno("Failed to flush journal meta file");
+    }
+}
+
+void journal_t::impl_t::sync_directory() {
+    if (::fsync(_directory_fd) != 0) {
+        throw_errno("Failed to flush journal directory");
+    }
+    _directory_dirty = false;
+}
+
+journal_sequence_t journal_t::impl_t::append(zmq::const_buffer const& data, bool more) {
+    auto const size = record_size(data.size());
+    if (data.size() > UINT32_MAX || size > _segment_size - k_records_offset) {
+        throw std::invalid_argument("Journal frame does not fit in a segment");
+    }
+    if (_segments.back().write_offset + size > _segment_size) {
+        add_segment();
+    }
+    auto& segment = _segments.back();
+    auto const offset = segment.write_offset;
+
+    record_header_t header{static_cast<std::uint32_t>(data.size()), k_flag_valid | (more ? k_flag_more : 0u),
+                           _next_sequence, segment.index, 0, 0};
+    header.crc = record_crc(header, data.data());
+    std::memcpy(segment.base + offset + sizeof(header), data.data(), data.size());
+    std::memcpy(segment.base + offset, &header, sizeof(header));
+
+    if (segment.dirty_end == segment.dirty_begin) {
+        segment.dirty_begin = offset;
+    }
+    segment.dirty_end = offset + size;
+    segment.write_offset = offset + size;
+    segment.last_sequence = _next_sequence;
+    return _next_sequence++;
+}
+
+bool journal_t::impl_t::read(journal_entry_t& entry) noexcept {
+    auto const* header = next_record(_cursor);
+    if (header == nullptr) {
+        return false;
+    }
+    entry.sequence = header->sequence;
+    entry.data = zmq::const_buffer(header + 1, header->size);
+    entry.more = (header->flags & k_flag_more) != 0;
+    _cursor_sequence = header->sequence + 1;
+    return true;
+}
+
+void journal_t::impl_t::rewind() noexcept {
+    // Whole segments are skipped by their last sequence, then records one by one
+    auto it = _segments.begin();
+    while (std::next(it) != _segments.end() && it->last_sequence <= _acked_sequence) {
+        ++it;
+    }
+    _cursor = cursor_t{it->index, k_records_offset};
+    while (true) {
+        auto next = _cursor;
+        auto const* header = next_record(next);
+        if (header == nullptr || header->sequence > _acked_sequence) {
+            _cursor_sequence = header == nullptr ? _next_sequence : header->sequence;
+            return;
+        }
+        _cursor = next;
+    }
+}
+
+void journal_t::impl_t::ack(journal_sequence_t sequence) {
+    if (sequence >= _next_sequence) {
+        throw std::invalid_argument("Journal sequence was not appended");
+    }
+    if (sequence <= _acked_sequence) {
+        return;
+    }
+    _acked_sequence = sequence;
+    if (_cursor_sequence <= sequence) {
+        rewind();
+    }
+}
+
+void journal_t::impl_t::sync() {
+    // Flush the whole pages covering the records appended since the last commit, one msync per segment
+    auto const page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    for (auto& segment : _segments) {
+        if (segment.dirty_end == segment.dirty_begin) {
+            continue;
+        }
+        auto const begin = segment.dirty_begin / page_size * page_size;
+        if (_durable && ::msync(segment.base + begin, segment.dirty_end - begin, MS_SYNC) != 0) {
+            throw_errno("Failed to flush journal segment");
+        }
+        segment.dirty_begin = segment.dirty_end = 0;
+    }
+    if (_durable && _directory_dirty) {
+        sync_directory();
+    }
+    auto const previous_durable_sequence = _durable_sequence;
+    _durable_sequence = _next_sequence - 1;
+
+    if (_persisted_acked_sequence != _acked_sequence) {
+        if (_durable) {
+            write_meta();
+        }
+        _persisted_acked_sequence = _acked_sequence;
+        recycle_acked_segments();
+        if (_durable && _directory_dirty) {
+            sync_directory();
+        }
+    }
+
+    if (_durable_sequence != previous_durable_sequence && _commit_handler) {
+        _commit_handler(_durable_sequence);
+    }
+}
+
+journal_t::journal_t(std::string const& directory, journal_options_t const& options)
+    : _impl(std::make_unique<impl_t>(directory, options)) {
+    _impl->open();
+}
+
+journal_t::~journal_t() noexcept = default;
+
+journal_sequence_t journal_t::append(zmq::const_buffer const& data, bool more) { return _impl->append(data, more); }
+
+bool journal_t::read(journal_entry_t& entry) { return _impl->read(entry); }
+
+void journal_t::rewind() { _impl->rewind(); }
+
+void journal_t::ack(journal_sequence_t sequence) { _impl->ack(sequence); }
+
+void journal_t::sync() { _impl->sync(); }
+
+void journal_t::set_commit_handler(fn_journal_commit_t fn) { _impl->_commit_handler = std::move(fn); }
+
+bool journal_t::has_pending_commit() const noexcept {
+    return _impl->_durable_sequence + 1 != _impl->_next_sequence ||
+           _impl->_persisted_acked_sequence != _impl->_acked_sequence;
+}
+
+journal_sequence_t journal_t::next_sequence() const noexcept { return _impl->_next_sequence; }
+
+journal_sequence_t journal_t::acked_sequence() const noexcept { return _impl->_acked_sequence; }
+
+journal_sequence_t journal_t::durable_sequence() const noexcept { return _impl->_durable_sequence; }
+
+std::size_t journal_t::segment_count() const noexcept { return _impl->_segments.size(); }
+
+std::size_t journal_t::spare_segment_count() const noexcept { return _impl->_spares.size(); }
+
+#else
+
+struct journal_t::impl_t {};
+
+journal_t::journal_t(std::string const&, journal_options_t const&) {
+    throw std::runtime_error("Journals are not supported on this platform");
+}
+
+journal_t::~journal_t() noexcept = default;
+
+journal_sequence_t journal_t::append(zmq::const_buffer const&, bool) { return 0; }
+
+bool journal_t::read(journal_entry_t&) { return false; }
+
+void journal_t::rewind() {}
+
+void journal_t::ack(journal_sequence_t) {}
+
+void journal_t::sync() {}
+
+void journal_t::set_commit_handler(fn_journal_commit_t) {}
+
+bool journal_t::has_pending_commit() const noexcept { return false; }
+
+journal_sequence_t journal_t::next_sequence() const noexcept { return 0; }
+
+journal_sequence_t journal_t::acked_sequence() const noexcept { return 0; }
+
+journal_sequence_t journal_t::durable_sequence() const noexcept { return 0; }
+
+std::size_t journal_t::segment_count() const noexcept { return 0; }
+
+std::size_t journal_t::spare_segment_count() const noexcept { return 0; }
+
+#endif
+
+timer_id_t journal_t::add_commit_timer(loop_t& loop, std::chrono::milliseconds interval) {
+    return loop.add_timer(interval, 0, [this](loop_t&, timer_id_t) {
+        if (has_pending_commit()) {
+            sync();
+        }
+        return true;
+    });
+}
+
+}  // namespace zmqzext
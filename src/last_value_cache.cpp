@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file last_value_cache.cpp
+ * @brief Last value cache proxy serving snapshots to pub/sub late joiners
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/last_value_cache.h"
+
+#include <cstring>
+
+namespace zmqzext {
+
+namespace {
+
+/// Messages handled each time a socket is ready, so that the other handlers are not starved under load
+constexpr std::size_t max_messages_per_wakeup = 256;
+
+zmq::send_flags frame_flags(std::size_t index, std::size_t count) noexcept {
+    return index + 1 < count ? zmq::send_flags::dontwait | zmq::send_flags::sndmore : zmq::send_flags::dontwait;
+}
+
+}  // namespace
+
+last_value_cache_t::last_value_cache_t(zmq::context_t& context, loop_t& loop)
+    : _loop(loop), _frontend(context, zmq::socket_type::xsub), _backend(context, zmq::socket_type::xpub) {
+    _frontend.set(zmq::sockopt::linger, 0);
+    _backend.set(zmq::sockopt::linger, 0);
+    // Report every subscription, not only the first one to a prefix, so that each new subscriber gets its snapshot
+    _backend.set(zmq::sockopt::xpub_verbose, true);
+    _loop.add(_frontend, [this](loop_t&, zmq::socket_ref socket) { return on_message(socket); });
+    _loop.add(_backend, [this](loop_t&, zmq::socket_ref socket) { return on_subscription(socket); });
+}
+
+last_value_cache_t::~last_value_cache_t() noexcept {
+    _loop.remove(_frontend);
+    _loop.remove(_backend);
+}
+
+bool last_value_cache_t::on_message(zmq::socket_ref socket) {
+    for (std::size_t n = 0; n < max_messages_per_wakeup; ++n) {
+        _frames.clear();
+        do {
+            _frames.emplace_back();
+            if (!socket.recv(_frames.back(), zmq::recv_flags::dontwait)) {
+                return true;
+            }
+        } while (_frames.back().more());
+
+        _key.assign(_frames.front().data<char>(), _frames.front().size());
+        auto& cached = _cache[_key];
+        cached.resize(_frames.size());
+        for (std::size_t i = 0; i < _frames.size(); ++i) {
+            cached[i].copy(_frames[i]);
+            _backend.send(_frames[i], frame_flags(i, _frames.size()));
+        }
+    }
+    return true;
+}
+
+bool last_value_cache_t::on_subscription(zmq::socket_ref socket) {
+    for (std::size_t n = 0; n < max_messages_per_wakeup; ++n) {
+        zmq::message_t msg;
+        if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+            return true;
+        }
+        if (msg.more() || msg.size() == 0) {
+            // Not a subscription: discard the rest of the message
+            while (msg.more() && socket.recv(msg, zmq::recv_flags::dontwait)) {
+            }
+            continue;
+        }
+        auto const* const data = msg.data<char>();
+        auto const subscribe = data[0] == 1;
+        if (subscribe) {
+            send_snapshot(data + 1, msg.size() - 1);
+        }
+        if (subscribe || data[0] == 0) {
+            _frontend.send(msg, zmq::send_flags::dontwait);
+        }
+    }
+    return true;
+}
+
+void last_value_cache_t::send_snapshot(char const* prefix, std::size_t size) {
+    for (auto& entry : _cache) {
+        auto const& topic = entry.first;
+        if (topic.size() < size || std::memcmp(topic.data(), prefix, size) != 0) {
+            continue;
+        }
+        auto& frames = entry.second;
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            zmq::message_t frame;
+            frame.copy(frames[i]);
+            _backend.send(frame, frame_flags(i, frames.size()));
+        }
+    }
+}
+
+}  // namespace zmqzext
@@ -36,10 +36,30 @@ SOFTWARE.
 #include "cppzmqzoltanext/loop.h"
 
 #include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "cppzmqzoltanext/interrupt.h"
+#include "cppzmqzoltanext/metrics.h"
+#include "cppzmqzoltanext/tracer.h"
 
 namespace zmqzext {
 
+namespace {
+
+void count_event(counter_t* counter) noexcept {
+    if (counter != nullptr) {
+        counter->add();
+    }
+}
+
+}  // namespace
+
 void loop_t::add(zmq::socket_ref socket, fn_socket_handler_t fn) {
+    if (_draining) {
+        throw std::runtime_error("Cannot add a socket to a draining loop");
+    }
     _poller.add(socket);
     try {
         _socket_handlers.emplace(socket, fn);
@@ -49,15 +69,86 @@ void loop_t::add(zmq::socket_ref socket, fn_socket_handler_t fn) {
     }
 }
 
+void loop_t::add(zmq::socket_ref socket, fn_socket_handler_t fn, rate_limit_t const& limit) {
+    if (!(limit.messages_per_second >= 0) || !(limit.bytes_per_second >= 0) || !(limit.message_burst >= 0) ||
+        !(limit.byte_burst >= 0)) {
+        throw std::invalid_argument("Rate limits and bursts must not be negative");
+    }
+    add(socket, std::move(fn));
+    if (limit.messages_per_second == 0 && limit.bytes_per_second == 0) {
+        return;
+    }
+    auto bucket = rate_bucket_t{limit, 0, 0, now(), false, false};
+    if (bucket.limit.message_burst == 0) {
+        bucket.limit.message_burst = std::max(1.0, limit.messages_per_second);
+    }
+    if (bucket.limit.byte_burst == 0) {
+        bucket.limit.byte_burst = std::max(1.0, limit.bytes_per_second);
+    }
+    bucket.messages = bucket.limit.message_burst;
+    bucket.bytes = bucket.limit.byte_burst;
+    try {
+        _rate_buckets.emplace(socket, bucket);
+    } catch (...) {
+        remove(socket);
+        throw;
+    }
+}
+
+void loop_t::charge(zmq::socket_ref socket, std::size_t messages, std::size_t bytes) {
+    auto const bucket_it = _rate_buckets.find(socket);
+    if (bucket_it == _rate_buckets.end()) {
+        return;
+    }
+    bucket_it->second.messages -= static_cast<double>(messages);
+    bucket_it->second.bytes -= static_cast<double>(bytes);
+    bucket_it->second.charged = true;
+}
+
+bool loop_t::paused(zmq::socket_ref socket) const {
+    auto const bucket_it = _rate_buckets.find(socket);
+    return bucket_it != _rate_buckets.end() && bucket_it->second.paused;
+}
+
+void loop_t::add_fd(zmq::fd_t fd, fn_fd_handler_t fn) {
+    if (_draining) {
+        throw std::runtime_error("Cannot add a file descriptor to a draining loop");
+    }
+    _poller.add_fd(fd);
+    try {
+        _fd_handlers.emplace(fd, fn);
+    } catch (...) {
+        _poller.remove_fd(fd);
+        throw;
+    }
+}
+
+void loop_t::add_writable(zmq::socket_ref socket, fn_socket_handler_t fn) {
+    _poller.add_writable(socket);
+    try {
+        _writable_handlers.emplace(socket, fn);
+    } catch (...) {
+        _poller.remove_writable(socket);
+        throw;
+    }
+}
+
 timer_id_t loop_t::add_timer(std::chrono::milliseconds timeout, std::size_t occurences, fn_timer_handler_t fn) {
     auto const timer_id = generate_unique_timer_id();
     auto const next_occurence = now() + timeout;
-    _timer_handlers.push_back(timer_t{timer_id, timeout, occurences, next_occurence, fn, false});
+    _timer_handlers.push_back(timer_t{timer_id, timeout, occurences, next_occurence, fn, false, false});
     return timer_id;
 }
 
 void loop_t::remove(zmq::socket_ref socket) {
     _poller.remove(socket);
+    auto const is_paused = [](auto const& entry) { return entry.second.paused; };
+    if (_rate_buckets.erase(socket) != 0 && _rate_timer_armed &&
+        std::none_of(_rate_buckets.begin(), _rate_buckets.end(), is_paused)) {
+        // No socket left to resume, so that the timer does not keep the loop running
+        remove_timer(_rate_timer_id);
+        _rate_timer_armed = false;
+    }
     auto const socket_handler_it = _socket_handlers.find(socket);
     if (socket_handler_it == _socket_handlers.end()) {
         return;
@@ -65,41 +156,125 @@ void loop_t::remove(zmq::socket_ref socket) {
     _socket_handlers.erase(socket_handler_it);
 }
 
+void loop_t::remove_fd(zmq::fd_t fd) {
+    _poller.remove_fd(fd);
+    _fd_handlers.erase(fd);
+}
+
+void loop_t::remove_writable(zmq::socket_ref socket) {
+    _poller.remove_writable(socket);
+    _writable_handlers.erase(socket);
+}
+
 void loop_t::remove_timer(timer_id_t timer_id) {
-    auto timer_it = std::find_if(_timer_handlers.begin(), _timer_handlers.end(),
-                                 [timer_id](timer_t const& timer) { return timer.id == timer_id; });
+    auto timer_it = _timer_handlers.find(timer_id);
     if (timer_it == _timer_handlers.end()) {
         return;
     }
     timer_it->removed = true;
 }
 
+bool loop_t::reset_timer(timer_id_t timer_id) {
+    auto timer_it = _timer_handlers.find(timer_id);
+    if (timer_it == _timer_handlers.end() || timer_it->removed) {
+        return false;
+    }
+    timer_it->next_occurence = now() + timer_it->timeout;
+    timer_it->rearmed = true;
+    return true;
+}
+
+bool loop_t::reschedule_timer(timer_id_t timer_id, std::chrono::milliseconds timeout) {
+    auto timer_it = _timer_handlers.find(timer_id);
+    if (timer_it == _timer_handlers.end() || timer_it->removed) {
+        return false;
+    }
+    timer_it->timeout = timeout;
+    timer_it->next_occurence = now() + timeout;
+    timer_it->rearmed = true;
+    return true;
+}
+
 void loop_t::run(bool interruptible /* = true*/,
                  std::chrono::milliseconds interruptCheckInterval /* = std::chrono::milliseconds{-1}*/) {
     _poller.set_interruptible(interruptible);
     _interruptCheckInterval = interruptCheckInterval;
+    _draining = false;
+    _drained = false;
+    time_point_t drain_end{};
+    // Leave the drain mode however the run ends, handlers may throw
+    struct drain_guard_t {
+        bool& draining;
+        ~drain_guard_t() { draining = false; }
+    } const drain_guard{_draining};
+    // Account the thread usage of the run however it ends
+    struct accounting_guard_t {
+        loop_t& loop;
+        ~accounting_guard_t() { loop.finish_accounted_run(); }
+    } const accounting_guard{*this};
+    if (_accounting) {
+        _run_start_usage = current_thread_usage();
+        _accounted_run = true;
+    }
     auto should_continue = true;
     while (should_continue) {
         removeFlagedTimers();
         if (_poller.size() == 0 && _timer_handlers.size() == 0) {
-            return;
+            break;
         }
         auto const initial_time = now();
-        auto const next_timeout = find_next_timeout(initial_time);
-        auto sockets_ready = _poller.wait_all(next_timeout);
+        auto const next_timeout = _draining ? time_milliseconds_t{0} : find_next_timeout(initial_time);
+        {
+            CZZE_TRACE_SCOPE("loop.poll");
+            _poller.wait_ready(next_timeout);
+        }
+        auto const& sockets_ready = _poller.ready_sockets();
         if (_poller.terminated()) {
-            return;
+            if (!_draining && _drain_deadline > time_milliseconds_t{0} && interruptible && is_interrupted()) {
+                // Interrupted: from now on poll without waiting, ignoring the interrupt, until idle or the deadline
+                _draining = true;
+                drain_end = now() + _drain_deadline;
+                _poller.set_interruptible(false);
+                continue;
+            }
+            break;
         }
         auto const current_time = now();
+        if (_draining) {
+            if (current_time >= drain_end || (sockets_ready.empty() && _poller.writable_sockets().empty() &&
+                                              _poller.ready_fds().empty() && !has_expired_timer(current_time))) {
+                _drained = true;
+                break;
+            }
+        }
+        count_event(_iterations_counter);
+        if (_accounting) {
+            ++_usage.wakeups;
+            if (sockets_ready.empty() && _poller.writable_sockets().empty() && _poller.ready_fds().empty() &&
+                !has_expired_timer(current_time)) {
+                ++_usage.empty_wakeups;
+            }
+        }
         for (auto timer_it = _timer_handlers.begin(); timer_it != _timer_handlers.end();) {
             if (timer_it->removed == false && current_time >= timer_it->next_occurence) {
-                should_continue = timer_it->handler(*this, timer_it->id);
+                count_event(_timer_events_counter);
+                if (_timer_lateness_histogram != nullptr) {
+                    _timer_lateness_histogram->record(current_time - timer_it->next_occurence);
+                }
+                timer_it->rearmed = false;
+                {
+                    CZZE_TRACE_SCOPE("loop.timer");
+                    should_continue = call_handler([&]() { return timer_it->handler(*this, timer_it->id); });
+                }
                 if (!should_continue) {
                     break;
                 }
                 if (timer_it->occurences > 0 && --timer_it->occurences == 0) {
                     timer_it = _timer_handlers.erase(timer_it);
                     continue;
+                } else if (timer_it->rearmed) {
+                    // Re-armed by its handler, the next occurence is already set
+                    timer_it->rearmed = false;
                 } else {
                     timer_it->next_occurence += timer_it->timeout;
                 }
@@ -109,25 +284,97 @@ void loop_t::run(bool interruptible /* = true*/,
         if (!should_continue) {
             break;
         }
-        for (auto& socket : sockets_ready) {
+        for (auto const& socket : sockets_ready) {
             auto const socket_handler_it = _socket_handlers.find(socket);
             if (socket_handler_it != _socket_handlers.end()) {
-                should_continue = socket_handler_it->second(*this, socket_handler_it->first);
+                count_event(_socket_events_counter);
+                {
+                    CZZE_TRACE_SCOPE("loop.socket");
+                    should_continue = call_handler(
+                        [&]() { return socket_handler_it->second(*this, socket_handler_it->first); });
+                }
+                if (!_rate_buckets.empty()) {
+                    charge_handler_call(socket);
+                }
                 if (!should_continue) {
                     break;
                 }
             }
         }
+        if (!should_continue) {
+            break;
+        }
+        for (auto const& socket : _poller.writable_sockets()) {
+            auto const writable_handler_it = _writable_handlers.find(socket);
+            if (writable_handler_it != _writable_handlers.end()) {
+                count_event(_socket_events_counter);
+                {
+                    CZZE_TRACE_SCOPE("loop.writable");
+                    should_continue = call_handler(
+                        [&]() { return writable_handler_it->second(*this, writable_handler_it->first); });
+                }
+                if (!should_continue) {
+                    break;
+                }
+            }
+        }
+        if (!should_continue) {
+            break;
+        }
+        for (auto const fd : _poller.ready_fds()) {
+            auto const fd_handler_it = _fd_handlers.find(fd);
+            if (fd_handler_it != _fd_handlers.end()) {
+                count_event(_fd_events_counter);
+                {
+                    CZZE_TRACE_SCOPE("loop.fd");
+                    should_continue = call_handler([&]() { return fd_handler_it->second(*this, fd); });
+                }
+                if (!should_continue) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+loop_usage_t loop_t::usage() const noexcept {
+    auto usage = _usage;
+    if (_accounted_run) {
+        usage.thread += current_thread_usage() - _run_start_usage;
     }
+    return usage;
+}
+
+void loop_t::reset_usage() noexcept {
+    _usage = loop_usage_t{};
+    if (_accounted_run) {
+        _run_start_usage = current_thread_usage();
+    }
+}
+
+void loop_t::finish_accounted_run() noexcept {
+    if (_accounted_run) {
+        _usage.thread += current_thread_usage() - _run_start_usage;
+        _accounted_run = false;
+    }
+}
+
+void loop_t::set_metrics(metrics_registry_t& registry, std::string const& prefix) {
+    _iterations_counter = &registry.counter(prefix + ".iterations");
+    _timer_events_counter = &registry.counter(prefix + ".timer_events");
+    _socket_events_counter = &registry.counter(prefix + ".socket_events");
+    _fd_events_counter = &registry.counter(prefix + ".fd_events");
+    _handler_histogram = &registry.histogram(prefix + ".handler_ns");
+    _timer_lateness_histogram = &registry.histogram(prefix + ".timer_lateness_ns");
 }
 
 loop_t::time_point_t loop_t::now() { return std::chrono::steady_clock::now(); }
 
 loop_t::time_milliseconds_t loop_t::find_next_timeout(time_point_t const& actual_time) {
     auto const next_expiring_timer_it =
-        std::min_element(_timer_handlers.cbegin(), _timer_handlers.cend(),
+        std::min_element(_timer_handlers.begin(), _timer_handlers.end(),
                          [](timer_t const& a, timer_t const& b) { return a.next_occurence < b.next_occurence; });
-    if (next_expiring_timer_it == _timer_handlers.cend()) {
+    if (next_expiring_timer_it == _timer_handlers.end()) {
         if (_interruptCheckInterval > time_milliseconds_t{0}) {
             return _interruptCheckInterval;
         }
@@ -141,7 +388,7 @@ loop_t::time_milliseconds_t loop_t::find_next_timeout(time_point_t const& actual
 }
 
 void loop_t::removeFlagedTimers() {
-    _timer_handlers.remove_if([](timer_t const& timer) { return timer.removed; });
+    _timer_handlers.remove_flagged();
 }
 
 timer_id_t loop_t::generate_unique_timer_id() {
@@ -151,8 +398,7 @@ timer_id_t loop_t::generate_unique_timer_id() {
         timer_id = ++_last_timer_id;
     }
     if (_timer_id_has_overflowed) {
-        while (std::any_of(_timer_handlers.begin(), _timer_handlers.end(),
-                           [timer_id](auto const& t) { return t.id == timer_id; })) {
+        while (_timer_handlers.contains(timer_id)) {
             timer_id = ++_last_timer_id;
             if (_last_timer_id == 0) {
                 throw std::runtime_error("Unable to generate unique timer ID: all IDs are in use.");
@@ -162,4 +408,137 @@ timer_id_t loop_t::generate_unique_timer_id() {
     return timer_id;
 }
 
+bool loop_t::has_expired_timer(time_point_t const& current_time) const {
+    return std::any_of(_timer_handlers.begin(), _timer_handlers.end(), [&current_time](timer_t const& timer) {
+        return !timer.removed && current_time >= timer.next_occurence;
+    });
+}
+
+loop_t::timer_list_t::timer_list_t(timer_list_t const& other) : _timers(other._timers) { rebuild_index(); }
+
+loop_t::timer_list_t& loop_t::timer_list_t::operator=(timer_list_t const& other) {
+    if (this != &other) {
+        _timers = other._timers;
+        rebuild_index();
+    }
+    return *this;
+}
+
+loop_t::timer_list_t& loop_t::timer_list_t::operator=(timer_list_t&& other) {
+    if (this != &other) {
+        // With different memory resources the timers are moved one by one, invalidating the index
+        _timers = std::move(other._timers);
+        rebuild_index();
+        other._timers.clear();
+        other._index.clear();
+    }
+    return *this;
+}
+
+void loop_t::timer_list_t::push_back(timer_t timer) {
+    auto const timer_id = timer.id;
+    _timers.push_back(std::move(timer));
+    try {
+        _index.emplace(timer_id, std::prev(_timers.end()));
+    } catch (...) {
+        _timers.pop_back();
+        throw;
+    }
+}
+
+loop_t::timer_list_t::iterator loop_t::timer_list_t::erase(iterator timer_it) {
+    _index.erase(timer_it->id);
+    return _timers.erase(timer_it);
+}
+
+void loop_t::timer_list_t::remove_flagged() {
+    for (auto timer_it = _timers.begin(); timer_it != _timers.end();) {
+        timer_it = timer_it->removed ? erase(timer_it) : std::next(timer_it);
+    }
+}
+
+loop_t::timer_list_t::iterator loop_t::timer_list_t::find(timer_id_t timer_id) {
+    auto const index_it = _index.find(timer_id);
+    return index_it == _index.end() ? _timers.end() : index_it->second;
+}
+
+void loop_t::timer_list_t::rebuild_index() {
+    _index.clear();
+    for (auto timer_it = _timers.begin(); timer_it != _timers.end(); ++timer_it) {
+        _index.emplace(timer_it->id, timer_it);
+    }
+}
+
+void loop_t::charge_handler_call(zmq::socket_ref socket) {
+    auto const bucket_it = _rate_buckets.find(socket);
+    if (bucket_it == _rate_buckets.end()) {
+        return;
+    }
+    auto& bucket = bucket_it->second;
+    if (!bucket.charged) {
+        bucket.messages -= 1;
+    }
+    bucket.charged = false;
+    auto const delay = refill(bucket, now());
+    if (delay > time_milliseconds_t{0}) {
+        _poller.remove(socket);
+        bucket.paused = true;
+        arm_rate_timer(delay);
+    }
+}
+
+void loop_t::arm_rate_timer(time_milliseconds_t delay) {
+    auto const expiry = now() + delay;
+    if (_rate_timer_armed) {
+        if (_rate_timer_expiry <= expiry) {
+            return;
+        }
+        remove_timer(_rate_timer_id);
+    }
+    // The handler goes through its loop argument, so that copies of the loop resume their own sockets
+    _rate_timer_id = add_timer(delay, 1, [](loop_t& loop, timer_id_t) { return loop.resume_rate_limited(); });
+    _rate_timer_armed = true;
+    _rate_timer_expiry = expiry;
+}
+
+bool loop_t::resume_rate_limited() {
+    _rate_timer_armed = false;
+    auto const current_time = now();
+    auto next_delay = time_milliseconds_t::max();
+    for (auto& entry : _rate_buckets) {
+        auto& bucket = entry.second;
+        if (!bucket.paused) {
+            continue;
+        }
+        auto const delay = refill(bucket, current_time);
+        if (delay > time_milliseconds_t{0}) {
+            next_delay = std::min(next_delay, delay);
+        } else {
+            _poller.add(entry.first);
+            bucket.paused = false;
+        }
+    }
+    if (next_delay != time_milliseconds_t::max()) {
+        arm_rate_timer(next_delay);
+    }
+    return true;
+}
+
+loop_t::time_milliseconds_t loop_t::refill(rate_bucket_t& bucket, time_point_t const& current_time) {
+    auto const elapsed = std::chrono::duration<double>(current_time - bucket.last_refill).count();
+    bucket.last_refill = current_time;
+    auto const& limit = bucket.limit;
+    bucket.messages = std::min(limit.message_burst, bucket.messages + elapsed * limit.messages_per_second);
+    bucket.bytes = std::min(limit.byte_burst, bucket.bytes + elapsed * limit.bytes_per_second);
+    // Time until both buckets hold at least one token
+    auto seconds = 0.0;
+    if (limit.messages_per_second > 0 && bucket.messages < 1) {
+        seconds = (1 - bucket.messages) / limit.messages_per_second;
+    }
+    if (limit.bytes_per_second > 0 && bucket.bytes < 1) {
+        seconds = std::max(seconds, (1 - bucket.bytes) / limit.bytes_per_second);
+    }
+    return std::chrono::ceil<time_milliseconds_t>(std::chrono::duration<double>(seconds));
+}
+
 }  // namespace zmqzext
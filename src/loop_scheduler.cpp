@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file loop_scheduler.cpp
+ * @brief Queue of the schedule() operations of loop_scheduler_t
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/loop_scheduler.h"
+
+#include "mpsc_queue.h"
+#include "wakeup_fd.h"
+
+namespace zmqzext {
+namespace detail {
+
+namespace {
+
+/// Posts completed each time the queue is woken up, so that the other loop handlers are not starved
+constexpr std::size_t max_posts_per_wakeup = 256;
+
+}  // namespace
+
+struct loop_post_queue_t::post_t : mpsc_node_t {
+    callback_t callback;  ///< Function completing the operation, nullptr once cancelled
+    void* operation;      ///< Operation completed
+};
+
+loop_post_queue_t::loop_post_queue_t(loop_t& loop)
+    : _loop(loop), _wakeup(std::make_unique<wakeup_fd_t>()), _posts(std::make_unique<mpsc_queue_t>()) {
+    _loop.add_fd(_wakeup->fd(), [this](loop_t&, zmq::fd_t) { return run(); });
+}
+
+loop_post_queue_t::~loop_post_queue_t() noexcept {
+    _loop.remove_fd(_wakeup->fd());
+    while (auto* const node = _posts->pop()) {
+        delete static_cast<post_t*>(node);
+    }
+}
+
+loop_post_queue_t::post_t* loop_post_queue_t::make_post(callback_t callback, void* operation) {
+    auto* const post = new post_t{};
+    post->callback = callback;
+    post->operation = operation;
+    return post;
+}
+
+void loop_post_queue_t::push(post_t* post) noexcept {
+    _posts->push(post);
+    if (!_signaled.exchange(true)) {
+        _wakeup->signal();
+    }
+}
+
+void loop_post_queue_t::cancel(post_t* post) noexcept { post->callback = nullptr; }
+
+bool loop_post_queue_t::run() {
+    // Clear before resetting the flag: a producer that finds it reset signals again, so no wake-up is lost
+    _wakeup->clear();
+    _signaled.exchange(false);
+    try {
+        for (std::size_t n = 0; n < max_posts_per_wakeup; ++n) {
+            std::unique_ptr<post_t> post{static_cast<post_t*>(_posts->pop())};
+            if (!post) {
+                break;
+            }
+            if (post->callback != nullptr) {
+                post->callback(post->operation);
+            }
+        }
+    } catch (...) {
+        // The receiver threw: come back for the posts left once the exception is handled
+        if (!_posts->empty() && !_signaled.exchange(true)) {
+            _wakeup->signal();
+        }
+        throw;
+    }
+    // Yield to the other handlers of the loop and come back for the posts left
+    if (!_posts->empty() && !_signaled.exchange(true)) {
+        _wakeup->signal();
+    }
+    return true;
+}
+
+}  // namespace detail
+}  // namespace zmqzext
@@ -0,0 +1,186 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file metrics.cpp
+ * @brief Metrics registry and publisher actor
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/metrics.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "cppzmqzoltanext/helpers.h"
+#include "cppzmqzoltanext/loop.h"
+#include "cppzmqzoltanext/signal.h"
+
+namespace zmqzext {
+
+namespace {
+
+void write_escaped_name(std::ostream& os, std::string const& name) {
+    for (auto const c : name) {
+        if (c == ' ' || c == ',' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+}
+
+}  // namespace
+
+void write_metrics_lines(std::ostream& os, metrics_snapshot_t const& snapshot) {
+    auto const timestamp =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(snapshot.time.time_since_epoch()).count();
+    for (auto const& [name, value] : snapshot.counters) {
+        write_escaped_name(os, name);
+        os << " value=" << value << "i " << timestamp << '\n';
+    }
+    for (auto const& [name, histogram] : snapshot.histograms) {
+        write_escaped_name(os, name);
+        os << " count=" << histogram.count() << "i,min=" << histogram.min()
+           << "i,p50=" << histogram.value_at_percentile(50.0) << "i,p90=" << histogram.value_at_percentile(90.0)
+           << "i,p99=" << histogram.value_at_percentile(99.0) << "i,p999=" << histogram.value_at_percentile(99.9)
+           << "i,max=" << histogram.max() << "i,mean=" << histogram.mean() << ' ' << timestamp << '\n';
+    }
+}
+
+counter_t& metrics_registry_t::counter(std::string const& name) {
+    if (name.empty()) {
+        throw std::invalid_argument("Metric name cannot be empty");
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_histograms.count(name) != 0) {
+        throw std::invalid_argument("Metric name already used by a histogram: " + name);
+    }
+    auto& counter = _counters[name];
+    if (!counter) {
+        counter = std::make_unique<counter_t>();
+    }
+    return *counter;
+}
+
+histogram_t& metrics_registry_t::histogram(std::string const& name) {
+    if (name.empty()) {
+        throw std::invalid_argument("Metric name cannot be empty");
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_counters.count(name) != 0) {
+        throw std::invalid_argument("Metric name already used by a counter: " + name);
+    }
+    auto& histogram = _histograms[name];
+    if (!histogram) {
+        histogram = std::make_unique<histogram_t>();
+    }
+    return *histogram;
+}
+
+metrics_snapshot_t metrics_registry_t::snapshot(bool reset_histograms) {
+    metrics_snapshot_t result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.time = std::chrono::system_clock::now();
+    result.counters.reserve(_counters.size());
+    for (auto const& [name, counter] : _counters) {
+        result.counters.emplace_back(name, counter->value());
+    }
+    result.histograms.reserve(_histograms.size());
+    for (auto const& [name, histogram] : _histograms) {
+        result.histograms.emplace_back(name, reset_histograms ? histogram->snapshot_and_reset() : histogram->snapshot());
+    }
+    return result;
+}
+
+metrics_publisher_t::metrics_publisher_t(zmq::context_t& context, metrics_registry_t& registry,
+                                         metrics_publisher_options_t options)
+    : _context(context), _registry(registry), _options(std::move(options)), _actor(context) {
+    if (_options.interval <= std::chrono::milliseconds{0}) {
+        throw std::invalid_argument("Metrics interval must be positive");
+    }
+    if (_options.endpoint.empty() && _options.file_path.empty()) {
+        throw std::invalid_argument("Metrics publisher needs an endpoint or a file path");
+    }
+}
+
+void metrics_publisher_t::start() {
+    _actor.start([this](zmq::socket_t& pipe) { return run(pipe); });
+}
+
+bool metrics_publisher_t::stop(std::chrono::milliseconds timeout /* = std::chrono::milliseconds{-1}*/) {
+    return _actor.stop(timeout);
+}
+
+bool metrics_publisher_t::run(zmq::socket_t& pipe) {
+    std::unique_ptr<zmq::socket_t> publisher;
+    if (!_options.endpoint.empty()) {
+        publisher = std::make_unique<zmq::socket_t>(_context, zmq::socket_type::pub);
+        publisher->set(zmq::sockopt::linger, 0);
+        publisher->bind(_options.endpoint);
+    }
+    std::ofstream file;
+    if (!_options.file_path.empty()) {
+        file.open(_options.file_path, std::ios::out | std::ios::app);
+        if (!file) {
+            throw std::runtime_error("Unable to open metrics file: " + _options.file_path);
+        }
+    }
+
+    loop_t loop;
+    loop.add(pipe, [](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        auto const result = recv_retry_on_eintr(socket, msg, zmq::recv_flags::dontwait);
+        if (!result) {
+            return true;
+        }
+        auto const signal = signal_t::check_signal(msg);
+        return !(signal && signal->is_stop());
+    });
+    loop.add_timer(_options.interval, 0, [this, &publisher, &file](loop_t&, timer_id_t) {
+        std::ostringstream lines;
+        write_metrics_lines(lines, _registry.snapshot(_options.reset_histograms));
+        auto const payload = lines.str();
+        if (publisher) {
+            send_retry_on_eintr(*publisher, zmq::buffer(_options.topic), zmq::send_flags::sndmore);
+            send_retry_on_eintr(*publisher, zmq::buffer(payload), zmq::send_flags::dontwait);
+        }
+        if (file.is_open()) {
+            file << payload;
+            file.flush();
+        }
+        return true;
+    });
+
+    send_retry_on_eintr(pipe, signal_t::create_success());
+    loop.run(false);
+    return true;
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file mpsc_queue.h
+ * @brief Lock-free intrusive multi-producer/single-consumer queue
+ *
+ * The mpsc_queue_t class implements Dmitry Vyukov's intrusive MPSC node queue:
+ * producers push with a single atomic exchange and never wait for each other or
+ * for the consumer, and the consumer pops without atomic read-modify-write
+ * operations. Nodes derive from mpsc_node_t and are owned by the caller.
+ *
+ * @note Private header, not installed with the library.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace zmqzext {
+namespace detail {
+
+/**
+ * @brief Link of a node in an mpsc_queue_t
+ */
+struct mpsc_node_t {
+    std::atomic<mpsc_node_t*> next{nullptr};  ///< Next node in the queue
+};
+
+/**
+ * @brief Intrusive multi-producer/single-consumer queue
+ *
+ * While a producer is in the middle of a push, pop() may return nullptr even
+ * though empty() is false; the node is available as soon as the push completes.
+ *
+ * @note push() may be called from any thread, pop() and empty() from the consumer thread only.
+ */
+class mpsc_queue_t {
+public:
+    mpsc_queue_t() noexcept : _head(&_stub), _tail(&_stub) {}
+
+    mpsc_queue_t(mpsc_queue_t const&) = delete;
+    mpsc_queue_t& operator=(mpsc_queue_t const&) = delete;
+
+    /**
+     * @brief Append a node, which must not be in a queue
+     */
+    void push(mpsc_node_t* node) noexcept {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto* const previous = _head.exchange(node);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove the oldest node
+     *
+     * @return The node, nullptr if the queue is empty or the oldest push is not complete yet
+     */
+    mpsc_node_t* pop() noexcept {
+        auto* tail = _tail;
+        auto* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &_stub) {
+            if (next == nullptr) {
+                return nullptr;
+            }
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+        if (tail != _head.load()) {
+            return nullptr;
+        }
+        // tail is the last node: put the stub behind it so that it can be removed
+        push(&_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Check if no node was pushed that was not popped, including pushes in progress
+     */
+    bool empty() const noexcept { return _tail == &_stub && _head.load() == &_stub; }
+
+private:
+    std::atomic<mpsc_node_t*> _head;  ///< Last node pushed, written by the producers
+    mpsc_node_t* _tail;               ///< Oldest node, owned by the consumer
+    mpsc_node_t _stub;                ///< Node keeping the queue linked when it is empty
+};
+
+}  // namespace detail
+}  // namespace zmqzext
@@ -0,0 +1,190 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file overflow_queue.cpp
+ * @brief Outbound queue that absorbs bursts beyond the high water mark of a socket
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/overflow_queue.h"
+
+#include <cerrno>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(WIN32)
+#include <stdlib.h>
+#endif
+
+namespace zmqzext {
+
+namespace {
+
+zmq::send_flags frame_flags(bool more) noexcept {
+    return more ? zmq::send_flags::dontwait | zmq::send_flags::sndmore : zmq::send_flags::dontwait;
+}
+
+}  // namespace
+
+overflow_queue_t::overflow_queue_t(loop_t& loop, zmq::socket_ref socket, overflow_queue_options_t options)
+    : _loop(loop), _socket(socket), _options(std::move(options)) {
+    if (!_socket) {
+        throw std::invalid_argument("Cannot create an overflow queue for a null socket");
+    }
+    if (_options.replay_batch == 0) {
+        throw std::invalid_argument("Overflow queue replay batch must be positive");
+    }
+#if defined(WIN32)
+    if (!_options.spill_directory.empty()) {
+        throw std::runtime_error("Overflow queue spilling is not supported on this platform");
+    }
+#endif
+}
+
+overflow_queue_t::~overflow_queue_t() noexcept {
+    if (_writable_registered) {
+        _loop.remove_writable(_socket);
+    }
+    _spill.reset();
+    if (!_spill_path.empty()) {
+        std::error_code error;
+        std::filesystem::remove_all(_spill_path, error);
+    }
+}
+
+bool overflow_queue_t::send(zmq::message_t&& msg, zmq::send_flags flags) {
+    auto const more = (static_cast<int>(flags) & ZMQ_SNDMORE) != 0;
+    if (_dropping) {
+        _dropping = more;
+        ++_dropped_frames;
+        return false;
+    }
+
+    if (empty() && _socket.send(msg, frame_flags(more))) {
+        _in_message = more;
+        return true;
+    }
+
+    if (spill_pending()) {
+        spill(msg, more);
+    } else if (_memory_bytes < _options.memory_limit) {
+        _memory_bytes += msg.size();
+        _memory.push_back(frame_t{std::move(msg), more});
+    } else if (!_options.spill_directory.empty()) {
+        spill(msg, more);
+    } else if (_in_message) {
+        // Never truncate a message whose first frames were accepted
+        _memory_bytes += msg.size();
+        _memory.push_back(frame_t{std::move(msg), more});
+    } else {
+        _dropping = more;
+        ++_dropped_frames;
+        return false;
+    }
+    _in_message = more;
+
+    if (!_writable_registered) {
+        _loop.add_writable(_socket, [this](loop_t&, zmq::socket_ref) { return replay(); });
+        _writable_registered = true;
+    }
+    return true;
+}
+
+bool overflow_queue_t::empty() const noexcept { return _memory.empty() && !spill_pending(); }
+
+std::uint64_t overflow_queue_t::spilled_frames() const noexcept {
+    return _spill ? _spill->next_sequence() - 1 - _spill->acked_sequence() : 0;
+}
+
+bool overflow_queue_t::spill_pending() const noexcept { return spilled_frames() != 0; }
+
+void overflow_queue_t::spill(zmq::message_t const& msg, bool more) {
+#if !defined(WIN32)
+    if (!_spill) {
+        auto pattern = _options.spill_directory + "/czze-overflow-XXXXXX";
+        std::vector<char> path(pattern.begin(), pattern.end());
+        path.push_back('\0');
+        std::filesystem::create_directories(_options.spill_directory);
+        if (::mkdtemp(path.data()) == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "Failed to create overflow spill directory");
+        }
+        _spill_path = path.data();
+
+        journal_options_t journal_options;
+        journal_options.segment_size = _options.spill_segment_size;
+        journal_options.max_spare_segments = 1;
+        journal_options.durable = false;
+        _spill = std::make_unique<journal_t>(_spill_path, journal_options);
+    }
+    _spill->append(zmq::const_buffer(msg.data(), msg.size()), more);
+#else
+    static_cast<void>(msg);
+    static_cast<void>(more);
+#endif
+}
+
+bool overflow_queue_t::replay() {
+    for (std::size_t n = 0; n < _options.replay_batch; ++n) {
+        if (!_memory.empty()) {
+            auto& frame = _memory.front();
+            auto const size = frame.msg.size();
+            if (!_socket.send(frame.msg, frame_flags(frame.more))) {
+                return true;
+            }
+            _memory_bytes -= size;
+            _memory.pop_front();
+        } else if (spill_pending()) {
+            if (!_has_spill_entry) {
+                _has_spill_entry = _spill->read(_spill_entry);
+            }
+            if (!_socket.send(_spill_entry.data, frame_flags(_spill_entry.more))) {
+                break;
+            }
+            _spill->ack(_spill_entry.sequence);
+            _has_spill_entry = false;
+        } else {
+            break;
+        }
+    }
+    if (_spill) {
+        // Recycles the spill files already replayed; the spill is not durable so nothing is flushed
+        _spill->sync();
+    }
+    if (empty()) {
+        _loop.remove_writable(_socket);
+        _writable_registered = false;
+    }
+    return true;
+}
+
+}  // namespace zmqzext
@@ -42,33 +42,42 @@ SOFTWARE.
 
 namespace zmqzext {
 
-void poller_t::add(zmq::socket_ref socket) {
-    if (!socket) {
-        throw std::invalid_argument("Cannot add null socket to poller");
-    }
+void poller_t::add(zmq::socket_ref socket) { add_socket_events(socket, ZMQ_POLLIN, "Socket already exists in poller"); }
+
+void poller_t::remove(zmq::socket_ref socket) { remove_socket_events(socket, ZMQ_POLLIN); }
 
-    if (has_socket(socket.handle())) {
-        throw std::invalid_argument("Socket already exists in poller");
+void poller_t::add_writable(zmq::socket_ref socket) {
+    add_socket_events(socket, ZMQ_POLLOUT, "Socket already monitored for sending");
+}
+
+void poller_t::remove_writable(zmq::socket_ref socket) { remove_socket_events(socket, ZMQ_POLLOUT); }
+
+void poller_t::add_fd(zmq::fd_t fd) {
+    if (has_fd(fd)) {
+        throw std::invalid_argument("File descriptor already exists in poller");
     }
 
-    _poll_items.push_back({socket.handle(), 0, ZMQ_POLLIN, 0});
+    _poll_items.push_back({nullptr, fd, ZMQ_POLLIN, 0});
 }
 
-void poller_t::remove(zmq::socket_ref socket) {
-    auto handle = socket.handle();
-    _poll_items.erase(std::remove_if(_poll_items.begin(), _poll_items.end(),
-                                     [handle](zmq::pollitem_t const& item) { return item.socket == handle; }),
-                      _poll_items.end());
+void poller_t::remove_fd(zmq::fd_t fd) {
+    _poll_items.erase(
+        std::remove_if(_poll_items.begin(), _poll_items.end(),
+                       [fd](zmq::pollitem_t const& item) { return item.socket == nullptr && item.fd == fd; }),
+        _poll_items.end());
 }
 
 zmq::socket_ref poller_t::wait(std::chrono::milliseconds timeout /*= std::chrono::milliseconds{-1}*/) {
+    _ready_sockets.clear();
+    _ready_fds.clear();
+    _writable_sockets.clear();
     if (is_interrupted() && is_interruptible()) {
         _terminated = true;
         return zmq::socket_ref{};
     }
     _terminated = false;
     try {
-        auto const n_items = zmq::poll(_poll_items, timeout);
+        auto const n_items = zmq::poll(_poll_items.data(), _poll_items.size(), timeout);
         // interrupt may have happened between is_interrupted() and poll() calls
         // in that case, the poll does not throw with EINTR
         // then, we check if interrupted before processing results
@@ -77,8 +86,9 @@ zmq::socket_ref poller_t::wait(std::chrono::milliseconds timeout /*= std::chrono
             return zmq::socket_ref{};
         }
         if (n_items > 0) {
+            collect_ready_fds();
             for (std::size_t i = 0; i < _poll_items.size(); ++i) {
-                if (_poll_items[i].revents == ZMQ_POLLIN) {
+                if (_poll_items[i].socket != nullptr && (_poll_items[i].revents & ZMQ_POLLIN) != 0) {
                     return zmq::socket_ref{zmq::from_handle, _poll_items[i].socket};
                 }
             }
@@ -86,7 +96,8 @@ zmq::socket_ref poller_t::wait(std::chrono::milliseconds timeout /*= std::chrono
     } catch (zmq::error_t const& e) {
         auto const error = e.num();
         if (error == EINTR) {
-            if (is_interruptible()) {
+            // signals other than the interrupt ones (e.g. a trace dump request) only wake up the wait
+            if (is_interruptible() && is_interrupted()) {
                 _terminated = true;
             }
         } else if (error == ETERM) {
@@ -99,33 +110,41 @@ zmq::socket_ref poller_t::wait(std::chrono::milliseconds timeout /*= std::chrono
 }
 
 std::vector<zmq::socket_ref> poller_t::wait_all(std::chrono::milliseconds timeout /*= std::chrono::milliseconds{-1}*/) {
-    std::vector<zmq::socket_ref> result{};
+    wait_ready(timeout);
+    return std::vector<zmq::socket_ref>(_ready_sockets.begin(), _ready_sockets.end());
+}
+
+std::size_t poller_t::wait_ready(std::chrono::milliseconds timeout /*= std::chrono::milliseconds{-1}*/) {
+    _ready_sockets.clear();
+    _ready_fds.clear();
+    _writable_sockets.clear();
     if (is_interrupted() && is_interruptible()) {
         _terminated = true;
-        return result;
+        return 0;
     }
     _terminated = false;
     try {
-        auto const n_items = zmq::poll(_poll_items, timeout);
+        auto const n_items = zmq::poll(_poll_items.data(), _poll_items.size(), timeout);
         // interrupt may have happened between is_interrupted() and poll() calls
         // in that case, the poll does not throw with EINTR
         // then, we check if interrupted before processing results
         if (is_interrupted() && is_interruptible()) {
             _terminated = true;
-            return result;
+            return 0;
         }
         if (n_items > 0) {
-            result.reserve(n_items);
+            collect_ready_fds();
             for (std::size_t i = 0; i < _poll_items.size(); ++i) {
-                if (_poll_items[i].revents == ZMQ_POLLIN) {
-                    result.emplace_back(zmq::socket_ref{zmq::from_handle, _poll_items[i].socket});
+                if (_poll_items[i].socket != nullptr && (_poll_items[i].revents & ZMQ_POLLIN) != 0) {
+                    _ready_sockets.emplace_back(zmq::from_handle, _poll_items[i].socket);
                 }
             }
         }
     } catch (zmq::error_t const& e) {
         auto const error = e.num();
         if (error == EINTR) {
-            if (is_interruptible()) {
+            // signals other than the interrupt ones (e.g. a trace dump request) only wake up the wait
+            if (is_interruptible() && is_interrupted()) {
                 _terminated = true;
             }
         } else if (error == ETERM) {
@@ -134,12 +153,57 @@ std::vector<zmq::socket_ref> poller_t::wait_all(std::chrono::milliseconds timeou
             throw;
         }
     }
-    return result;
+    return _ready_sockets.size();
+}
+
+std::pmr::vector<zmq::pollitem_t>::iterator poller_t::find_socket(void* socket_handle) {
+    return std::find_if(_poll_items.begin(), _poll_items.end(),
+                        [socket_handle](const zmq::pollitem_t& item) { return item.socket == socket_handle; });
 }
 
-bool poller_t::has_socket(void* socket_handle) const {
+void poller_t::add_socket_events(zmq::socket_ref socket, short events, char const* error) {
+    if (!socket) {
+        throw std::invalid_argument("Cannot add null socket to poller");
+    }
+
+    auto const item_it = find_socket(socket.handle());
+    if (item_it == _poll_items.end()) {
+        _poll_items.push_back({socket.handle(), 0, events, 0});
+    } else if ((item_it->events & events) != 0) {
+        throw std::invalid_argument(error);
+    } else {
+        item_it->events |= events;
+    }
+}
+
+void poller_t::remove_socket_events(zmq::socket_ref socket, short events) {
+    auto handle = socket.handle();
+    if (handle == nullptr) {
+        return;
+    }
+    auto const item_it = find_socket(handle);
+    if (item_it == _poll_items.end()) {
+        return;
+    }
+    item_it->events &= static_cast<short>(~events);
+    if (item_it->events == 0) {
+        _poll_items.erase(item_it);
+    }
+}
+
+bool poller_t::has_fd(zmq::fd_t fd) const {
     return std::any_of(_poll_items.begin(), _poll_items.end(),
-                       [socket_handle](const zmq::pollitem_t& item) { return item.socket == socket_handle; });
+                       [fd](const zmq::pollitem_t& item) { return item.socket == nullptr && item.fd == fd; });
+}
+
+void poller_t::collect_ready_fds() {
+    for (auto const& item : _poll_items) {
+        if (item.socket == nullptr && (item.revents & ZMQ_POLLIN) != 0) {
+            _ready_fds.push_back(item.fd);
+        } else if (item.socket != nullptr && (item.revents & ZMQ_POLLOUT) != 0) {
+            _writable_sockets.emplace_back(zmq::from_handle, item.socket);
+        }
+    }
 }
 
 }  // namespace zmqzext
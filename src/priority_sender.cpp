@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file priority_sender.cpp
+ * @brief Outbound scheduler sending control messages ahead of bulk data on one socket
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "cppzmqzoltanext/priority_sender.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace zmqzext {
+
+priority_sender_t::priority_sender_t(loop_t& loop, zmq::socket_ref socket, priority_sender_options_t options)
+    : _loop(loop), _socket(socket), _send_batch(options.send_batch), _queues(options.quanta.size()) {
+    if (!_socket) {
+        throw std::invalid_argument("Cannot create a priority sender for a null socket");
+    }
+    if (options.quanta.empty()) {
+        throw std::invalid_argument("Priority sender needs at least one queue");
+    }
+    if (_send_batch == 0) {
+        throw std::invalid_argument("Priority sender batch must be positive");
+    }
+    for (std::size_t i = 0; i < options.quanta.size(); ++i) {
+        if (options.quanta[i] == 0) {
+            throw std::invalid_argument("Priority sender quanta must be positive");
+        }
+        _queues[i].quantum = options.quanta[i];
+    }
+}
+
+priority_sender_t::~priority_sender_t() noexcept {
+    if (_writable_registered) {
+        _loop.remove_writable(_socket);
+    }
+}
+
+void priority_sender_t::send(std::size_t priority, std::vector<zmq::message_t>&& frames) {
+    auto& target = queue(priority);
+    if (frames.empty()) {
+        throw std::invalid_argument("Cannot send a message without frames");
+    }
+    if (empty() && try_send(frames)) {
+        return;
+    }
+
+    std::size_t bytes = 0;
+    for (auto const& frame : frames) {
+        bytes += frame.size();
+    }
+    target.messages.push_back(queued_message_t{std::move(frames), bytes});
+    target.bytes += bytes;
+    ++_queued_messages;
+
+    if (!_writable_registered) {
+        _loop.add_writable(_socket, [this](loop_t&, zmq::socket_ref) { return send_queued(); });
+        _writable_registered = true;
+    }
+}
+
+void priority_sender_t::send(std::size_t priority, zmq::message_t&& msg) {
+    std::vector<zmq::message_t> frames;
+    frames.push_back(std::move(msg));
+    send(priority, std::move(frames));
+}
+
+std::size_t priority_sender_t::queued_messages(std::size_t priority) const { return queue(priority).messages.size(); }
+
+std::size_t priority_sender_t::queued_bytes(std::size_t priority) const { return queue(priority).bytes; }
+
+priority_sender_t::queue_t& priority_sender_t::queue(std::size_t priority) {
+    if (priority >= _queues.size()) {
+        throw std::invalid_argument("Priority out of range");
+    }
+    return _queues[priority];
+}
+
+priority_sender_t::queue_t const& priority_sender_t::queue(std::size_t priority) const {
+    if (priority >= _queues.size()) {
+        throw std::invalid_argument("Priority out of range");
+    }
+    return _queues[priority];
+}
+
+bool priority_sender_t::try_send(std::vector<zmq::message_t>& frames) {
+    auto const last = frames.size() - 1;
+    if (!_socket.send(frames[0], last == 0 ? zmq::send_flags::dontwait
+                                           : zmq::send_flags::dontwait | zmq::send_flags::sndmore)) {
+        return false;
+    }
+    // Once the first frame is accepted, the socket accepts the following ones of the message without blocking
+    for (std::size_t i = 1; i <= last; ++i) {
+        _socket.send(frames[i], i == last ? zmq::send_flags::none : zmq::send_flags::sndmore);
+    }
+    return true;
+}
+
+bool priority_sender_t::send_queued() {
+    for (std::size_t n = 0; n < _send_batch && !empty();) {
+        auto& current = _queues[_current];
+        if (current.messages.empty()) {
+            // An idle queue does not accumulate credit
+            current.deficit = 0;
+        } else {
+            if (!_quantum_granted) {
+                current.deficit += current.quantum;
+                _quantum_granted = true;
+            }
+            auto& message = current.messages.front();
+            if (message.bytes <= current.deficit) {
+                if (!try_send(message.frames)) {
+                    return true;
+                }
+                current.deficit -= message.bytes;
+                current.bytes -= message.bytes;
+                current.messages.pop_front();
+                --_queued_messages;
+                ++n;
+                continue;
+            }
+        }
+        // The queue is empty or its next message does not fit in its deficit: next queue
+        _current = (_current + 1) % _queues.size();
+        _quantum_granted = false;
+    }
+    if (empty()) {
+        _loop.remove_writable(_socket);
+        _writable_registered = false;
+    }
+    return true;
+}
+
+}  // namespace zmqzext
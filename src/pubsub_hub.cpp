@@ -0,0 +1,293 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file pubsub_hub.cpp
+ * @brief In-process publish/subscribe hub matching topics with a radix tree
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/pubsub_hub.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cppzmqzoltanext/helpers.h"
+#include "cppzmqzoltanext/loop.h"
+#include "cppzmqzoltanext/signal.h"
+#include "topic_trie.h"
+
+namespace zmqzext {
+
+namespace {
+
+/// Messages handled each time a socket is ready, so that the other sockets are not starved under load
+constexpr std::size_t max_messages_per_wakeup = 256;
+
+/**
+ * @brief Subscriber known by the hub
+ */
+struct subscriber_t {
+    std::string identity;                                   ///< Routing identity
+    std::unordered_map<std::string, std::size_t> prefixes;  ///< Subscribed prefixes and their reference counts
+    std::uint64_t last_message{0};                          ///< Last message routed to the subscriber
+};
+
+/**
+ * @brief Bind a socket to an inproc endpoint never used before by a hub of this process
+ *
+ * A hub destroyed just before may still hold its endpoints while its sockets close, so the endpoints
+ * are numbered by a process wide counter instead of by the hub address, retrying if one is in use.
+ *
+ * @return The bound endpoint
+ */
+std::string bind_to_unique_endpoint(zmq::socket_t& socket, char const* name) {
+    static std::atomic<std::uint64_t> endpoint_count{0};
+    while (true) {
+        auto const endpoint = std::string{"inproc://zmqzext-pubsub-"} + name + "-" +
+                              std::to_string(endpoint_count.fetch_add(1, std::memory_order_relaxed));
+        try {
+            socket.bind(endpoint);
+            return endpoint;
+        } catch (zmq::error_t const& error) {
+            if (error.num() != EADDRINUSE) {
+                throw;
+            }
+        }
+    }
+}
+
+/**
+ * @brief State of the hub, owned by the actor thread
+ */
+class hub_t {
+public:
+    explicit hub_t(zmq::context_t& context)
+        : _publish(context, zmq::socket_type::pull), _subscribe(context, zmq::socket_type::router) {
+        _publish.set(zmq::sockopt::linger, 0);
+        _publish_endpoint = bind_to_unique_endpoint(_publish, "publish");
+        _subscribe.set(zmq::sockopt::linger, 0);
+        // Report unreachable subscribers instead of silently dropping their messages, to forget them
+        _subscribe.set(zmq::sockopt::router_mandatory, true);
+        _subscribe_endpoint = bind_to_unique_endpoint(_subscribe, "subscribe");
+    }
+
+    std::string const& publish_endpoint() const noexcept { return _publish_endpoint; }
+
+    std::string const& subscribe_endpoint() const noexcept { return _subscribe_endpoint; }
+
+    void run(zmq::socket_t& pipe) {
+        loop_t loop;
+        loop.add(pipe, [](loop_t&, zmq::socket_ref socket) {
+            zmq::message_t msg;
+            if (!recv_retry_on_eintr(socket, msg, zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            auto const signal = signal_t::check_signal(msg);
+            return !(signal && signal->is_stop());
+        });
+        loop.add(_publish, [this](loop_t&, zmq::socket_ref socket) { return on_publish(socket); });
+        loop.add(_subscribe, [this](loop_t&, zmq::socket_ref socket) { return on_command(socket); });
+        loop.run(false);
+    }
+
+private:
+    bool on_publish(zmq::socket_ref socket) {
+        for (std::size_t n = 0; n < max_messages_per_wakeup; ++n) {
+            _frames.clear();
+            do {
+                _frames.emplace_back();
+                if (!socket.recv(_frames.back(), zmq::recv_flags::dontwait)) {
+                    return true;
+                }
+            } while (_frames.back().more());
+            route();
+        }
+        return true;
+    }
+
+    bool on_command(zmq::socket_ref socket) {
+        for (std::size_t n = 0; n < max_messages_per_wakeup; ++n) {
+            zmq::message_t identity;
+            zmq::message_t command;
+            if (!socket.recv(identity, zmq::recv_flags::dontwait)) {
+                return true;
+            }
+            auto const complete = identity.more() && socket.recv(command, zmq::recv_flags::dontwait);
+            if (!complete || command.more() || command.size() == 0) {
+                // Not a subscription command: discard the rest of the message
+                while (command.more() && socket.recv(command, zmq::recv_flags::dontwait)) {
+                }
+                continue;
+            }
+            auto const* const data = command.data<char>();
+            std::string_view const prefix{data + 1, command.size() - 1};
+            if (data[0] == 1) {
+                subscribe(identity.to_string(), prefix);
+            } else if (data[0] == 0) {
+                unsubscribe(identity.to_string(), prefix);
+            }
+        }
+        return true;
+    }
+
+    void subscribe(std::string const& identity, std::string_view prefix) {
+        auto& subscriber = _subscribers[identity];
+        subscriber.identity = identity;
+        if (++subscriber.prefixes[std::string{prefix}] == 1) {
+            _trie.add(prefix, &subscriber);
+        }
+    }
+
+    void unsubscribe(std::string const& identity, std::string_view prefix) {
+        auto const subscriber_it = _subscribers.find(identity);
+        if (subscriber_it == _subscribers.end()) {
+            return;
+        }
+        auto& prefixes = subscriber_it->second.prefixes;
+        auto const prefix_it = prefixes.find(std::string{prefix});
+        if (prefix_it == prefixes.end() || --prefix_it->second != 0) {
+            return;
+        }
+        _trie.remove(prefix, &subscriber_it->second);
+        prefixes.erase(prefix_it);
+        if (prefixes.empty()) {
+            _subscribers.erase(subscriber_it);
+        }
+    }
+
+    void remove_subscriber(subscriber_t& subscriber) {
+        for (auto const& prefix : subscriber.prefixes) {
+            _trie.remove(prefix.first, &subscriber);
+        }
+        _subscribers.erase(_subscribers.find(subscriber.identity));
+    }
+
+    void route() {
+        // A subscriber matching the topic through several prefixes is only counted once
+        ++_message_count;
+        _matches.clear();
+        std::string_view const topic{_frames.front().data<char>(), _frames.front().size()};
+        _trie.match(topic, [this](subscriber_t* subscriber) {
+            if (subscriber->last_message != _message_count) {
+                subscriber->last_message = _message_count;
+                _matches.push_back(subscriber);
+            }
+        });
+
+        _unreachable.clear();
+        for (std::size_t i = 0; i < _matches.size(); ++i) {
+            if (!deliver(*_matches[i], i + 1 == _matches.size())) {
+                _unreachable.push_back(_matches[i]);
+            }
+        }
+        for (auto* subscriber : _unreachable) {
+            remove_subscriber(*subscriber);
+        }
+    }
+
+    /// Send the frames to a subscriber, moving them to the last one; false if the subscriber is gone
+    bool deliver(subscriber_t& subscriber, bool last) {
+        try {
+            auto const sent =
+                _subscribe.send(zmq::buffer(subscriber.identity), zmq::send_flags::dontwait | zmq::send_flags::sndmore);
+            if (!sent) {
+                // High water mark reached: the message is dropped for this subscriber
+                return true;
+            }
+            for (std::size_t i = 0; i < _frames.size(); ++i) {
+                auto const flags = i + 1 < _frames.size() ? zmq::send_flags::dontwait | zmq::send_flags::sndmore
+                                                          : zmq::send_flags::dontwait;
+                if (last) {
+                    _subscribe.send(_frames[i], flags);
+                } else {
+                    zmq::message_t frame;
+                    frame.copy(_frames[i]);
+                    _subscribe.send(frame, flags);
+                }
+            }
+        } catch (zmq::error_t const& error) {
+            if (error.num() != EHOSTUNREACH) {
+                throw;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    zmq::socket_t _publish;                                      ///< PULL socket receiving published messages
+    zmq::socket_t _subscribe;                                    ///< ROUTER socket of the subscribers
+    std::string _publish_endpoint;                               ///< Endpoint bound by _publish
+    std::string _subscribe_endpoint;                             ///< Endpoint bound by _subscribe
+    std::unordered_map<std::string, subscriber_t> _subscribers;  ///< Subscribers by identity
+    detail::topic_trie_t<subscriber_t*> _trie;                   ///< Subscriptions of all the subscribers
+    std::vector<zmq::message_t> _frames;                         ///< Frames of the message being routed
+    std::vector<subscriber_t*> _matches;                         ///< Subscribers matching the message being routed
+    std::vector<subscriber_t*> _unreachable;                     ///< Matching subscribers found disconnected
+    std::uint64_t _message_count{0};                             ///< Messages routed, to deduplicate matches
+};
+
+/**
+ * @brief Endpoints bound in the actor thread, read by the parent once the actor started
+ */
+struct bound_endpoints_t {
+    std::mutex mutex;
+    std::string publish;
+    std::string subscribe;
+};
+
+}  // namespace
+
+pubsub_hub_t::pubsub_hub_t(zmq::context_t& context) : _actor(context) {
+    auto const endpoints = std::make_shared<bound_endpoints_t>();
+    _actor.start([&context, endpoints](zmq::socket_t& pipe) {
+        hub_t hub{context};
+        {
+            std::lock_guard<std::mutex> lock(endpoints->mutex);
+            endpoints->publish = hub.publish_endpoint();
+            endpoints->subscribe = hub.subscribe_endpoint();
+        }
+        send_retry_on_eintr(pipe, signal_t::create_success(), zmq::send_flags::none);
+        hub.run(pipe);
+        return true;
+    });
+    std::lock_guard<std::mutex> lock(endpoints->mutex);
+    _publish_endpoint = endpoints->publish;
+    _subscribe_endpoint = endpoints->subscribe;
+}
+
+pubsub_hub_t::~pubsub_hub_t() noexcept = default;
+
+}  // namespace zmqzext
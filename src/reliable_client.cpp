@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file reliable_client.cpp
+ * @brief Asynchronous request client with pipelining, retries and failover
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/reliable_client.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace zmqzext {
+
+reliable_client_t::reliable_client_t(zmq::context_t& context, loop_t& loop, reliable_client_options_t options)
+    : _context(context), _loop(loop), _options(std::move(options)) {
+    if (_options.endpoints.empty()) {
+        throw std::invalid_argument("Reliable client needs at least one endpoint");
+    }
+    if (_options.max_outstanding == 0) {
+        throw std::invalid_argument("Reliable client max_outstanding must be positive");
+    }
+    if (_options.timeout <= std::chrono::milliseconds{0}) {
+        throw std::invalid_argument("Reliable client timeout must be positive");
+    }
+    connect();
+}
+
+reliable_client_t::~reliable_client_t() noexcept {
+    for (auto const& entry : _requests) {
+        if (entry.second.timer != 0) {
+            _loop.remove_timer(entry.second.timer);
+        }
+    }
+    _loop.remove(_socket);
+}
+
+request_id_t reliable_client_t::request(std::vector<zmq::message_t> frames, fn_reply_handler_t fn,
+                                        std::chrono::milliseconds timeout) {
+    if (frames.empty()) {
+        throw std::invalid_argument("Request must have at least one frame");
+    }
+    auto const id = ++_last_id;
+    _backlog.push_back(request_t{id, std::move(frames), std::move(fn),
+                                 timeout > std::chrono::milliseconds{0} ? timeout : _options.timeout});
+    fill_slots();
+    return id;
+}
+
+bool reliable_client_t::cancel(request_id_t id) {
+    auto const request_it = _requests.find(id);
+    if (request_it != _requests.end()) {
+        if (request_it->second.timer != 0) {
+            _loop.remove_timer(request_it->second.timer);
+        }
+        _requests.erase(request_it);
+        fill_slots();
+        return true;
+    }
+    auto const backlog_it =
+        std::find_if(_backlog.begin(), _backlog.end(), [id](request_t const& request) { return request.id == id; });
+    if (backlog_it != _backlog.end()) {
+        _backlog.erase(backlog_it);
+        return true;
+    }
+    return false;
+}
+
+void reliable_client_t::connect() {
+    if (_socket) {
+        _loop.remove(_socket);
+    }
+    // Closing the socket discards the requests queued for a dead server
+    _socket = zmq::socket_t{_context, zmq::socket_type::dealer};
+    _socket.set(zmq::sockopt::linger, 0);
+    _socket.connect(_options.endpoints[_endpoint_index]);
+    _loop.add(_socket, [this](loop_t&, zmq::socket_ref socket) { return on_reply(socket); });
+    ++_generation;
+}
+
+void reliable_client_t::send(request_t& request) {
+    auto const id = request.id;
+    // A message not taken by the socket (e.g. high water mark reached) is handled as a lost one on timeout;
+    // once the first frame is taken, the socket takes the whole message
+    if (_socket.send(zmq::const_buffer(&id, sizeof(id)), zmq::send_flags::dontwait | zmq::send_flags::sndmore)) {
+        _socket.send(zmq::message_t{}, zmq::send_flags::dontwait | zmq::send_flags::sndmore);
+        for (std::size_t i = 0; i < request.frames.size(); ++i) {
+            zmq::message_t frame;
+            frame.copy(request.frames[i]);
+            auto const flags = i + 1 < request.frames.size() ? zmq::send_flags::dontwait | zmq::send_flags::sndmore
+                                                             : zmq::send_flags::dontwait;
+            _socket.send(frame, flags);
+        }
+    }
+    ++request.attempts;
+    request.generation = _generation;
+    request.in_flight = true;
+    request.timer = _loop.add_timer(request.timeout, 1, [this, id](loop_t&, timer_id_t) {
+        on_timer(id);
+        return true;
+    });
+}
+
+void reliable_client_t::fill_slots() {
+    while (!_backlog.empty() && _requests.size() < _options.max_outstanding) {
+        auto const id = _backlog.front().id;
+        auto& request = _requests.emplace(id, std::move(_backlog.front())).first->second;
+        _backlog.pop_front();
+        send(request);
+    }
+}
+
+void reliable_client_t::complete(request_id_t id, request_result_t result, std::vector<zmq::message_t>& reply) {
+    auto const request_it = _requests.find(id);
+    auto handler = std::move(request_it->second.handler);
+    _requests.erase(request_it);
+    fill_slots();
+    if (handler) {
+        handler(result, reply);
+    }
+}
+
+bool reliable_client_t::on_reply(zmq::socket_ref socket) {
+    std::vector<zmq::message_t> frames;
+    while (true) {
+        frames.clear();
+        do {
+            frames.emplace_back();
+            if (!socket.recv(frames.back(), zmq::recv_flags::dontwait)) {
+                return true;
+            }
+        } while (frames.back().more());
+
+        // Envelope: correlation id and empty delimiter
+        request_id_t id;
+        if (frames.size() < 2 || frames[0].size() != sizeof(id) || frames[1].size() != 0) {
+            continue;
+        }
+        std::memcpy(&id, frames[0].data(), sizeof(id));
+        auto const request_it = _requests.find(id);
+        if (request_it == _requests.end() || !request_it->second.in_flight) {
+            continue;
+        }
+        _loop.remove_timer(request_it->second.timer);
+        frames.erase(frames.begin(), frames.begin() + 2);
+        complete(id, request_result_t::reply, frames);
+        if (socket != _socket) {
+            // The handler made the client fail over; the next messages belong to the new socket
+            return true;
+        }
+    }
+}
+
+void reliable_client_t::on_timer(request_id_t id) {
+    auto const request_it = _requests.find(id);
+    if (request_it == _requests.end()) {
+        return;
+    }
+    auto& request = request_it->second;
+    request.timer = 0;
+    if (!request.in_flight) {
+        send(request);
+        return;
+    }
+
+    if (request.attempts > _options.max_retries) {
+        std::vector<zmq::message_t> no_reply;
+        complete(id, request_result_t::timeout, no_reply);
+        return;
+    }
+
+    if (request.generation == _generation) {
+        // Fail over and resend the other requests in flight on the new connection
+        _endpoint_index = (_endpoint_index + 1) % _options.endpoints.size();
+        connect();
+        for (auto& entry : _requests) {
+            if (entry.second.in_flight && entry.first != id) {
+                _loop.remove_timer(entry.second.timer);
+                --entry.second.attempts;
+                send(entry.second);
+            }
+        }
+    }
+
+    auto backoff = _options.initial_backoff;
+    for (std::size_t i = 1; i < request.attempts && backoff < _options.max_backoff; ++i) {
+        backoff *= 2;
+    }
+    request.in_flight = false;
+    request.timer = _loop.add_timer(std::min(backoff, _options.max_backoff), 1, [this, id](loop_t&, timer_id_t) {
+        on_timer(id);
+        return true;
+    });
+}
+
+}  // namespace zmqzext
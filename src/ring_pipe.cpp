@@ -0,0 +1,151 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file ring_pipe.cpp
+ * @brief In-process pipe backed by lock-free single-producer/single-consumer rings
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/ring_pipe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "ring_wait.h"
+#include "spsc_ring.h"
+#include "wakeup_fd.h"
+
+namespace zmqzext {
+
+/**
+ * @brief State shared by both endpoints: one ring and one notification per direction
+ *
+ * Direction i carries the frames sent by endpoint i and received by endpoint 1 - i.
+ */
+struct ring_pipe_t::shared_t {
+    struct direction_t {
+        detail::spsc_ring_control_t control;  ///< Ring positions
+        std::unique_ptr<std::byte[]> buffer;  ///< Frame buffer
+        detail::wakeup_fd_t wakeup;           ///< Readable while the ring has frames for the receiver
+        detail::wakeup_fd_t space;            ///< Signaled when the receiver frees space for a waiting sender
+    };
+
+    explicit shared_t(std::size_t ring_capacity) : capacity(ring_capacity) {
+        for (auto& direction : directions) {
+            direction.buffer = std::make_unique<std::byte[]>(capacity);
+        }
+    }
+
+    std::size_t capacity;
+    direction_t directions[2];
+};
+
+std::pair<ring_pipe_t, ring_pipe_t> ring_pipe_t::create_pair(std::size_t capacity /* = DEFAULT_CAPACITY*/) {
+    auto shared = std::make_shared<shared_t>(detail::spsc_ring_t::round_capacity(capacity));
+    return {ring_pipe_t{shared, 0}, ring_pipe_t{shared, 1}};
+}
+
+ring_pipe_t::ring_pipe_t(std::shared_ptr<shared_t> shared, std::size_t side)
+    : _shared(std::move(shared)), _side(side) {
+    auto& outgoing = _shared->directions[_side];
+    auto& incoming = _shared->directions[1 - _side];
+    _tx = std::make_unique<detail::spsc_ring_t>(&outgoing.control, outgoing.buffer.get(), _shared->capacity);
+    _rx = std::make_unique<detail::spsc_ring_t>(&incoming.control, incoming.buffer.get(), _shared->capacity);
+}
+
+ring_pipe_t::ring_pipe_t(ring_pipe_t&& other) noexcept = default;
+
+ring_pipe_t& ring_pipe_t::operator=(ring_pipe_t&& other) noexcept = default;
+
+ring_pipe_t::~ring_pipe_t() noexcept = default;
+
+zmq::send_result_t ring_pipe_t::send(zmq::const_buffer const& buf,
+                                     zmq::send_flags flags /* = zmq::send_flags::none*/) {
+    if (buf.size() > max_message_size()) {
+        throw std::invalid_argument("Message larger than the ring pipe capacity");
+    }
+    auto const frame_flags =
+        (static_cast<int>(flags) & ZMQ_SNDMORE) != 0 ? detail::spsc_ring_t::flag_more : std::uint32_t{0};
+    auto const blocking = (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0;
+    auto& outgoing = _shared->directions[_side];
+    if (!detail::push_frame(*_tx, outgoing.wakeup, outgoing.space, buf, frame_flags, blocking,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    return buf.size();
+}
+
+zmq::recv_buffer_result_t ring_pipe_t::recv(zmq::mutable_buffer const& buf,
+                                            zmq::recv_flags flags /* = zmq::recv_flags::none*/) {
+    auto& incoming = _shared->directions[1 - _side];
+    detail::spsc_ring_t::frame_view_t frame;
+    if (!detail::wait_frame(*_rx, incoming.wakeup, (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0, frame,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    auto const size = std::min(frame.size, buf.size());
+    if (size > 0) {
+        std::memcpy(buf.data(), frame.data, size);
+    }
+    _more = (frame.flags & detail::spsc_ring_t::flag_more) != 0;
+    auto const untruncated_size = frame.size;
+    detail::release_frame(*_rx, incoming.wakeup, incoming.space, frame);
+    return zmq::recv_buffer_size{size, untruncated_size};
+}
+
+zmq::recv_result_t ring_pipe_t::recv(zmq::message_t& msg, zmq::recv_flags flags /* = zmq::recv_flags::none*/) {
+    auto& incoming = _shared->directions[1 - _side];
+    detail::spsc_ring_t::frame_view_t frame;
+    if (!detail::wait_frame(*_rx, incoming.wakeup, (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0, frame,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    msg.rebuild(frame.data, frame.size);
+    _more = (frame.flags & detail::spsc_ring_t::flag_more) != 0;
+    auto const size = frame.size;
+    detail::release_frame(*_rx, incoming.wakeup, incoming.space, frame);
+    return size;
+}
+
+zmq::fd_t ring_pipe_t::fd() const noexcept { return _shared->directions[1 - _side].wakeup.fd(); }
+
+bool ring_pipe_t::peer_alive() const noexcept {
+    // The peer endpoint shares the state until it is destroyed
+    return _shared.use_count() > 1;
+}
+
+std::size_t ring_pipe_t::capacity() const noexcept { return _shared->capacity; }
+
+std::size_t ring_pipe_t::max_message_size() const noexcept {
+    return detail::spsc_ring_t::max_payload_size(_shared->capacity);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,167 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file ring_wait.h
+ * @brief Waiting for the frames of an spsc_ring_t signaled through a wakeup_fd_t
+ *
+ * Helpers shared by the ring based transports (ring_pipe_t, shm_ring_t) to
+ * receive from a ring whose empty to non-empty transitions are signaled on a
+ * wake-up descriptor. The descriptor is cleared whenever the ring is found
+ * empty, so it is readable exactly while there are frames to receive.
+ *
+ * A producer finding the ring full waits in the same way on a second
+ * descriptor, signaled by the consumer when it frees space while the producer
+ * announced its wait. Blocked waits wake up periodically to check that the
+ * peer endpoint still exists, and fail with EPIPE once it is gone.
+ *
+ * @note Private header, not installed with the library.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <zmq.hpp>
+
+#if !defined(WIN32)
+#include <poll.h>
+#endif
+
+#include "spsc_ring.h"
+#include "wakeup_fd.h"
+
+namespace zmqzext {
+namespace detail {
+
+/// Interval in milliseconds at which a blocked wait checks that the peer endpoint still exists.
+constexpr int k_peer_check_interval_ms = 100;
+
+/// Block until the descriptor is readable or the timeout (-1 for none) expires, reporting signal interruptions as ZMQ
+/// does. Returns false on timeout.
+inline bool wait_readable(zmq::fd_t fd, int timeout_ms = -1) {
+#if !defined(WIN32)
+    pollfd item{fd, POLLIN, 0};
+    while (true) {
+        auto const result = ::poll(&item, 1, timeout_ms);
+        if (result >= 0) {
+            return result > 0;
+        }
+        if (errno == EINTR) {
+            throw zmq::error_t(EINTR);
+        }
+    }
+#else
+    (void)fd;
+    (void)timeout_ms;
+    return true;
+#endif
+}
+
+/// Copy a frame into the ring, signaling the consumer on an empty to non-empty transition. A blocking push waits on
+/// the space descriptor while the ring is full, and throws zmq::error_t with EPIPE once peer_alive() returns false.
+template <typename PeerAlive>
+bool push_frame(spsc_ring_t& ring, wakeup_fd_t& wakeup, wakeup_fd_t& space, zmq::const_buffer const& buf,
+                std::uint32_t flags, bool blocking, PeerAlive const& peer_alive) {
+    auto waiting = false;
+    while (true) {
+        switch (ring.try_push(buf.data(), buf.size(), flags)) {
+            case spsc_ring_t::push_result_t::pushed_was_empty:
+                if (waiting) {
+                    ring.cancel_wait_for_space();
+                }
+                wakeup.signal();
+                return true;
+            case spsc_ring_t::push_result_t::pushed:
+                if (waiting) {
+                    ring.cancel_wait_for_space();
+                }
+                return true;
+            case spsc_ring_t::push_result_t::full:
+                break;
+        }
+        if (!blocking) {
+            return false;
+        }
+        if (waiting && !wait_readable(space.fd(), k_peer_check_interval_ms) && !peer_alive()) {
+            ring.cancel_wait_for_space();
+            throw zmq::error_t(EPIPE);
+        }
+        // Clear before announcing: a consumer freeing space from now on signals again, so no wake-up is lost
+        space.clear();
+        ring.announce_wait_for_space();
+        waiting = true;
+    }
+}
+
+/// Get the next frame, clearing the notification whenever the ring is found empty. A blocking wait throws
+/// zmq::error_t with EPIPE once peer_alive() returns false.
+template <typename PeerAlive>
+bool wait_frame(spsc_ring_t& ring, wakeup_fd_t& wakeup, bool blocking, spsc_ring_t::frame_view_t& frame,
+                PeerAlive const& peer_alive) {
+    while (!ring.peek(frame)) {
+        // Found empty: clear the notification, then look again for frames published meanwhile
+        wakeup.clear();
+        if (!ring.recheck_empty()) {
+            wakeup.signal();
+            continue;
+        }
+        if (!blocking) {
+            return false;
+        }
+        if (!wait_readable(wakeup.fd(), k_peer_check_interval_ms) && !peer_alive()) {
+            throw zmq::error_t(EPIPE);
+        }
+    }
+    return true;
+}
+
+/// Release a received frame, clearing the notification if the ring became empty.
+inline void release_frame(spsc_ring_t& ring, wakeup_fd_t& wakeup, spsc_ring_t::frame_view_t const& frame) {
+    if (ring.pop(frame)) {
+        wakeup.clear();
+        if (!ring.recheck_empty()) {
+            wakeup.signal();
+        }
+    }
+}
+
+/// Release a received frame as release_frame(), then notify the producer if it waits for the space freed.
+inline void release_frame(spsc_ring_t& ring, wakeup_fd_t& wakeup, wakeup_fd_t& space,
+                          spsc_ring_t::frame_view_t const& frame) {
+    release_frame(ring, wakeup, frame);
+    if (ring.take_producer_waiting()) {
+        space.signal();
+    }
+}
+
+}  // namespace detail
+}  // namespace zmqzext
@@ -0,0 +1,354 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file shm_ring.cpp
+ * @brief Pipe between two processes of the same host backed by shared memory rings
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/shm_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ring_wait.h"
+#include "spsc_ring.h"
+#include "wakeup_fd.h"
+
+namespace zmqzext {
+
+namespace {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory rings need lock-free 64 bit atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Shared memory rings need lock-free 32 bit atomics");
+
+/// Value of segment_header_t::magic once the segment is initialized ("czzeshm1")
+constexpr std::uint64_t k_segment_magic = 0x637a7a6573686d31;
+
+/**
+ * @brief Header at the start of the segment, followed by the buffers of both directions
+ *
+ * Direction i carries the frames sent by endpoint i and received by endpoint 1 - i.
+ */
+struct segment_header_t {
+    std::atomic<std::uint64_t> magic;         ///< k_segment_magic, written last by the creator
+    std::uint64_t capacity;                   ///< Capacity of each ring
+    std::atomic<std::uint32_t> opened;        ///< Whether the second endpoint is attached
+    std::atomic<std::int32_t> pids[2];        ///< Process of each endpoint, 0 until attached and -1 once detached
+    detail::spsc_ring_control_t controls[2];  ///< Ring positions of each direction
+};
+
+/// Offset of the ring buffers in the segment, on a cache line of their own
+constexpr std::size_t k_buffers_offset =
+    (sizeof(segment_header_t) + detail::k_cache_line_size - 1) & ~(detail::k_cache_line_size - 1);
+
+#if defined(__linux__)
+constexpr char const* k_fifo_directory = "/dev/shm/";
+#else
+constexpr char const* k_fifo_directory = "/tmp/";
+#endif
+
+void check_name(std::string const& name) {
+    if (name.empty() || name.find('/') != std::string::npos) {
+        throw std::invalid_argument("Invalid shared memory ring name: '" + name + "'");
+    }
+}
+
+std::string segment_path(std::string const& name) { return "/czze-" + name; }
+
+std::string fifo_path(std::string const& name, std::size_t direction) {
+    return k_fifo_directory + ("czze-" + name) + "." + std::to_string(direction) + ".fifo";
+}
+
+std::string space_fifo_path(std::string const& name, std::size_t direction) {
+    return k_fifo_directory + ("czze-" + name) + "." + std::to_string(direction) + ".space.fifo";
+}
+
+#if !defined(WIN32)
+void make_fifo(std::string const& path) {
+    ::unlink(path.c_str());
+    if (::mkfifo(path.c_str(), 0600) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to create FIFO " + path);
+    }
+}
+#endif
+
+}  // namespace
+
+/**
+ * @brief Mapping of the segment and notification FIFOs of a pipe
+ *
+ * The FIFO of direction i is signaled by endpoint i and polled by endpoint 1 - i, while its space FIFO is
+ * signaled by endpoint 1 - i and waited on by endpoint i when the ring is full.
+ */
+struct shm_ring_t::segment_t {
+    segment_t(std::string pipe_name, bool creator) : name(std::move(pipe_name)), owner(creator) {}
+
+    segment_t(segment_t const&) = delete;
+    segment_t& operator=(segment_t const&) = delete;
+
+    ~segment_t() noexcept {
+#if !defined(WIN32)
+        if (address != nullptr) {
+            if (owner || attached) {
+                header()->pids[attached ? 1 : 0].store(-1);
+            }
+            if (attached) {
+                header()->opened.store(0);
+            }
+            ::munmap(address, size);
+        }
+#endif
+        if (owner) {
+            shm_ring_t::remove(name);
+        }
+    }
+
+    segment_header_t* header() const noexcept { return static_cast<segment_header_t*>(address); }
+
+    std::byte* buffer(std::size_t direction) const noexcept {
+        return static_cast<std::byte*>(address) + k_buffers_offset + direction * header()->capacity;
+    }
+
+    std::string name;                                 ///< Name of the pipe
+    bool owner;                                       ///< Whether the pipe is removed on destruction
+    bool attached{false};                             ///< Whether this is the opened endpoint, once attached
+    void* address{nullptr};                           ///< Mapping of the segment, nullptr if not mapped
+    std::size_t size{0};                              ///< Size of the mapping
+    std::unique_ptr<detail::wakeup_fd_t> wakeups[2];  ///< Notification of each direction
+    std::unique_ptr<detail::wakeup_fd_t> spaces[2];   ///< Space notification of each direction
+};
+
+shm_ring_t shm_ring_t::create(std::string const& name, std::size_t capacity /* = DEFAULT_CAPACITY*/) {
+    check_name(name);
+#if defined(WIN32)
+    (void)capacity;
+    throw std::runtime_error("Shared memory rings are not supported on this platform");
+#else
+    auto const ring_capacity = detail::spsc_ring_t::round_capacity(capacity);
+    auto const path = segment_path(name);
+    auto const fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to create shared memory segment " + path);
+    }
+    // From now on, the segment and FIFOs are removed if anything fails
+    auto segment = std::make_unique<segment_t>(name, true);
+    segment->size = k_buffers_offset + 2 * ring_capacity;
+    if (::ftruncate(fd, static_cast<off_t>(segment->size)) != 0) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Failed to size shared memory segment " + path);
+    }
+    auto* const address = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto const error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "Failed to map shared memory segment " + path);
+    }
+    segment->address = address;
+
+    auto* const header = new (segment->address) segment_header_t{};
+    header->capacity = ring_capacity;
+    header->pids[0].store(static_cast<std::int32_t>(::getpid()));
+    for (std::size_t direction = 0; direction < 2; ++direction) {
+        auto const fifo = fifo_path(name, direction);
+        make_fifo(fifo);
+        segment->wakeups[direction] = std::make_unique<detail::wakeup_fd_t>(fifo.c_str());
+        auto const space_fifo = space_fifo_path(name, direction);
+        make_fifo(space_fifo);
+        segment->spaces[direction] = std::make_unique<detail::wakeup_fd_t>(space_fifo.c_str());
+    }
+    header->magic.store(k_segment_magic, std::memory_order_release);
+    return shm_ring_t{std::move(segment), 0};
+#endif
+}
+
+shm_ring_t shm_ring_t::open(std::string const& name) {
+    check_name(name);
+#if defined(WIN32)
+    throw std::runtime_error("Shared memory rings are not supported on this platform");
+#else
+    auto const path = segment_path(name);
+    auto const fd = ::shm_open(path.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to open shared memory segment " + path);
+    }
+    auto segment = std::make_unique<segment_t>(name, false);
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Failed to stat shared memory segment " + path);
+    }
+    segment->size = static_cast<std::size_t>(status.st_size);
+    if (segment->size <= k_buffers_offset) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory segment " + path + " is not initialized");
+    }
+    auto* const address = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto const error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "Failed to map shared memory segment " + path);
+    }
+    segment->address = address;
+
+    auto* const header = segment->header();
+    if (header->magic.load(std::memory_order_acquire) != k_segment_magic ||
+        k_buffers_offset + 2 * header->capacity > segment->size) {
+        throw std::runtime_error("Shared memory segment " + path + " is not initialized");
+    }
+    if (header->opened.exchange(1) != 0) {
+        throw std::runtime_error("Shared memory ring " + name + " is already opened by another endpoint");
+    }
+    segment->attached = true;
+    header->pids[1].store(static_cast<std::int32_t>(::getpid()));
+    for (std::size_t direction = 0; direction < 2; ++direction) {
+        segment->wakeups[direction] = std::make_unique<detail::wakeup_fd_t>(fifo_path(name, direction).c_str());
+        segment->spaces[direction] = std::make_unique<detail::wakeup_fd_t>(space_fifo_path(name, direction).c_str());
+    }
+    return shm_ring_t{std::move(segment), 1};
+#endif
+}
+
+void shm_ring_t::remove(std::string const& name) noexcept {
+#if !defined(WIN32)
+    try {
+        ::shm_unlink(segment_path(name).c_str());
+        for (std::size_t direction = 0; direction < 2; ++direction) {
+            ::unlink(fifo_path(name, direction).c_str());
+            ::unlink(space_fifo_path(name, direction).c_str());
+        }
+    } catch (...) {
+    }
+#else
+    (void)name;
+#endif
+}
+
+shm_ring_t::shm_ring_t(std::unique_ptr<segment_t> segment, std::size_t side)
+    : _segment(std::move(segment)), _side(side) {
+    auto const capacity = _segment->header()->capacity;
+    _tx = std::make_unique<detail::spsc_ring_t>(&_segment->header()->controls[_side], _segment->buffer(_side),
+                                                capacity);
+    _rx = std::make_unique<detail::spsc_ring_t>(&_segment->header()->controls[1 - _side],
+                                                _segment->buffer(1 - _side), capacity);
+}
+
+shm_ring_t::shm_ring_t(shm_ring_t&& other) noexcept = default;
+
+shm_ring_t& shm_ring_t::operator=(shm_ring_t&& other) noexcept = default;
+
+shm_ring_t::~shm_ring_t() noexcept = default;
+
+zmq::send_result_t shm_ring_t::send(zmq::const_buffer const& buf, zmq::send_flags flags /* = zmq::send_flags::none*/) {
+    if (buf.size() > max_message_size()) {
+        throw std::invalid_argument("Message larger than the shared memory ring capacity");
+    }
+    auto const frame_flags =
+        (static_cast<int>(flags) & ZMQ_SNDMORE) != 0 ? detail::spsc_ring_t::flag_more : std::uint32_t{0};
+    auto const blocking = (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0;
+    if (!detail::push_frame(*_tx, *_segment->wakeups[_side], *_segment->spaces[_side], buf, frame_flags, blocking,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    return buf.size();
+}
+
+zmq::recv_buffer_result_t shm_ring_t::recv(zmq::mutable_buffer const& buf,
+                                           zmq::recv_flags flags /* = zmq::recv_flags::none*/) {
+    auto& wakeup = *_segment->wakeups[1 - _side];
+    detail::spsc_ring_t::frame_view_t frame;
+    if (!detail::wait_frame(*_rx, wakeup, (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0, frame,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    auto const size = std::min(frame.size, buf.size());
+    if (size > 0) {
+        std::memcpy(buf.data(), frame.data, size);
+    }
+    _more = (frame.flags & detail::spsc_ring_t::flag_more) != 0;
+    auto const untruncated_size = frame.size;
+    detail::release_frame(*_rx, wakeup, *_segment->spaces[1 - _side], frame);
+    return zmq::recv_buffer_size{size, untruncated_size};
+}
+
+zmq::recv_result_t shm_ring_t::recv(zmq::message_t& msg, zmq::recv_flags flags /* = zmq::recv_flags::none*/) {
+    auto& wakeup = *_segment->wakeups[1 - _side];
+    detail::spsc_ring_t::frame_view_t frame;
+    if (!detail::wait_frame(*_rx, wakeup, (static_cast<int>(flags) & ZMQ_DONTWAIT) == 0, frame,
+                            [this]() { return peer_alive(); })) {
+        return {};
+    }
+    msg.rebuild(frame.data, frame.size);
+    _more = (frame.flags & detail::spsc_ring_t::flag_more) != 0;
+    auto const size = frame.size;
+    detail::release_frame(*_rx, wakeup, *_segment->spaces[1 - _side], frame);
+    return size;
+}
+
+zmq::fd_t shm_ring_t::fd() const noexcept { return _segment->wakeups[1 - _side]->fd(); }
+
+std::size_t shm_ring_t::capacity() const noexcept { return _tx->capacity(); }
+
+std::size_t shm_ring_t::max_message_size() const noexcept {
+    return detail::spsc_ring_t::max_payload_size(_tx->capacity());
+}
+
+std::string const& shm_ring_t::name() const noexcept { return _segment->name; }
+
+bool shm_ring_t::peer_alive() const noexcept {
+#if !defined(WIN32)
+    auto const pid = _segment->header()->pids[1 - _side].load();
+    if (pid == 0) {
+        // Not attached yet: the creator keeps waiting for the opener
+        return true;
+    }
+    return pid > 0 && (::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+#else
+    return true;
+#endif
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,316 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer/single-consumer byte ring of variable-sized frames
+ *
+ * The spsc_ring_t class implements the ring algorithm over memory provided by
+ * the caller, so the same code serves heap allocated rings (ring_pipe_t) and
+ * rings placed in shared memory. Frames are stored inline, prefixed by an
+ * 8 byte header, and padded to 8 bytes. A frame that does not fit before the
+ * end of the buffer is preceded by a wrap marker that sends the consumer back
+ * to the beginning of the buffer.
+ *
+ * Producer and consumer must each use their own spsc_ring_t instance over the
+ * same control block and buffer, as each instance caches the position owned by
+ * the other side.
+ *
+ * Empty to non-empty transitions are detected with sequentially consistent
+ * accesses to the head and tail positions on both sides, so a consumer that
+ * observes the ring empty and a producer that publishes a frame at the same
+ * time can never both miss each other. This allows a notification to be sent
+ * only when the ring goes from empty to non-empty. The same ordering lets a
+ * producer finding the ring full announce that it waits for space, so the
+ * consumer only notifies it when it is actually waiting.
+ *
+ * @note Private header, not installed with the library.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace zmqzext {
+namespace detail {
+
+/// Size of a cache line used to keep the positions of each side apart.
+constexpr std::size_t k_cache_line_size = 64;
+
+/**
+ * @brief Control block shared by the producer and the consumer of a ring
+ *
+ * Positions are monotonically increasing byte counters; the offset into the
+ * buffer is the position modulo the (power of two) capacity.
+ */
+struct spsc_ring_control_t {
+    alignas(k_cache_line_size) std::atomic<std::uint64_t> head{0};  ///< Write position, owned by the producer
+    alignas(k_cache_line_size) std::atomic<std::uint64_t> tail{0};  ///< Read position, owned by the consumer
+
+    /// Whether the producer waits for space, set by the producer and cleared by the consumer when notifying it
+    alignas(k_cache_line_size) std::atomic<std::uint32_t> producer_waiting{0};
+};
+
+/**
+ * @brief Header stored in front of each frame
+ */
+struct spsc_ring_frame_header_t {
+    std::uint32_t size;   ///< Payload size in bytes
+    std::uint32_t flags;  ///< Frame flags (see spsc_ring_t::flag_*)
+};
+
+/**
+ * @brief View over a single-producer/single-consumer ring of frames
+ */
+class spsc_ring_t {
+public:
+    static constexpr std::uint32_t flag_more = 0x00000001u;  ///< More frames of the same message follow
+    static constexpr std::uint32_t flag_wrap = 0x80000000u;  ///< Padding up to the end of the buffer
+    static constexpr std::size_t frame_alignment = sizeof(spsc_ring_frame_header_t);
+
+    /**
+     * @brief Result of a push operation
+     */
+    enum class push_result_t {
+        pushed,             ///< Frame was published and the ring already had pending frames
+        pushed_was_empty,   ///< Frame was published and the consumer had consumed everything before
+        full,               ///< Not enough free space; nothing visible to the consumer was published
+    };
+
+    /**
+     * @brief Frame returned by peek(), pointing into the ring buffer
+     */
+    struct frame_view_t {
+        void const* data;     ///< Payload start
+        std::size_t size;     ///< Payload size in bytes
+        std::uint32_t flags;  ///< Frame flags
+    };
+
+    /**
+     * @brief Construct a view over an existing control block and buffer
+     *
+     * @param control Shared control block
+     * @param buffer Shared frame buffer, aligned to frame_alignment
+     * @param capacity Buffer size in bytes, a power of two not smaller than 2 * frame_alignment
+     */
+    spsc_ring_t(spsc_ring_control_t* control, std::byte* buffer, std::size_t capacity) noexcept
+        : _control(control),
+          _buffer(buffer),
+          _capacity(capacity),
+          _mask(capacity - 1),
+          _cached_tail(control->tail.load(std::memory_order_acquire)),
+          _last_frame_end(control->head.load(std::memory_order_acquire)),
+          _cached_head(control->head.load(std::memory_order_acquire)),
+          _tail(control->tail.load(std::memory_order_acquire)) {}
+
+    /**
+     * @brief Round a requested capacity up to a valid ring capacity
+     */
+    static std::size_t round_capacity(std::size_t requested) noexcept {
+        std::size_t capacity = 2 * frame_alignment;
+        while (capacity < requested) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /**
+     * @brief Largest payload a ring of the given capacity accepts
+     */
+    static std::size_t max_payload_size(std::size_t capacity) noexcept {
+        return capacity - sizeof(spsc_ring_frame_header_t);
+    }
+
+    /**
+     * @brief Total ring space used by a frame with the given payload size
+     */
+    static std::size_t frame_footprint(std::size_t payload_size) noexcept {
+        return (sizeof(spsc_ring_frame_header_t) + payload_size + frame_alignment - 1) & ~(frame_alignment - 1);
+    }
+
+    std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * @brief Producer side: copy a frame into the ring
+     *
+     * @param data Payload start
+     * @param size Payload size, not larger than max_payload_size(capacity())
+     * @param flags Frame flags
+     * @return The push result
+     */
+    push_result_t try_push(void const* data, std::size_t size, std::uint32_t flags) noexcept {
+        auto const footprint = frame_footprint(size);
+        auto head = _control->head.load(std::memory_order_relaxed);
+        auto contiguous = _capacity - static_cast<std::size_t>(head & _mask);
+        if (footprint > contiguous) {
+            // The frame must start at the beginning of the buffer: pad the rest of it first
+            if (!has_free_space(head, contiguous)) {
+                return push_result_t::full;
+            }
+            write_header(head, 0, flag_wrap);
+            head += contiguous;
+            _control->head.store(head, std::memory_order_release);
+        }
+        if (!has_free_space(head, footprint)) {
+            return push_result_t::full;
+        }
+        write_header(head, static_cast<std::uint32_t>(size), flags);
+        if (size > 0) {
+            std::memcpy(_buffer + static_cast<std::size_t>(head & _mask) + sizeof(spsc_ring_frame_header_t), data,
+                        size);
+        }
+        head += footprint;
+        _control->head.store(head, std::memory_order_seq_cst);
+        _cached_tail = _control->tail.load(std::memory_order_seq_cst);
+        auto const was_empty = _cached_tail >= _last_frame_end;
+        _last_frame_end = head;
+        return was_empty ? push_result_t::pushed_was_empty : push_result_t::pushed;
+    }
+
+    /**
+     * @brief Producer side: announce a wait for free space, then reload the consumer position
+     *
+     * A consumer releasing a frame afterwards sees the announcement, and one that
+     * released it before is seen by the next try_push().
+     */
+    void announce_wait_for_space() noexcept {
+        _control->producer_waiting.store(1, std::memory_order_seq_cst);
+        _cached_tail = _control->tail.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Producer side: withdraw the announcement of announce_wait_for_space()
+     */
+    void cancel_wait_for_space() noexcept { _control->producer_waiting.store(0, std::memory_order_relaxed); }
+
+    /**
+     * @brief Consumer side: get the next frame without consuming it
+     *
+     * @param frame Filled with the next frame when available
+     * @return true if a frame is available, false if the ring is empty
+     */
+    bool peek(frame_view_t& frame) noexcept {
+        while (true) {
+            if (_tail == _cached_head) {
+                _cached_head = _control->head.load(std::memory_order_acquire);
+                if (_tail == _cached_head) {
+                    return false;
+                }
+            }
+            auto const offset = static_cast<std::size_t>(_tail & _mask);
+            spsc_ring_frame_header_t header;
+            std::memcpy(&header, _buffer + offset, sizeof(header));
+            if ((header.flags & flag_wrap) != 0) {
+                _tail += _capacity - offset;
+                continue;
+            }
+            frame.data = _buffer + offset + sizeof(spsc_ring_frame_header_t);
+            frame.size = header.size;
+            frame.flags = header.flags;
+            return true;
+        }
+    }
+
+    /**
+     * @brief Consumer side: release the frame returned by the last successful peek()
+     *
+     * @param frame The frame returned by peek()
+     * @return true if the ring was observed empty after releasing the frame
+     */
+    bool pop(frame_view_t const& frame) noexcept {
+        _tail += frame_footprint(frame.size);
+        _control->tail.store(_tail, std::memory_order_seq_cst);
+        if (_tail != _cached_head) {
+            return false;
+        }
+        _cached_head = _control->head.load(std::memory_order_seq_cst);
+        return _tail == _cached_head;
+    }
+
+    /**
+     * @brief Consumer side: check, after a pop(), whether the producer waits for space, withdrawing its announcement
+     *
+     * @return true if the producer must be notified that space was freed
+     */
+    bool take_producer_waiting() noexcept {
+        // pop() stored the tail with sequential consistency, pairing with announce_wait_for_space()
+        return _control->producer_waiting.load(std::memory_order_seq_cst) != 0 &&
+               _control->producer_waiting.exchange(0) != 0;
+    }
+
+    /**
+     * @brief Consumer side: check again whether the ring is empty
+     *
+     * Publishes the consumer position (including skipped wrap markers) and
+     * reloads the producer position with sequentially consistent ordering.
+     * Used after clearing a notification to detect frames published meanwhile.
+     *
+     * @return true if the ring is empty
+     */
+    bool recheck_empty() noexcept {
+        _control->tail.store(_tail, std::memory_order_seq_cst);
+        _cached_head = _control->head.load(std::memory_order_seq_cst);
+        return _tail == _cached_head;
+    }
+
+private:
+    bool has_free_space(std::uint64_t head, std::size_t bytes) noexcept {
+        if (head + bytes - _cached_tail <= _capacity) {
+            return true;
+        }
+        _cached_tail = _control->tail.load(std::memory_order_acquire);
+        return head + bytes - _cached_tail <= _capacity;
+    }
+
+    void write_header(std::uint64_t position, std::uint32_t size, std::uint32_t flags) noexcept {
+        spsc_ring_frame_header_t const header{size, flags};
+        std::memcpy(_buffer + static_cast<std::size_t>(position & _mask), &header, sizeof(header));
+    }
+
+    spsc_ring_control_t* _control;  ///< Shared positions
+    std::byte* _buffer;             ///< Shared frame buffer
+    std::size_t _capacity;          ///< Buffer size (power of two)
+    std::uint64_t _mask;            ///< capacity - 1
+
+    // Producer side state
+    std::uint64_t _cached_tail;     ///< Last consumer position seen by the producer
+    std::uint64_t _last_frame_end;  ///< Position right after the last frame published by the producer
+
+    // Consumer side state
+    std::uint64_t _cached_head;  ///< Last producer position seen by the consumer
+    std::uint64_t _tail;         ///< Consumer position including skipped wrap markers
+};
+
+}  // namespace detail
+}  // namespace zmqzext
@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file thread_usage.cpp
+ * @brief CPU time and context switches of a thread
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "cppzmqzoltanext/thread_usage.h"
+
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace zmqzext {
+
+thread_usage_t current_thread_usage() noexcept {
+    thread_usage_t usage;
+#if defined(WIN32)
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        auto const to_ticks = [](FILETIME const& time) {
+            return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+        // FILETIME ticks are 100 ns
+        usage.cpu_time = std::chrono::nanoseconds{(to_ticks(kernel_time) + to_ticks(user_time)) * 100};
+    }
+#else
+    struct timespec time {};
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+        usage.cpu_time = std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+    }
+#if defined(__linux__)
+    struct rusage resources {};
+    if (::getrusage(RUSAGE_THREAD, &resources) == 0) {
+        usage.voluntary_switches = static_cast<std::uint64_t>(resources.ru_nvcsw);
+        usage.involuntary_switches = static_cast<std::uint64_t>(resources.ru_nivcsw);
+    }
+#endif
+#endif
+    return usage;
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,232 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file topic_trie.h
+ * @brief Compressed prefix tree (radix tree) of topic subscriptions
+ *
+ * The topic_trie_t class stores subscriptions, each a prefix and a subscriber,
+ * in a radix tree whose edges are labeled with strings. Prefixes sharing their
+ * first bytes share the nodes of those bytes, so matching a topic visits each
+ * byte of the topic at most once, whatever the number of subscriptions, and
+ * reports the subscribers of every prefix of the topic.
+ *
+ * Nodes are split when a new prefix diverges in the middle of a label and
+ * merged back with their only child when their last subscription is removed,
+ * so the tree stays compressed.
+ *
+ * @note Private header, not installed with the library.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace zmqzext {
+namespace detail {
+
+/**
+ * @brief Radix tree mapping topic prefixes to subscribers
+ *
+ * @tparam Subscriber Cheap to copy and equality comparable subscriber handle, e.g. a pointer
+ */
+template <typename Subscriber>
+class topic_trie_t {
+public:
+    /**
+     * @brief Add a subscription
+     *
+     * @return true if added, false if the subscriber was already subscribed to the prefix
+     */
+    bool add(std::string_view prefix, Subscriber subscriber) {
+        auto* node = &_root;
+        while (!prefix.empty()) {
+            auto* const slot = find_child(*node, prefix.front());
+            if (slot == nullptr) {
+                node->children.push_back(std::make_unique<node_t>());
+                node->children.back()->label = std::string{prefix};
+                node = node->children.back().get();
+                break;
+            }
+            auto& child = **slot;
+            auto const common = common_length(child.label, prefix);
+            if (common < child.label.size()) {
+                split(child, common);
+            }
+            node = &child;
+            prefix.remove_prefix(common);
+        }
+        if (std::find(node->subscribers.begin(), node->subscribers.end(), subscriber) != node->subscribers.end()) {
+            return false;
+        }
+        node->subscribers.push_back(subscriber);
+        ++_size;
+        return true;
+    }
+
+    /**
+     * @brief Remove a subscription
+     *
+     * @return true if removed, false if the subscriber was not subscribed to the prefix
+     */
+    bool remove(std::string_view prefix, Subscriber subscriber) {
+        std::vector<std::pair<node_t*, std::size_t>> path;  // Parent and index in its children of each node
+        auto* node = &_root;
+        while (!prefix.empty()) {
+            auto* const slot = find_child(*node, prefix.front());
+            if (slot == nullptr || prefix.substr(0, (*slot)->label.size()) != (*slot)->label) {
+                return false;
+            }
+            path.emplace_back(node, static_cast<std::size_t>(slot - node->children.data()));
+            prefix.remove_prefix((*slot)->label.size());
+            node = slot->get();
+        }
+        auto const subscriber_it = std::find(node->subscribers.begin(), node->subscribers.end(), subscriber);
+        if (subscriber_it == node->subscribers.end()) {
+            return false;
+        }
+        *subscriber_it = node->subscribers.back();
+        node->subscribers.pop_back();
+        --_size;
+
+        // Prune the nodes left without subscription and merge a node with its only child
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            auto& children = it->first->children;
+            auto& current = *children[it->second];
+            if (!current.subscribers.empty()) {
+                break;
+            }
+            if (current.children.empty()) {
+                children[it->second] = std::move(children.back());
+                children.pop_back();
+                continue;
+            }
+            if (current.children.size() == 1) {
+                auto only_child = std::move(current.children.front());
+                current.label += only_child->label;
+                current.subscribers = std::move(only_child->subscribers);
+                current.children = std::move(only_child->children);
+            }
+            break;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Call a function with the subscriber of each subscription whose prefix matches the topic
+     *
+     * A subscriber subscribed to several prefixes of the topic is reported once per prefix.
+     */
+    template <typename Fn>
+    void match(std::string_view topic, Fn&& fn) const {
+        auto const* node = &_root;
+        while (true) {
+            for (auto const& subscriber : node->subscribers) {
+                fn(subscriber);
+            }
+            if (topic.empty()) {
+                return;
+            }
+            auto const* const slot = find_child(*node, topic.front());
+            if (slot == nullptr || topic.substr(0, (*slot)->label.size()) != (*slot)->label) {
+                return;
+            }
+            topic.remove_prefix((*slot)->label.size());
+            node = slot->get();
+        }
+    }
+
+    /**
+     * @brief Get the number of subscriptions
+     */
+    std::size_t size() const noexcept { return _size; }
+
+private:
+    /**
+     * @brief Node of the tree, reached from its parent through its label
+     */
+    struct node_t {
+        std::string label;                              ///< Bytes of the edge from the parent, empty for the root
+        std::vector<Subscriber> subscribers;            ///< Subscribers of the prefix ending at this node
+        std::vector<std::unique_ptr<node_t>> children;  ///< Children, with distinct first label bytes
+    };
+
+    static std::unique_ptr<node_t> const* find_child(node_t const& node, char first) noexcept {
+        for (auto const& child : node.children) {
+            if (child->label.front() == first) {
+                return &child;
+            }
+        }
+        return nullptr;
+    }
+
+    static std::unique_ptr<node_t>* find_child(node_t& node, char first) noexcept {
+        for (auto& child : node.children) {
+            if (child->label.front() == first) {
+                return &child;
+            }
+        }
+        return nullptr;
+    }
+
+    static std::size_t common_length(std::string_view a, std::string_view b) noexcept {
+        auto const length = std::min(a.size(), b.size());
+        std::size_t i = 0;
+        while (i < length && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    /// Split a node so that its label ends after length bytes, moving its content to a new child
+    static void split(node_t& node, std::size_t length) {
+        auto tail = std::make_unique<node_t>();
+        tail->label = node.label.substr(length);
+        tail->subscribers = std::move(node.subscribers);
+        tail->children = std::move(node.children);
+        node.label.resize(length);
+        node.subscribers.clear();
+        node.children.clear();
+        node.children.push_back(std::move(tail));
+    }
+
+    node_t _root;          ///< Root, holding the subscriptions to the empty prefix
+    std::size_t _size{0};  ///< Number of subscriptions
+};
+
+}  // namespace detail
+}  // namespace zmqzext
@@ -0,0 +1,434 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file tracer.cpp
+ * @brief In-process event tracer with Chrome trace export
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "cppzmqzoltanext/tracer.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if !defined(WIN32)
+#include <poll.h>
+#include <unistd.h>
+
+#include "wakeup_fd.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace zmqzext {
+
+namespace {
+
+static_assert((k_trace_buffer_events & (k_trace_buffer_events - 1)) == 0,
+              "Trace buffer size must be a power of two");
+
+constexpr char k_phase_begin = 'B';
+constexpr char k_phase_end = 'E';
+
+/**
+ * Fields are relaxed atomics so a concurrent export never races with the
+ * owning thread; on x86 they compile to plain loads and stores.
+ */
+struct trace_event_t {
+    std::atomic<std::uint64_t> timestamp{0};
+    std::atomic<char const*> name{nullptr};
+    std::atomic<char> phase{0};
+};
+
+struct thread_buffer_t {
+    explicit thread_buffer_t(std::uint32_t id) : tid(id) {}
+
+    std::uint32_t const tid;                ///< Thread id reported in the trace
+    std::atomic<bool> alive{true};          ///< Cleared when the owning thread exits
+    std::atomic<std::uint64_t> cleared{0};  ///< Events before this index were discarded by clear_trace()
+    alignas(64) std::atomic<std::uint64_t> head{0};  ///< Index of the next event, written by the owner only
+    std::array<trace_event_t, k_trace_buffer_events> events;
+};
+
+struct registry_t {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<thread_buffer_t>> buffers;
+    std::uint32_t next_tid{1};
+};
+
+registry_t& registry() {
+    static registry_t instance;
+    return instance;
+}
+
+/**
+ * Owned by each recording thread; marks its buffer as finished on thread exit.
+ */
+struct thread_buffer_handle_t {
+    ~thread_buffer_handle_t() {
+        if (buffer) {
+            buffer->alive.store(false, std::memory_order_relaxed);
+        }
+    }
+    std::shared_ptr<thread_buffer_t> buffer;
+};
+
+#if defined(CZZE_ENABLE_TRACING)
+std::atomic<bool> tracing_enabled{false};
+thread_local thread_buffer_handle_t this_thread_buffer;
+#endif
+
+/**
+ * Pair of timestamps taken at the same instant, used to convert ticks to time.
+ */
+struct clock_reference_t {
+    std::uint64_t ticks;
+    std::chrono::steady_clock::time_point time;
+};
+
+std::once_flag clock_reference_flag;
+clock_reference_t clock_reference{};
+
+std::uint64_t read_ticks() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+clock_reference_t take_clock_reference() noexcept { return {read_ticks(), std::chrono::steady_clock::now()}; }
+
+/**
+ * Ticks per microsecond measured since the reference was taken.
+ * Waits a little if the reference is too recent for an accurate ratio.
+ */
+double ticks_per_microsecond() {
+    constexpr std::chrono::milliseconds k_min_calibration_time{10};
+    std::call_once(clock_reference_flag, []() { clock_reference = take_clock_reference(); });
+    auto const elapsed = std::chrono::steady_clock::now() - clock_reference.time;
+    if (elapsed < k_min_calibration_time) {
+        std::this_thread::sleep_for(k_min_calibration_time - elapsed);
+    }
+    auto const now = take_clock_reference();
+    auto const elapsed_us = std::chrono::duration<double, std::micro>(now.time - clock_reference.time).count();
+    auto const elapsed_ticks = static_cast<double>(now.ticks - clock_reference.ticks);
+    return elapsed_ticks > 0 ? elapsed_ticks / elapsed_us : 1.0;
+}
+
+#if defined(CZZE_ENABLE_TRACING)
+thread_buffer_t* get_thread_buffer() noexcept {
+    auto& handle = this_thread_buffer;
+    if (!handle.buffer) {
+        try {
+            auto& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            handle.buffer = std::make_shared<thread_buffer_t>(reg.next_tid++);
+            reg.buffers.push_back(handle.buffer);
+        } catch (...) {
+            handle.buffer.reset();
+            return nullptr;
+        }
+    }
+    return handle.buffer.get();
+}
+
+bool record(char const* name, char phase) noexcept {
+    if (!tracing_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    auto* const buffer = get_thread_buffer();
+    if (buffer == nullptr) {
+        return false;
+    }
+    auto const head = buffer->head.load(std::memory_order_relaxed);
+    // Orders the previous head publication before the slot overwrite, see write_thread_events()
+    std::atomic_thread_fence(std::memory_order_release);
+    auto& event = buffer->events[head & (k_trace_buffer_events - 1)];
+    event.timestamp.store(read_ticks(), std::memory_order_relaxed);
+    event.name.store(name, std::memory_order_relaxed);
+    event.phase.store(phase, std::memory_order_relaxed);
+    buffer->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+#endif
+
+struct event_copy_t {
+    std::uint64_t timestamp;
+    char const* name;
+    char phase;
+};
+
+void write_json_string(std::ostream& os, char const* str) {
+    os << '"';
+    for (auto const* c = str; *c != '\0'; ++c) {
+        switch (*c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    os << ' ';
+                } else {
+                    os << *c;
+                }
+        }
+    }
+    os << '"';
+}
+
+long current_pid() noexcept {
+#if !defined(WIN32)
+    return static_cast<long>(::getpid());
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Copies the events of a buffer that may be written concurrently and writes
+ * only the ones that were certainly not overwritten during the copy.
+ */
+void write_thread_events(std::ostream& os, thread_buffer_t const& buffer, double ticks_per_us, long pid, bool& first) {
+    auto const head = buffer.head.load(std::memory_order_acquire);
+    // One slot is left out: it may be being overwritten by the owner right now
+    auto begin = head >= k_trace_buffer_events ? head - k_trace_buffer_events + 1 : 0;
+    begin = std::max(begin, buffer.cleared.load(std::memory_order_relaxed));
+    if (begin >= head) {
+        return;
+    }
+    std::vector<event_copy_t> events;
+    events.reserve(static_cast<std::size_t>(head - begin));
+    for (auto i = begin; i < head; ++i) {
+        auto const& event = buffer.events[i & (k_trace_buffer_events - 1)];
+        events.push_back(event_copy_t{event.timestamp.load(std::memory_order_relaxed),
+                                      event.name.load(std::memory_order_relaxed),
+                                      event.phase.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto const head_after = buffer.head.load(std::memory_order_relaxed);
+    auto const first_valid = head_after >= k_trace_buffer_events ? head_after - k_trace_buffer_events + 1 : 0;
+
+    for (auto i = std::max(begin, first_valid); i < head; ++i) {
+        auto const& event = events[static_cast<std::size_t>(i - begin)];
+        if (event.name == nullptr) {
+            continue;
+        }
+        auto const ticks = static_cast<double>(event.timestamp) - static_cast<double>(clock_reference.ticks);
+        os << (first ? "" : ",") << "\n{\"name\":";
+        write_json_string(os, event.name);
+        os << ",\"cat\":\"czze\",\"ph\":\"" << event.phase << "\",\"ts\":" << ticks / ticks_per_us
+           << ",\"pid\":" << pid << ",\"tid\":" << buffer.tid << "}";
+        first = false;
+    }
+}
+
+#if !defined(WIN32)
+/**
+ * Background thread writing the trace when the dump signal is received.
+ */
+struct dump_handler_t {
+    bool installed{false};
+    int signum{0};
+    struct sigaction stored_action {};
+    std::unique_ptr<detail::wakeup_fd_t> wakeup;  // Never reset: a running signal handler may still use it
+    std::atomic<bool> stop{false};
+    std::thread thread;
+};
+
+dump_handler_t dump_handler;
+std::atomic<detail::wakeup_fd_t*> dump_wakeup{nullptr};
+
+void dump_signal_handler(int /*signal*/) {
+    auto* const wakeup = dump_wakeup.load(std::memory_order_acquire);
+    if (wakeup != nullptr) {
+        wakeup->signal();
+    }
+}
+
+void run_dump_thread(detail::wakeup_fd_t& wakeup, std::string const path) {
+    while (!dump_handler.stop.load(std::memory_order_acquire)) {
+        pollfd item{wakeup.fd(), POLLIN, 0};
+        if (::poll(&item, 1, -1) <= 0) {
+            continue;
+        }
+        wakeup.clear();
+        if (dump_handler.stop.load(std::memory_order_acquire)) {
+            break;
+        }
+        try {
+            dump_chrome_trace(path);
+        } catch (...) {
+            // Nobody to report to; the next signal retries
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+bool is_tracing_compiled_in() noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void enable_tracing() noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    std::call_once(clock_reference_flag, []() { clock_reference = take_clock_reference(); });
+    tracing_enabled.store(true, std::memory_order_relaxed);
+#endif
+}
+
+void disable_tracing() noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    tracing_enabled.store(false, std::memory_order_relaxed);
+#endif
+}
+
+bool is_tracing_enabled() noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    return tracing_enabled.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+bool trace_begin([[maybe_unused]] char const* name) noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    return record(name, k_phase_begin);
+#else
+    return false;
+#endif
+}
+
+bool trace_end([[maybe_unused]] char const* name) noexcept {
+#if defined(CZZE_ENABLE_TRACING)
+    return record(name, k_phase_end);
+#else
+    return false;
+#endif
+}
+
+void clear_trace() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                                     [](auto const& buffer) { return !buffer->alive.load(std::memory_order_relaxed); }),
+                      reg.buffers.end());
+    for (auto const& buffer : reg.buffers) {
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void write_chrome_trace(std::ostream& os) {
+    std::vector<std::shared_ptr<thread_buffer_t>> buffers;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+    auto const ticks_per_us = ticks_per_microsecond();
+    auto const pid = current_pid();
+    auto first = true;
+    os << "{\"traceEvents\":[";
+    for (auto const& buffer : buffers) {
+        write_thread_events(os, *buffer, ticks_per_us, pid, first);
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void dump_chrome_trace(std::string const& path) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Unable to open trace file: " + path);
+    }
+    write_chrome_trace(file);
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Unable to write trace file: " + path);
+    }
+}
+
+#if !defined(WIN32)
+void install_trace_dump_handler(std::string const& path, int signum /* = SIGUSR1*/) {
+    restore_trace_dump_handler();
+
+    if (!dump_handler.wakeup) {
+        dump_handler.wakeup = std::make_unique<detail::wakeup_fd_t>();
+    }
+    dump_handler.wakeup->clear();  // Drops a signal received after the previous restore
+    dump_handler.stop.store(false, std::memory_order_release);
+    dump_handler.thread = std::thread(run_dump_thread, std::ref(*dump_handler.wakeup), path);
+    dump_handler.signum = signum;
+    dump_wakeup.store(dump_handler.wakeup.get(), std::memory_order_release);
+
+    struct sigaction action;
+    action.sa_handler = dump_signal_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(signum, &action, &dump_handler.stored_action);
+    dump_handler.installed = true;
+}
+
+void restore_trace_dump_handler() noexcept {
+    if (!dump_handler.installed) {
+        return;
+    }
+    sigaction(dump_handler.signum, &dump_handler.stored_action, nullptr);
+    dump_wakeup.store(nullptr, std::memory_order_release);
+    dump_handler.stop.store(true, std::memory_order_release);
+    dump_handler.wakeup->signal();
+    dump_handler.thread.join();
+    dump_handler.installed = false;
+}
+#endif
+
+}  // namespace zmqzext
@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file wakeup_fd.cpp
+ * @brief Pollable file descriptor used to wake up a poller from another thread
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#include "wakeup_fd.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace zmqzext {
+namespace detail {
+
+#if !defined(WIN32)
+
+namespace {
+
+/// Read a pipe or FIFO until it is empty.
+void drain(zmq::fd_t fd) noexcept {
+    char buffer[64];
+    while (true) {
+        auto const rc = ::read(fd, buffer, sizeof(buffer));
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        }
+        if (rc <= 0) {
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+wakeup_fd_t::wakeup_fd_t(char const* fifo_path) : _fifo(true) {
+    // Opened for reading and writing so that it never blocks nor reports the end of file
+    _read_fd = ::open(fifo_path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (_read_fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to open FIFO");
+    }
+    _write_fd = _read_fd;
+}
+
+#endif
+
+#if defined(__linux__)
+
+wakeup_fd_t::wakeup_fd_t() {
+    _read_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_read_fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to create eventfd");
+    }
+    _write_fd = _read_fd;
+}
+
+wakeup_fd_t::~wakeup_fd_t() noexcept { ::close(_read_fd); }
+
+void wakeup_fd_t::signal() noexcept {
+    // A full FIFO is readable already, so a failed write is not a lost wake-up
+    std::uint64_t const value = 1;
+    ssize_t rc;
+    do {
+        rc = ::write(_write_fd, &value, _fifo ? 1 : sizeof(value));
+    } while (rc < 0 && errno == EINTR);
+}
+
+void wakeup_fd_t::clear() noexcept {
+    if (_fifo) {
+        drain(_read_fd);
+        return;
+    }
+    std::uint64_t value;
+    ssize_t rc;
+    do {
+        rc = ::read(_read_fd, &value, sizeof(value));
+    } while (rc < 0 && errno == EINTR);
+}
+
+#elif !defined(WIN32)
+
+wakeup_fd_t::wakeup_fd_t() {
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to create pipe");
+    }
+    for (auto const fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    _read_fd = fds[0];
+    _write_fd = fds[1];
+}
+
+wakeup_fd_t::~wakeup_fd_t() noexcept {
+    ::close(_read_fd);
+    if (_write_fd != _read_fd) {
+        ::close(_write_fd);
+    }
+}
+
+void wakeup_fd_t::signal() noexcept {
+    char const value = 1;
+    ssize_t rc;
+    do {
+        rc = ::write(_write_fd, &value, sizeof(value));
+    } while (rc < 0 && errno == EINTR);
+}
+
+void wakeup_fd_t::clear() noexcept { drain(_read_fd); }
+
+#else
+
+wakeup_fd_t::wakeup_fd_t() { throw std::runtime_error("Wake-up descriptors are not supported on this platform"); }
+
+wakeup_fd_t::wakeup_fd_t(char const*) {
+    throw std::runtime_error("Wake-up descriptors are not supported on this platform");
+}
+
+wakeup_fd_t::~wakeup_fd_t() noexcept {}
+
+void wakeup_fd_t::signal() noexcept {}
+
+void wakeup_fd_t::clear() noexcept {}
+
+#endif
+
+}  // namespace detail
+}  // namespace zmqzext
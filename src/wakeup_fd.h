@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2025 Luan Young
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file wakeup_fd.h
+ * @brief Pollable file descriptor used to wake up a poller from another thread
+ *
+ * The wakeup_fd_t class wraps an eventfd (Linux) or a non-blocking pipe (other
+ * POSIX systems) that can be registered in a poller_t or loop_t as a raw file
+ * descriptor. Producers call signal() and the consumer calls clear() once it
+ * has processed all pending work. A named FIFO can be used instead to wake up
+ * a poller of another process.
+ *
+ * @note Private header, not installed with the library.
+ *
+ * @authors
+ * Luan Young (luanpy@gmail.com)
+ *
+ * @copyright 2026 Luan Young
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <zmq.hpp>
+
+namespace zmqzext {
+namespace detail {
+
+/**
+ * @brief Pollable wake-up descriptor
+ *
+ * The descriptor becomes readable after signal() and stays readable until
+ * clear() is called. Both operations are non-blocking and async-signal-safe.
+ *
+ * @note signal() and clear() may be called from different threads.
+ */
+class wakeup_fd_t {
+public:
+    /**
+     * @brief Create the underlying descriptor(s)
+     * @throws std::system_error if the descriptor cannot be created
+     * @throws std::runtime_error on platforms without eventfd or pipe support
+     */
+    wakeup_fd_t();
+
+    /**
+     * @brief Open an existing named FIFO, shared with other processes, as the descriptor
+     *
+     * @param fifo_path Path of the FIFO, created with mkfifo()
+     * @throws std::system_error if the FIFO cannot be opened
+     * @throws std::runtime_error on platforms without named FIFO support
+     */
+    explicit wakeup_fd_t(char const* fifo_path);
+
+    wakeup_fd_t(wakeup_fd_t const&) = delete;
+    wakeup_fd_t& operator=(wakeup_fd_t const&) = delete;
+
+    ~wakeup_fd_t() noexcept;
+
+    /**
+     * @brief Get the descriptor to be polled for reading
+     */
+    zmq::fd_t fd() const noexcept { return _read_fd; }
+
+    /**
+     * @brief Make the descriptor readable
+     */
+    void signal() noexcept;
+
+    /**
+     * @brief Consume all pending signals so the descriptor is no longer readable
+     */
+    void clear() noexcept;
+
+private:
+    zmq::fd_t _read_fd{-1};   ///< Descriptor polled by the consumer
+    zmq::fd_t _write_fd{-1};  ///< Descriptor written by producers (same as _read_fd for eventfd and FIFO)
+    bool _fifo{false};        ///< Whether the descriptor is a named FIFO
+};
+
+}  // namespace detail
+}  // namespace zmqzext
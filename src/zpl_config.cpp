@@ -38,7 +38,9 @@ SOFTWARE.
 
 #include <cctype>
 #include <fstream>
+#include <memory_resource>
 #include <sstream>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -51,15 +53,22 @@ std::string const k_empty_string;
 
 /// Internal node representation for the parsed ZPL tree.
 struct zpl_node_t {
+    explicit zpl_node_t(std::pmr::memory_resource* resource) : ordered_children(resource), children_by_name(resource) {}
+
     std::string name;                ///< Node name segment
     std::string value;               ///< Raw string value
     bool explicitly_defined{false};  ///< True when this node appears explicitly in the input.
                                      ///< Nodes created only as path containers (e.g., from "a/b")
                                      ///< keep this false unless their own property line is present.
-    std::vector<std::shared_ptr<zpl_node_t>> ordered_children;                      ///< Children in source order
-    std::unordered_map<std::string, std::shared_ptr<zpl_node_t>> children_by_name;  ///< Fast lookup
+    std::pmr::vector<std::shared_ptr<zpl_node_t>> ordered_children;                           ///< Children in order
+    std::pmr::unordered_map<std::string_view, std::shared_ptr<zpl_node_t>> children_by_name;  ///< Lookup by child name
 };
 
+/// Allocate a node, its control block and its containers from a memory resource.
+std::shared_ptr<zpl_node_t> make_node(std::pmr::memory_resource* resource) {
+    return std::allocate_shared<zpl_node_t>(std::pmr::polymorphic_allocator<zpl_node_t>(resource), resource);
+}
+
 /// Parsed line information after trimming, indentation checks and value parsing.
 struct parsed_line_t {
     std::size_t indent_level;  ///< Indentation level (4-space units)
@@ -264,7 +273,7 @@ parsed_line_t parse_line(const std::string& line, std::size_t line_number) {
 }
 
 /// Parse the entire input stream into a ZPL tree root node.
-std::shared_ptr<zpl_node_t> parse_stream(std::istream& input) {
+std::shared_ptr<zpl_node_t> parse_stream(std::istream& input, std::pmr::memory_resource* resource) {
     std::ostringstream buffer;
     buffer << input.rdbuf();
     if (input.bad()) {
@@ -274,7 +283,7 @@ std::shared_ptr<zpl_node_t> parse_stream(std::istream& input) {
         throw std::ios_base::failure("failed while reading stream");
     }
 
-    auto root = std::make_shared<zpl_node_t>();
+    auto root = make_node(resource);
     std::vector<std::shared_ptr<zpl_node_t>> stack;
     stack.push_back(root);
 
@@ -311,10 +320,10 @@ std::shared_ptr<zpl_node_t> parse_stream(std::istream& input) {
             const bool is_last = (segment_idx + 1 == segments.size());
             const auto found = current->children_by_name.find(segments[segment_idx]);
             if (found == current->children_by_name.end()) {
-                auto created = std::make_shared<zpl_node_t>();
+                auto created = make_node(resource);
                 created->name = segments[segment_idx];
                 current->ordered_children.push_back(created);
-                current->children_by_name.emplace(segments[segment_idx], created);
+                current->children_by_name.emplace(created->name, created);
                 current = created;
             } else {
                 current = found->second;
@@ -337,59 +346,85 @@ std::shared_ptr<zpl_node_t> parse_stream(std::istream& input) {
     return root;
 }
 
-/// Find a node by path segments starting from a given node.
-std::shared_ptr<zpl_node_t> find_node(const std::shared_ptr<zpl_node_t>& start, const std::string& path) {
+/// Find a node by path from a given node, following the rules of split_segments() without allocating.
+std::shared_ptr<zpl_node_t> find_node(const std::shared_ptr<zpl_node_t>& start, std::string_view path) {
     if (!start) {
         return nullptr;
     }
 
-    bool valid = false;
-    const auto segments = split_segments(path, valid);
-    if (!valid) {
-        return nullptr;
+    std::size_t pos = path.find_first_not_of('/');
+    if (pos == std::string_view::npos) {
+        return start;
     }
 
-    auto current = start;
-    for (const auto& segment : segments) {
-        const auto found = current->children_by_name.find(segment);
-        if (found == current->children_by_name.end()) {
+    const std::shared_ptr<zpl_node_t>* current = &start;
+    while (true) {
+        const std::size_t slash = path.find('/', pos);
+        const std::size_t end = (slash == std::string_view::npos) ? path.size() : slash;
+        if (end == pos) {
+            return nullptr;
+        }
+
+        const auto found = (*current)->children_by_name.find(path.substr(pos, end - pos));
+        if (found == (*current)->children_by_name.end()) {
+            return nullptr;
+        }
+        current = &found->second;
+
+        if (slash == std::string_view::npos) {
+            break;
+        }
+        pos = slash + 1;
+        if (pos == path.size()) {
             return nullptr;
         }
-        current = found->second;
     }
 
-    return current;
+    return *current;
 }
 
 }  // namespace
 
 struct zpl_config_t::impl_t {
-    std::shared_ptr<zpl_node_t> node;  ///< Root node for the parsed tree
+    std::shared_ptr<zpl_node_t> node;     ///< Root node for the parsed tree
+    std::pmr::memory_resource* resource;  ///< Memory resource of the tree
+
+    /// Make a configuration viewing a node of the same tree.
+    zpl_config_t view(std::shared_ptr<zpl_node_t> target) const {
+        return zpl_config_t{std::allocate_shared<impl_t>(std::pmr::polymorphic_allocator<impl_t>(resource),
+                                                         impl_t{std::move(target), resource})};
+    }
 };
 
 zpl_parse_error::zpl_parse_error(std::string message, std::size_t line) : zpl_error(std::move(message)), _line(line) {}
 
 std::size_t zpl_parse_error::line() const noexcept { return _line; }
 
-zpl_config_t::zpl_config_t() noexcept : _impl(std::make_shared<impl_t>()) {
-    _impl->node = std::make_shared<zpl_node_t>();
+zpl_config_t::zpl_config_t() noexcept : zpl_config_t(std::pmr::get_default_resource()) {}
+
+zpl_config_t::zpl_config_t(std::pmr::memory_resource* resource)
+    : _impl(std::allocate_shared<impl_t>(std::pmr::polymorphic_allocator<impl_t>(resource),
+                                         impl_t{make_node(resource), resource})) {}
+
+zpl_config_t::zpl_config_t(std::istream& input, std::pmr::memory_resource* resource) : zpl_config_t(resource) {
+    load(input);
 }
 
-zpl_config_t::zpl_config_t(std::istream& input) : _impl(std::make_shared<impl_t>()) { load(input); }
+zpl_config_t::zpl_config_t(std::shared_ptr<impl_t> impl) noexcept : _impl(std::move(impl)) {}
 
-zpl_config_t zpl_config_t::from_stream(std::istream& input) {
-    zpl_config_t config;
+zpl_config_t zpl_config_t::from_stream(std::istream& input, std::pmr::memory_resource* resource) {
+    zpl_config_t config{resource};
     config.load(input);
     return config;
 }
 
-zpl_config_t zpl_config_t::from_file(const std::string& file_path) {
-    zpl_config_t config;
+zpl_config_t zpl_config_t::from_file(const std::string& file_path, std::pmr::memory_resource* resource) {
+    zpl_config_t config{resource};
     config.load_from_file(file_path);
     return config;
 }
 
-void zpl_config_t::load(std::istream& input) { _impl->node = parse_stream(input); }
+void zpl_config_t::load(std::istream& input) { _impl->node = parse_stream(input, _impl->resource); }
 
 void zpl_config_t::load_from_file(const std::string& file_path) {
     std::ifstream file(file_path);
@@ -449,9 +484,7 @@ zpl_config_t zpl_config_t::child(const std::string& path) const {
         throw zpl_property_not_found("property not found: " + path);
     }
 
-    zpl_config_t result;
-    result._impl->node = std::move(node);
-    return result;
+    return _impl->view(std::move(node));
 }
 
 std::optional<zpl_config_t> zpl_config_t::try_child(const std::string& path) const noexcept {
@@ -460,9 +493,7 @@ std::optional<zpl_config_t> zpl_config_t::try_child(const std::string& path) con
         return std::nullopt;
     }
 
-    zpl_config_t result;
-    result._impl->node = std::move(node);
-    return result;
+    return _impl->view(std::move(node));
 }
 
 std::vector<zpl_config_t> zpl_config_t::children() const noexcept {
@@ -473,9 +504,7 @@ std::vector<zpl_config_t> zpl_config_t::children() const noexcept {
     std::vector<zpl_config_t> result;
     result.reserve(_impl->node->ordered_children.size());
     for (const auto& node : _impl->node->ordered_children) {
-        zpl_config_t child;
-        child._impl->node = node;
-        result.push_back(std::move(child));
+        result.push_back(_impl->view(node));
     }
     return result;
 }
@@ -1,5 +1,6 @@
 #include <cppzmqzoltanext/actor.h>
 #include <cppzmqzoltanext/helpers.h>
+#include <cppzmqzoltanext/histogram.h>
 #include <cppzmqzoltanext/interrupt.h>
 #include <cppzmqzoltanext/loop.h>
 #include <cppzmqzoltanext/signal.h>
@@ -415,6 +416,43 @@ TEST_F(UTestActorWithInterruptHandler, ActorsMaySetLoopToNotInterruptibleModeSoP
     EXPECT_FALSE(result.has_value());
 }
 
+TEST_F(UTestActor, UsageReportsTheCpuTimeOfTheActorThread) {
+    actor_t actor(ctx);
+    EXPECT_EQ(std::chrono::nanoseconds{0}, actor.usage().cpu_time);
+
+    actor.start([this](zmq::socket_t& socket) {
+        send_retry_on_eintr(socket, signal_t::create_success(), zmq::send_flags::none);
+        auto const until = std::chrono::steady_clock::now() + 30ms;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        return processMessagesUntilStop(socket);
+    });
+#if defined(__linux__)
+    std::this_thread::sleep_for(40ms);
+    EXPECT_GE(actor.usage().cpu_time, 10ms);
+#endif
+    actor.stop();
+
+    EXPECT_GE(actor.usage().cpu_time, 10ms);
+}
+
+TEST_F(UTestActor, RecordsThePipeRoundTripsIntoHistogram) {
+    histogram_t histogram;
+    actor_t actor(ctx);
+    actor.set_round_trip_histogram(&histogram);
+
+    actor.start([this](zmq::socket_t& socket) {
+        std::this_thread::sleep_for(5ms);
+        send_retry_on_eintr(socket, signal_t::create_success(), zmq::send_flags::none);
+        return processMessagesUntilStop(socket);
+    });
+    EXPECT_EQ(1U, histogram.snapshot().count());
+    EXPECT_GE(histogram.snapshot().max(), static_cast<std::uint64_t>(std::chrono::nanoseconds{5ms}.count()));
+
+    EXPECT_TRUE(actor.stop());
+    EXPECT_EQ(2U, histogram.snapshot().count());
+}
+
 TEST_F(UTestActor, IsMoveConstructibleBeforeStart) {
     actor_t actor{ctx};
     std::string const msgStrToSend{"Test message"};
@@ -0,0 +1,282 @@
+#include <cppzmqzoltanext/broker.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/reliable_client.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestBroker : public ::testing::Test {
+public:
+    using frames_t = std::vector<std::string>;
+
+    UTestBroker() {
+        options.heartbeat_interval = std::chrono::milliseconds{10};
+        options.heartbeat_liveness = 2;
+    }
+
+    zmq::socket_t connect_peer() {
+        zmq::socket_t socket{ctx, zmq::socket_type::dealer};
+        socket.set(zmq::sockopt::linger, 0);
+        socket.connect("inproc://broker");
+        return socket;
+    }
+
+    static void send_frames(zmq::socket_ref socket, frames_t const& frames) {
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            socket.send(zmq::buffer(frames[i]), i + 1 < frames.size() ? zmq::send_flags::sndmore
+                                                                        : zmq::send_flags::none);
+        }
+    }
+
+    static frames_t recv_frames(zmq::socket_ref socket) {
+        waitSocketHaveMsg(socket, std::chrono::milliseconds{1000});
+        frames_t frames;
+        zmq::message_t msg;
+        do {
+            if (!socket.recv(msg, zmq::recv_flags::dontwait)) {
+                throw std::runtime_error("No message");
+            }
+            frames.push_back(msg.to_string());
+        } while (msg.more());
+        return frames;
+    }
+
+    static bool has_msg(zmq::socket_ref socket) { return (socket.get(zmq::sockopt::events) & ZMQ_POLLIN) != 0; }
+
+    static std::string command(mdp_command_t cmd) { return std::string(1, static_cast<char>(cmd)); }
+
+    static void send_ready(zmq::socket_ref worker, std::string const& service) {
+        send_frames(worker, {"", mdp_worker_header, command(mdp_command_t::ready), service});
+    }
+
+    /// Let the broker handle the messages already sent
+    void pump(std::chrono::milliseconds duration = std::chrono::milliseconds{2}) {
+        // A timer stopping the loop is not consumed, so it is removed for the next runs
+        loop.add_timer(duration, 1, [](loop_t& loop, timer_id_t id) {
+            loop.remove_timer(id);
+            return false;
+        });
+        loop.run(false);
+    }
+
+    zmq::context_t ctx;
+    loop_t loop;
+    broker_options_t options;
+};
+
+TEST_F(UTestBroker, RoutesRequestToWorkerAndReplyToClient) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    auto client = connect_peer();
+
+    send_ready(worker, "echo");
+    pump();
+    EXPECT_EQ(broker.worker_count(), 1u);
+    EXPECT_EQ(broker.waiting_workers("echo"), 1u);
+
+    send_frames(client, {"", mdp_client_header, "echo", "hello", "world"});
+    pump();
+    auto request = recv_frames(worker);
+    ASSERT_EQ(request.size(), 7u);
+    EXPECT_EQ(request[0], "");
+    EXPECT_EQ(request[1], mdp_worker_header);
+    EXPECT_EQ(request[2], command(mdp_command_t::request));
+    EXPECT_EQ(request[4], "");
+    EXPECT_EQ(request[5], "hello");
+    EXPECT_EQ(request[6], "world");
+    EXPECT_EQ(broker.waiting_workers("echo"), 0u);
+
+    send_frames(worker, {"", mdp_worker_header, command(mdp_command_t::reply), request[3], "", "re:hello"});
+    pump();
+
+    EXPECT_EQ(recv_frames(client), (frames_t{"", mdp_client_header, "echo", "re:hello"}));
+    EXPECT_EQ(broker.waiting_workers("echo"), 1u);
+}
+
+TEST_F(UTestBroker, QueuesRequestsUntilWorkerIsReady) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    auto client = connect_peer();
+
+    send_frames(client, {"", mdp_client_header, "echo", "1"});
+    send_frames(client, {"", mdp_client_header, "echo", "2"});
+    pump();
+    EXPECT_EQ(broker.pending_requests("echo"), 2u);
+
+    send_ready(worker, "echo");
+    pump();
+
+    EXPECT_EQ(recv_frames(worker).back(), "1");
+    EXPECT_FALSE(has_msg(worker));
+    EXPECT_EQ(broker.pending_requests("echo"), 1u);
+}
+
+TEST_F(UTestBroker, RoutesRequestsByServiceName) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker_a = connect_peer();
+    auto worker_b = connect_peer();
+    auto client = connect_peer();
+    send_ready(worker_a, "a");
+    send_ready(worker_b, "b");
+    pump();
+
+    send_frames(client, {"", mdp_client_header, "b", "for b"});
+    send_frames(client, {"", mdp_client_header, "a", "for a"});
+    pump();
+
+    EXPECT_EQ(broker.service_count(), 2u);
+    EXPECT_EQ(recv_frames(worker_a).back(), "for a");
+    EXPECT_EQ(recv_frames(worker_b).back(), "for b");
+}
+
+TEST_F(UTestBroker, SupportsReliableClientEnvelope) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    send_ready(worker, "echo");
+    loop.add(worker, [](loop_t&, zmq::socket_ref socket) {
+        auto request = recv_frames(socket);
+        if (request[2] == command(mdp_command_t::request)) {
+            request[2] = command(mdp_command_t::reply);
+            request.back() = "re:" + request.back();
+            send_frames(socket, request);
+        }
+        return true;
+    });
+    reliable_client_options_t client_options;
+    client_options.endpoints = {"inproc://broker"};
+    reliable_client_t client{ctx, loop, client_options};
+    std::vector<std::string> replies;
+
+    for (auto const* body : {"a", "b", "c"}) {
+        std::vector<zmq::message_t> frames;
+        frames.emplace_back(std::string{mdp_client_header});
+        frames.emplace_back(std::string{"echo"});
+        frames.emplace_back(std::string{body});
+        client.request(std::move(frames), [&](request_result_t result, std::vector<zmq::message_t>& reply) {
+            ASSERT_EQ(result, request_result_t::reply);
+            ASSERT_EQ(reply.size(), 3u);
+            EXPECT_EQ(reply[1].to_string(), "echo");
+            replies.push_back(reply[2].to_string());
+            if (replies.size() == 3) {
+                loop.add_timer(std::chrono::milliseconds{1}, 1, [](loop_t&, timer_id_t) { return false; });
+            }
+        });
+    }
+    loop.add_timer(std::chrono::milliseconds{2000}, 1, [](loop_t&, timer_id_t) { return false; });
+    loop.run(false);
+    loop.remove(worker);
+
+    EXPECT_EQ(replies, (std::vector<std::string>{"re:a", "re:b", "re:c"}));
+}
+
+TEST_F(UTestBroker, ExpiresSilentWorkersAfterHeartbeats) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    send_ready(worker, "echo");
+    pump();
+    EXPECT_EQ(broker.worker_count(), 1u);
+
+    pump(std::chrono::milliseconds{60});
+
+    EXPECT_EQ(broker.worker_count(), 0u);
+    EXPECT_EQ(broker.waiting_workers("echo"), 0u);
+    EXPECT_EQ(recv_frames(worker), (frames_t{"", mdp_worker_header, command(mdp_command_t::heartbeat)}));
+}
+
+TEST_F(UTestBroker, ExpiresBusyWorkersThatStopSendingHeartbeats) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    auto client = connect_peer();
+    send_ready(worker, "echo");
+    send_frames(client, {"", mdp_client_header, "echo", "hello"});
+    pump();
+    EXPECT_EQ(recv_frames(worker).back(), "hello");
+    EXPECT_EQ(broker.waiting_workers("echo"), 0u);
+
+    pump(std::chrono::milliseconds{60});
+
+    EXPECT_EQ(broker.worker_count(), 0u);
+    EXPECT_EQ(broker.waiting_workers("echo"), 0u);
+}
+
+TEST_F(UTestBroker, DropsRequestsWaitingLongerThanTimeout) {
+    options.request_timeout = std::chrono::milliseconds{20};
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    auto client = connect_peer();
+    send_frames(client, {"", mdp_client_header, "unknown", "1"});
+    send_frames(client, {"", mdp_client_header, "echo", "2"});
+    pump();
+    EXPECT_EQ(broker.service_count(), 2u);
+
+    pump(std::chrono::milliseconds{40});
+
+    EXPECT_EQ(broker.service_count(), 0u);
+    EXPECT_EQ(broker.pending_requests("unknown"), 0u);
+    send_ready(worker, "echo");
+    pump();
+    EXPECT_FALSE(has_msg(worker));
+    EXPECT_EQ(broker.waiting_workers("echo"), 1u);
+}
+
+TEST_F(UTestBroker, HeartbeatsKeepWorkersAlive) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto worker = connect_peer();
+    send_ready(worker, "echo");
+    loop.add_timer(std::chrono::milliseconds{5}, 12, [&](loop_t&, timer_id_t) {
+        send_frames(worker, {"", mdp_worker_header, command(mdp_command_t::heartbeat)});
+        return true;
+    });
+
+    pump(std::chrono::milliseconds{60});
+
+    EXPECT_EQ(broker.worker_count(), 1u);
+}
+
+TEST_F(UTestBroker, DisconnectsWorkersBreakingProtocol) {
+    broker_t broker{ctx, loop, options};
+    broker.bind("inproc://broker");
+    auto unknown = connect_peer();
+    auto worker = connect_peer();
+
+    send_frames(unknown, {"", mdp_worker_header, command(mdp_command_t::heartbeat)});
+    send_ready(worker, "echo");
+    send_ready(worker, "echo");
+    pump();
+
+    EXPECT_EQ(recv_frames(unknown), (frames_t{"", mdp_worker_header, command(mdp_command_t::disconnect)}));
+    EXPECT_EQ(recv_frames(worker), (frames_t{"", mdp_worker_header, command(mdp_command_t::disconnect)}));
+    EXPECT_EQ(broker.worker_count(), 0u);
+}
+
+TEST_F(UTestBroker, ThrowsOnInvalidOptions) {
+    options.heartbeat_interval = std::chrono::milliseconds{0};
+    EXPECT_THROW(broker_t(ctx, loop, options), std::invalid_argument);
+
+    options.heartbeat_interval = std::chrono::milliseconds{10};
+    options.heartbeat_liveness = 0;
+    EXPECT_THROW(broker_t(ctx, loop, options), std::invalid_argument);
+
+    options.heartbeat_liveness = 2;
+    options.request_timeout = std::chrono::milliseconds{0};
+    EXPECT_THROW(broker_t(ctx, loop, options), std::invalid_argument);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,176 @@
+#include <cppzmqzoltanext/coalescing_sender.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestCoalescingSender : public ::testing::Test {
+public:
+    UTestCoalescingSender() : socketPull{ctx, zmq::socket_type::pull}, socketPush{ctx, zmq::socket_type::push} {
+        socketPull.set(zmq::sockopt::linger, 0);
+        socketPush.set(zmq::sockopt::linger, 0);
+        socketPull.bind("inproc://coalescing-sender");
+        socketPush.connect("inproc://coalescing-sender");
+    }
+
+    static std::vector<std::string> split(zmq::message_t const& batch) {
+        std::vector<std::string> records;
+        batch_reader_t reader{batch};
+        zmq::const_buffer record;
+        while (reader.next(record)) {
+            records.emplace_back(static_cast<char const*>(record.data()), record.size());
+        }
+        return records;
+    }
+
+    /// Receive batches in the loop until the expected number of records was received
+    void receive_in_loop(std::size_t records) {
+        loop.add(socketPull, [this, records](loop_t&, zmq::socket_ref socket) {
+            batches.push_back(recv_now_or_throw(socket));
+            for (auto& record : split(batches.back())) {
+                received.push_back(std::move(record));
+            }
+            return received.size() < records;
+        });
+        loop.run(false);
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t socketPull;
+    zmq::socket_t socketPush;
+    loop_t loop;
+    std::vector<zmq::message_t> batches;
+    std::vector<std::string> received;
+};
+
+TEST_F(UTestCoalescingSender, FlushesWhenBatchReachesThreshold) {
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{32, std::chrono::milliseconds{1000}}};
+
+    for (int i = 0; i < 4; ++i) {
+        sender.send(zmq::str_buffer("record-"));
+    }
+
+    EXPECT_EQ(sender.pending_records(), 0u);
+    auto const batch = recv_now_or_throw(socketPull);
+    EXPECT_EQ(batch.size(), 32u);
+    EXPECT_EQ(split(batch), std::vector<std::string>(4, "record-"));
+}
+
+TEST_F(UTestCoalescingSender, FlushesPendingRecordsOnTimer) {
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{1024, std::chrono::milliseconds{10}}};
+    sender.send(zmq::str_buffer("a"));
+    sender.send(zmq::str_buffer(""));
+    sender.send(zmq::str_buffer("c"));
+    EXPECT_EQ(sender.pending_records(), 3u);
+    EXPECT_FALSE(socketPull.recv(batches.emplace_back(), zmq::recv_flags::dontwait));
+    batches.clear();
+
+    auto const start = std::chrono::steady_clock::now();
+    receive_in_loop(3);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{10});
+    EXPECT_EQ(batches.size(), 1u);
+    EXPECT_EQ(received, (std::vector<std::string>{"a", "", "c"}));
+    EXPECT_EQ(sender.pending_records(), 0u);
+}
+
+TEST_F(UTestCoalescingSender, SendsLargeRecordInItsOwnBatchAfterPendingRecords) {
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{64, std::chrono::milliseconds{1000}}};
+    std::string const large(1000, 'x');
+
+    sender.send(zmq::str_buffer("small"));
+    sender.send(zmq::buffer(large));
+
+    EXPECT_EQ(split(recv_now_or_throw(socketPull)), std::vector<std::string>{"small"});
+    EXPECT_EQ(split(recv_now_or_throw(socketPull)), std::vector<std::string>{large});
+}
+
+TEST_F(UTestCoalescingSender, KeepsBatchAndFlushesWhenSocketIsWritableAgain) {
+    // High water marks apply to the connections made after they are set
+    socketPull.set(zmq::sockopt::rcvhwm, 1);
+    socketPush.set(zmq::sockopt::sndhwm, 1);
+    socketPull.bind("inproc://coalescing-sender-hwm");
+    socketPush.disconnect("inproc://coalescing-sender");
+    socketPush.connect("inproc://coalescing-sender-hwm");
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{16, std::chrono::milliseconds{1000}}};
+    std::size_t const count = 200;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        sender.send(zmq::buffer(std::to_string(i)));
+    }
+    EXPECT_GT(sender.pending_records(), 0u);
+    EXPECT_FALSE(sender.flush());
+
+    receive_in_loop(count);
+
+    ASSERT_EQ(received.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+}
+
+TEST_F(UTestCoalescingSender, RefusesRecordsWhileBlockedBeyondMaxBlockedSize) {
+    socketPull.set(zmq::sockopt::rcvhwm, 1);
+    socketPush.set(zmq::sockopt::sndhwm, 1);
+    socketPull.bind("inproc://coalescing-sender-blocked");
+    socketPush.disconnect("inproc://coalescing-sender");
+    socketPush.connect("inproc://coalescing-sender-blocked");
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{16, std::chrono::milliseconds{1000}, 256}};
+
+    std::size_t accepted = 0;
+    while (sender.send(zmq::buffer(std::to_string(accepted)))) {
+        ++accepted;
+        ASSERT_LT(accepted, 10000u);
+    }
+    EXPECT_GE(sender.pending_bytes(), 256u);
+    EXPECT_LT(sender.pending_bytes(), 256u + 16u);
+
+    receive_in_loop(accepted);
+
+    ASSERT_EQ(received.size(), accepted);
+    for (std::size_t i = 0; i < accepted; ++i) {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+    EXPECT_TRUE(sender.send(zmq::str_buffer("after")));
+}
+
+TEST_F(UTestCoalescingSender, EncodesLongRecordSizes) {
+    coalescing_sender_t sender{loop, socketPush, coalescing_options_t{1024 * 1024, std::chrono::milliseconds{1000}}};
+    std::string const record(300, 'y');
+
+    sender.send(zmq::buffer(record));
+    sender.send(zmq::buffer(record));
+    EXPECT_EQ(sender.pending_bytes(), 2 * (2 + record.size()));
+    EXPECT_TRUE(sender.flush());
+
+    EXPECT_EQ(split(recv_now_or_throw(socketPull)), std::vector<std::string>(2, record));
+}
+
+TEST_F(UTestCoalescingSender, ReaderRejectsMalformedBatches) {
+    zmq::const_buffer record;
+    batch_reader_t truncated_size{zmq::str_buffer("\x85")};
+    EXPECT_THROW(truncated_size.next(record), std::runtime_error);
+    batch_reader_t truncated_record{zmq::str_buffer("\x05" "abc")};
+    EXPECT_THROW(truncated_record.next(record), std::runtime_error);
+    batch_reader_t empty{zmq::const_buffer{}};
+    EXPECT_FALSE(empty.next(record));
+}
+
+TEST_F(UTestCoalescingSender, RejectsInvalidArguments) {
+    EXPECT_THROW(coalescing_sender_t(loop, zmq::socket_ref{}), std::invalid_argument);
+    EXPECT_THROW(coalescing_sender_t(loop, socketPush, coalescing_options_t{0, std::chrono::milliseconds{1}}),
+                 std::invalid_argument);
+    EXPECT_THROW(coalescing_sender_t(loop, socketPush, coalescing_options_t{16, std::chrono::milliseconds{-1}}),
+                 std::invalid_argument);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,174 @@
+#include <cppzmqzoltanext/event_recorder.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestEventRecorder : public ::testing::Test {
+public:
+    UTestEventRecorder()
+        : path{std::string{::testing::TempDir()} + "czze-test-recording-" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name()},
+          socketPull{ctx, zmq::socket_type::pull},
+          socketPush{ctx, zmq::socket_type::push} {
+        socketPull.set(zmq::sockopt::linger, 0);
+        socketPush.set(zmq::sockopt::linger, 0);
+        socketPull.bind("inproc://event-recorder");
+        socketPush.connect("inproc://event-recorder");
+    }
+
+    ~UTestEventRecorder() override { std::remove(path.c_str()); }
+
+    /// Record the given messages on channel 1, then a single timer expiration on channel 2
+    void record(std::vector<std::string> const& messages) {
+        event_recorder_t recorder{path};
+        std::size_t received = 0;
+        recorder.add(loop, socketPull, 1, [&](loop_t&, event_channel_t, std::vector<zmq::message_t>&) {
+            return ++received < messages.size();
+        });
+        for (auto const& message : messages) {
+            send_now_or_throw(socketPush, message);
+        }
+        loop.run(false);
+        loop.remove(socketPull);
+        recorder.add_timer(loop, std::chrono::milliseconds{1}, 1, 2, [](loop_t&, timer_id_t) { return true; });
+        loop.run(false);
+    }
+
+    std::string const path;
+    zmq::context_t ctx;
+    zmq::socket_t socketPull;
+    zmq::socket_t socketPush;
+    loop_t loop;
+};
+
+TEST_F(UTestEventRecorder, ReplayFeedsTheRecordedEventsToTheHandlers) {
+    {
+        event_recorder_t recorder{path};
+        recorder.add(loop, socketPull, 7, [](loop_t&, event_channel_t channel, std::vector<zmq::message_t>& frames) {
+            EXPECT_EQ(7, channel);
+            EXPECT_EQ(2, frames.size());
+            return false;
+        });
+        auto const timerId = recorder.add_timer(loop, std::chrono::milliseconds{1}, 1, 9, [&](loop_t&, timer_id_t) {
+            socketPush.send(zmq::str_buffer("header"), zmq::send_flags::sndmore);
+            send_now_or_throw(socketPush, "payload");
+            return true;
+        });
+        EXPECT_EQ(1, timerId);
+        loop.run(false);
+        EXPECT_EQ(2, recorder.events());
+    }
+
+    event_replayer_t replayer{path};
+    std::vector<std::string> replayed;
+    replayer.on_message(7, [&](loop_t&, event_channel_t channel, std::vector<zmq::message_t>& frames) {
+        EXPECT_EQ(7, channel);
+        for (auto const& frame : frames) {
+            replayed.push_back(frame.to_string());
+        }
+        return true;
+    });
+    replayer.on_timer(9, [&](loop_t&, timer_id_t timer_id) {
+        replayed.push_back("timer " + std::to_string(timer_id));
+        return true;
+    });
+    auto const stats = replayer.replay(loop, replay_speed_t::fastest);
+
+    EXPECT_EQ((std::vector<std::string>{"timer 1", "header", "payload"}), replayed);
+    EXPECT_EQ(1, stats.messages);
+    EXPECT_EQ(1, stats.timers);
+    EXPECT_EQ(0, stats.skipped);
+}
+
+TEST_F(UTestEventRecorder, RecordedSpeedReproducesTheIntervalsBetweenEvents) {
+    {
+        event_recorder_t recorder{path};
+        recorder.add_timer(loop, std::chrono::milliseconds{20}, 3, 1, [](loop_t&, timer_id_t) { return true; });
+        loop.run(false);
+    }
+
+    event_replayer_t replayer{path};
+    std::vector<std::chrono::steady_clock::time_point> times;
+    replayer.on_timer(1, [&](loop_t&, timer_id_t) {
+        times.push_back(std::chrono::steady_clock::now());
+        return true;
+    });
+    auto const start = std::chrono::steady_clock::now();
+    auto const stats = replayer.replay(loop);
+
+    ASSERT_EQ(3, times.size());
+    EXPECT_GE(times[0] - start, std::chrono::milliseconds{20});
+    EXPECT_GE(times[2] - start, std::chrono::milliseconds{60});
+    EXPECT_GE(stats.duration, std::chrono::milliseconds{60});
+
+    // As fast as possible, the same recording takes much less time
+    auto const fastStats = replayer.replay(loop, replay_speed_t::fastest);
+    EXPECT_EQ(3, fastStats.timers);
+    EXPECT_LT(fastStats.duration, std::chrono::milliseconds{20});
+}
+
+TEST_F(UTestEventRecorder, EventsWithoutHandlerAreSkipped) {
+    record({"one", "two", "three"});
+
+    event_replayer_t replayer{path};
+    std::size_t timers = 0;
+    replayer.on_timer(2, [&](loop_t&, timer_id_t) { return ++timers > 0; });
+    auto const stats = replayer.replay(loop, replay_speed_t::fastest);
+
+    EXPECT_EQ(1, timers);
+    EXPECT_EQ(0, stats.messages);
+    EXPECT_EQ(1, stats.timers);
+    EXPECT_EQ(3, stats.skipped);
+}
+
+TEST_F(UTestEventRecorder, HandlerReturningFalseStopsTheReplay) {
+    record({"one", "two", "three"});
+
+    event_replayer_t replayer{path};
+    std::vector<std::string> replayed;
+    replayer.on_message(1, [&](loop_t&, event_channel_t, std::vector<zmq::message_t>& frames) {
+        replayed.push_back(frames.at(0).to_string());
+        return replayed.size() < 2;
+    });
+    auto const stats = replayer.replay(loop, replay_speed_t::fastest);
+
+    EXPECT_EQ((std::vector<std::string>{"one", "two"}), replayed);
+    EXPECT_EQ(2, stats.messages);
+}
+
+TEST_F(UTestEventRecorder, RejectsMissingOrMalformedRecordings) {
+    EXPECT_THROW(event_replayer_t{path}, std::system_error);
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "not a recording";
+    }
+    EXPECT_THROW(event_replayer_t{path}, std::runtime_error);
+
+    record({"message"});
+    {
+        // Truncate the last event
+        std::ifstream in{path, std::ios::binary};
+        std::string content{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+        in.close();
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out << content.substr(0, content.size() - 1);
+    }
+    event_replayer_t replayer{path};
+    replayer.on_timer(2, [](loop_t&, timer_id_t) { return true; });
+    EXPECT_THROW(replayer.replay(loop, replay_speed_t::fastest), std::runtime_error);
+}
+
+}  // namespace zmqzext
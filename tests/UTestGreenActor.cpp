@@ -0,0 +1,222 @@
+#include <cppzmqzoltanext/green_actor.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+namespace zmqzext {
+
+class UTestGreenActor : public ::testing::Test {
+public:
+    /// Run the loop until the condition holds or a timeout, checking it every millisecond
+    bool run_until(std::function<bool()> condition,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds{5000}) {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        auto met = false;
+        loop.add_timer(std::chrono::milliseconds{1}, 0, [&](loop_t& loop, timer_id_t id) {
+            met = condition();
+            if (met || std::chrono::steady_clock::now() >= deadline) {
+                loop.remove_timer(id);
+                return false;
+            }
+            return true;
+        });
+        loop.run(false);
+        return met;
+    }
+
+    loop_t loop;
+    green_scheduler_t scheduler{loop};
+};
+
+TEST_F(UTestGreenActor, HandlesMessagesInOrder) {
+    green_actor_t actor{scheduler};
+    std::vector<std::string> received;
+    actor.start([&](green_actor_t&, zmq::message_t& msg) {
+        received.push_back(msg.to_string());
+        return true;
+    });
+
+    EXPECT_TRUE(actor.send(zmq::str_buffer("a")));
+    EXPECT_TRUE(actor.send(zmq::message_t{std::string{"b"}}));
+    EXPECT_TRUE(actor.send(zmq::str_buffer("c")));
+
+    ASSERT_TRUE(run_until([&] { return received.size() == 3; }));
+    EXPECT_EQ(received, (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(scheduler.handled_messages(), 3u);
+}
+
+TEST_F(UTestGreenActor, ReceivesMessagesFromManyThreads) {
+    std::size_t const actor_count = 50;
+    std::size_t const thread_count = 4;
+    std::size_t const messages_per_actor = 1000;
+    std::vector<green_actor_t> actors;
+    std::vector<std::vector<std::size_t>> next(actor_count, std::vector<std::size_t>(thread_count, 0));
+    std::size_t received = 0;
+    bool in_order = true;
+    for (std::size_t a = 0; a < actor_count; ++a) {
+        actors.emplace_back(scheduler);
+        actors.back().start([&, a](green_actor_t&, zmq::message_t& msg) {
+            auto const* const data = msg.data<std::size_t>();
+            in_order = in_order && data[1] == next[a][data[0]]++;
+            ++received;
+            return true;
+        });
+    }
+
+    std::vector<std::thread> senders;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        senders.emplace_back([&, t] {
+            for (std::size_t i = 0; i < messages_per_actor; ++i) {
+                for (auto& actor : actors) {
+                    std::size_t const content[2] = {t, i};
+                    actor.send(zmq::const_buffer{content, sizeof(content)});
+                }
+            }
+        });
+    }
+    auto const total = actor_count * thread_count * messages_per_actor;
+    auto const done = run_until([&] { return received == total; });
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(scheduler.size(), actor_count);
+}
+
+TEST_F(UTestGreenActor, RunsReadyActorsInRoundRobinBatches) {
+    green_scheduler_t batching{loop, green_scheduler_options_t{2, 4096}};
+    green_actor_t first{batching};
+    green_actor_t second{batching};
+    std::string order;
+    first.start([&](green_actor_t&, zmq::message_t&) {
+        order += 'a';
+        return true;
+    });
+    second.start([&](green_actor_t&, zmq::message_t&) {
+        order += 'b';
+        return true;
+    });
+    for (int i = 0; i < 5; ++i) {
+        first.send(zmq::str_buffer("x"));
+        second.send(zmq::str_buffer("x"));
+    }
+
+    ASSERT_TRUE(run_until([&] { return order.size() == 10; }));
+    EXPECT_EQ(order, "aabbaabbab");
+}
+
+TEST_F(UTestGreenActor, YieldsToTheLoopAfterMaxMessagesPerWakeup) {
+    green_scheduler_t bounded{loop, green_scheduler_options_t{8, 16}};
+    green_actor_t actor{bounded};
+    std::size_t handled = 0;
+    // The actor keeps sending to itself, so it is always ready
+    actor.start([&](green_actor_t& self, zmq::message_t& msg) {
+        ++handled;
+        self.send(std::move(msg));
+        return true;
+    });
+    actor.send(zmq::str_buffer("loop"));
+
+    // The condition is checked by a loop timer, which would never fire if the actor monopolized the loop
+    EXPECT_TRUE(run_until([&] { return handled > 100; }));
+}
+
+TEST_F(UTestGreenActor, StopsWhenHandlerReturnsFalse) {
+    green_actor_t actor{scheduler};
+    std::size_t handled = 0;
+    actor.start([&](green_actor_t&, zmq::message_t&) {
+        ++handled;
+        return false;
+    });
+    actor.send(zmq::str_buffer("first"));
+    actor.send(zmq::str_buffer("discarded"));
+
+    ASSERT_TRUE(run_until([&] { return actor.is_stopped(); }));
+    EXPECT_FALSE(run_until([&] { return handled > 1; }, std::chrono::milliseconds{20}));
+    EXPECT_EQ(handled, 1u);
+    EXPECT_FALSE(actor.send(zmq::str_buffer("refused")));
+}
+
+TEST_F(UTestGreenActor, HandlerExceptionStopsActor) {
+    green_actor_t actor{scheduler};
+    actor.start([&](green_actor_t&, zmq::message_t&) -> bool { throw std::runtime_error("failure"); });
+    actor.send(zmq::str_buffer("boom"));
+
+    EXPECT_TRUE(run_until([&] { return actor.is_stopped(); }));
+}
+
+TEST_F(UTestGreenActor, CanBeDestroyedByItsOwnHandler) {
+    std::map<int, std::unique_ptr<green_actor_t>> sessions;
+    for (int key = 0; key < 3; ++key) {
+        sessions[key] = std::make_unique<green_actor_t>(scheduler);
+        sessions[key]->start([&sessions, key](green_actor_t&, zmq::message_t&) {
+            sessions.erase(key);
+            return true;
+        });
+    }
+    for (auto& session : sessions) {
+        session.second->send(zmq::str_buffer("close"));
+        session.second->send(zmq::str_buffer("pending"));
+    }
+
+    EXPECT_TRUE(run_until([&] { return sessions.empty(); }));
+    EXPECT_EQ(scheduler.size(), 0u);
+}
+
+TEST_F(UTestGreenActor, HandlesManyActors) {
+    std::size_t const count = 100000;
+    std::vector<green_actor_t> actors;
+    actors.reserve(count);
+    std::size_t received = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        actors.emplace_back(scheduler);
+        actors.back().start([&](green_actor_t&, zmq::message_t&) {
+            ++received;
+            return true;
+        });
+        actors.back().send(zmq::str_buffer("hello"));
+    }
+
+    EXPECT_TRUE(run_until([&] { return received == count; }));
+}
+
+TEST_F(UTestGreenActor, FollowsActorLifecycle) {
+    green_actor_t actor{scheduler};
+    EXPECT_FALSE(actor.is_started());
+    EXPECT_FALSE(actor.is_stopped());
+    EXPECT_FALSE(actor.send(zmq::str_buffer("not started")));
+
+    actor.start([](green_actor_t&, zmq::message_t&) { return true; });
+    EXPECT_TRUE(actor.is_started());
+    EXPECT_THROW(actor.start([](green_actor_t&, zmq::message_t&) { return true; }), std::runtime_error);
+
+    green_actor_t moved{std::move(actor)};
+    EXPECT_TRUE(actor.is_started());
+    EXPECT_TRUE(actor.is_stopped());
+    EXPECT_FALSE(actor.send(zmq::str_buffer("moved from")));
+    EXPECT_TRUE(moved.send(zmq::str_buffer("moved to")));
+
+    moved.stop();
+    EXPECT_TRUE(moved.is_stopped());
+    EXPECT_FALSE(moved.send(zmq::str_buffer("stopped")));
+    EXPECT_EQ(scheduler.size(), 1u);
+}
+
+TEST_F(UTestGreenActor, RejectsInvalidOptions) {
+    EXPECT_THROW(green_scheduler_t(loop, green_scheduler_options_t{0, 1}), std::invalid_argument);
+    EXPECT_THROW(green_scheduler_t(loop, green_scheduler_options_t{1, 0}), std::invalid_argument);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,161 @@
+#include <cppzmqzoltanext/histogram.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace zmqzext {
+
+class UTestHistogram : public ::testing::Test {
+public:
+    std::unique_ptr<histogram_t> histogram{std::make_unique<histogram_t>()};
+};
+
+TEST_F(UTestHistogram, EmptySnapshotReportsZeros) {
+    auto const snapshot = histogram->snapshot();
+
+    EXPECT_EQ(0U, snapshot.count());
+    EXPECT_EQ(0U, snapshot.min());
+    EXPECT_EQ(0U, snapshot.max());
+    EXPECT_EQ(0.0, snapshot.mean());
+    EXPECT_EQ(0U, snapshot.value_at_percentile(50.0));
+}
+
+TEST_F(UTestHistogram, SmallValuesAreCountedExactly) {
+    for (std::uint64_t value = 0; value < histogram_t::exact_limit; ++value) {
+        EXPECT_EQ(value, histogram_t::index_of(value));
+        EXPECT_EQ(value, histogram_t::lowest_equivalent_value(value));
+        EXPECT_EQ(value, histogram_t::highest_equivalent_value(value));
+    }
+}
+
+TEST_F(UTestHistogram, BucketsCoverWholeRangeWithoutGaps) {
+    EXPECT_EQ(histogram_t::bucket_count - 1, histogram_t::index_of(std::numeric_limits<std::uint64_t>::max()));
+    EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(),
+              histogram_t::highest_equivalent_value(histogram_t::bucket_count - 1));
+    for (std::size_t index = 1; index < histogram_t::bucket_count; ++index) {
+        ASSERT_EQ(histogram_t::highest_equivalent_value(index - 1) + 1, histogram_t::lowest_equivalent_value(index));
+        ASSERT_EQ(index, histogram_t::index_of(histogram_t::lowest_equivalent_value(index)));
+        ASSERT_EQ(index, histogram_t::index_of(histogram_t::highest_equivalent_value(index)));
+    }
+}
+
+TEST_F(UTestHistogram, ReportedValuesAreWithinRelativePrecision) {
+    std::mt19937_64 gen(42);
+    for (int i = 0; i < 100000; ++i) {
+        auto const value = gen() >> (gen() % 64);
+        auto const index = histogram_t::index_of(value);
+        auto const low = histogram_t::lowest_equivalent_value(index);
+        auto const high = histogram_t::highest_equivalent_value(index);
+        ASSERT_LE(low, value);
+        ASSERT_GE(high, value);
+        ASSERT_LE(static_cast<double>(high - low), static_cast<double>(value) / 128.0);
+    }
+}
+
+TEST_F(UTestHistogram, ReportsPercentilesMinMaxAndMean) {
+    for (std::uint64_t value = 1; value <= 10000; ++value) {
+        histogram->record(value);
+    }
+
+    auto const snapshot = histogram->snapshot();
+
+    EXPECT_EQ(10000U, snapshot.count());
+    EXPECT_EQ(1U, snapshot.min());
+    EXPECT_NEAR(10000.0, static_cast<double>(snapshot.max()), 10000.0 / 128);
+    EXPECT_DOUBLE_EQ(5000.5, snapshot.mean());
+    EXPECT_NEAR(5000.0, static_cast<double>(snapshot.value_at_percentile(50.0)), 5000.0 / 128);
+    EXPECT_NEAR(9900.0, static_cast<double>(snapshot.value_at_percentile(99.0)), 9900.0 / 128);
+    EXPECT_EQ(snapshot.max(), snapshot.value_at_percentile(100.0));
+    EXPECT_EQ(1U, snapshot.value_at_percentile(0.0));
+}
+
+TEST_F(UTestHistogram, RecordsDurationsInNanoseconds) {
+    histogram->record(std::chrono::microseconds{2});
+    histogram->record(std::chrono::nanoseconds{-5});
+
+    auto const snapshot = histogram->snapshot();
+
+    EXPECT_EQ(2U, snapshot.count());
+    EXPECT_EQ(0U, snapshot.min());
+    EXPECT_EQ(2000U, snapshot.sum());
+}
+
+TEST_F(UTestHistogram, SnapshotsAreMergeable) {
+    auto other = std::make_unique<histogram_t>();
+    histogram->record(10);
+    other->record(20);
+    other->record(30);
+
+    auto snapshot = histogram->snapshot();
+    snapshot.merge(other->snapshot());
+
+    EXPECT_EQ(3U, snapshot.count());
+    EXPECT_EQ(60U, snapshot.sum());
+    EXPECT_EQ(10U, snapshot.min());
+    EXPECT_EQ(30U, snapshot.max());
+}
+
+TEST_F(UTestHistogram, SnapshotAndResetStartsOver) {
+    histogram->record(10);
+
+    auto const first = histogram->snapshot_and_reset();
+    histogram->record(20);
+    auto const second = histogram->snapshot();
+
+    EXPECT_EQ(1U, first.count());
+    EXPECT_EQ(10U, first.max());
+    EXPECT_EQ(1U, second.count());
+    EXPECT_EQ(20U, second.min());
+}
+
+TEST_F(UTestHistogram, CountsAllValuesRecordedConcurrently) {
+    std::size_t const numThreads = 4;
+    std::uint64_t const numValues = 100000;
+    std::vector<std::thread> threads;
+    histogram_snapshot_t collected;
+
+    for (std::size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([this, numValues]() {
+            for (std::uint64_t value = 0; value < numValues; ++value) {
+                histogram->record(value);
+            }
+        });
+    }
+    for (int i = 0; i < 10; ++i) {
+        collected.merge(histogram->snapshot_and_reset());
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    collected.merge(histogram->snapshot_and_reset());
+
+    EXPECT_EQ(numThreads * numValues, collected.count());
+    EXPECT_EQ(numThreads * numValues * (numValues - 1) / 2, collected.sum());
+}
+
+TEST_F(UTestHistogram, LoopRecordsHandlerDurationsAndTimerLateness) {
+    auto lateness = std::make_unique<histogram_t>();
+    loop_t loop;
+    loop.set_handler_histogram(histogram.get());
+    loop.set_timer_lateness_histogram(lateness.get());
+    loop.add_timer(std::chrono::milliseconds{1}, 3, [](loop_t&, timer_id_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        return true;
+    });
+
+    loop.run(false);
+
+    auto const durations = histogram->snapshot();
+    EXPECT_EQ(3U, durations.count());
+    EXPECT_LE(2000000U, durations.min());
+    EXPECT_EQ(3U, lateness->snapshot().count());
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,251 @@
+#include <cppzmqzoltanext/journal.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+namespace zmqzext {
+
+class UTestJournal : public ::testing::Test {
+public:
+    void SetUp() override {
+        char dir[] = "/tmp/czze-test-journal-XXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+        directory = dir;
+        options.segment_size = 4096;
+        options.max_spare_segments = 1;
+    }
+
+    void TearDown() override { std::system(("rm -rf " + directory).c_str()); }
+
+    static std::string to_string(journal_entry_t const& entry) {
+        return std::string(static_cast<char const*>(entry.data.data()), entry.data.size());
+    }
+
+    static std::vector<std::string> read_all(journal_t& journal) {
+        std::vector<std::string> result;
+        journal_entry_t entry;
+        while (journal.read(entry)) {
+            result.push_back(to_string(entry));
+        }
+        return result;
+    }
+
+    std::string directory;
+    journal_options_t options;
+};
+
+TEST_F(UTestJournal, AppendsAndReadsFramesInOrder) {
+    journal_t journal{directory, options};
+
+    EXPECT_EQ(journal.append(zmq::str_buffer("first"), true), 1u);
+    zmq::message_t msg{std::string{"second"}};
+    EXPECT_EQ(journal.append(msg), 2u);
+    EXPECT_EQ(journal.next_sequence(), 3u);
+
+    journal_entry_t entry;
+    ASSERT_TRUE(journal.read(entry));
+    EXPECT_EQ(entry.sequence, 1u);
+    EXPECT_EQ(to_string(entry), "first");
+    EXPECT_TRUE(entry.more);
+    ASSERT_TRUE(journal.read(entry));
+    EXPECT_EQ(entry.sequence, 2u);
+    EXPECT_EQ(to_string(entry), "second");
+    EXPECT_FALSE(entry.more);
+    EXPECT_FALSE(journal.read(entry));
+}
+
+TEST_F(UTestJournal, RewindReturnsToFirstUnackedFrame) {
+    journal_t journal{directory, options};
+    journal.append(zmq::str_buffer("a"));
+    journal.append(zmq::str_buffer("b"));
+    journal.append(zmq::str_buffer("c"));
+
+    EXPECT_EQ(read_all(journal).size(), 3u);
+    journal.ack(1);
+    journal.rewind();
+
+    EXPECT_EQ(read_all(journal), (std::vector<std::string>{"b", "c"}));
+}
+
+TEST_F(UTestJournal, AckPastCursorSkipsAckedFrames) {
+    journal_t journal{directory, options};
+    journal.append(zmq::str_buffer("a"));
+    journal.append(zmq::str_buffer("b"));
+    journal.append(zmq::str_buffer("c"));
+
+    journal.ack(2);
+
+    EXPECT_EQ(journal.acked_sequence(), 2u);
+    EXPECT_EQ(read_all(journal), (std::vector<std::string>{"c"}));
+}
+
+TEST_F(UTestJournal, AckThrowsOnSequenceNotAppended) {
+    journal_t journal{directory, options};
+    journal.append(zmq::str_buffer("a"));
+
+    EXPECT_THROW(journal.ack(2), std::invalid_argument);
+    EXPECT_NO_THROW(journal.ack(1));
+    EXPECT_NO_THROW(journal.ack(0));
+    EXPECT_EQ(journal.acked_sequence(), 1u);
+}
+
+TEST_F(UTestJournal, AppendThrowsOnFrameLargerThanSegment) {
+    journal_t journal{directory, options};
+
+    EXPECT_THROW(journal.append(zmq::buffer(std::string(4096, 'x'))), std::invalid_argument);
+    EXPECT_EQ(journal.next_sequence(), 1u);
+}
+
+TEST_F(UTestJournal, ThrowsOnSegmentSizeTooSmall) {
+    options.segment_size = 8;
+
+    EXPECT_THROW(journal_t(directory, options), std::invalid_argument);
+}
+
+TEST_F(UTestJournal, SyncMakesFramesDurableAndCallsCommitHandler) {
+    journal_t journal{directory, options};
+    std::vector<journal_sequence_t> commits;
+    journal.set_commit_handler([&](journal_sequence_t sequence) { commits.push_back(sequence); });
+
+    journal.append(zmq::str_buffer("a"));
+    journal.append(zmq::str_buffer("b"));
+    EXPECT_TRUE(journal.has_pending_commit());
+    EXPECT_EQ(journal.durable_sequence(), 0u);
+
+    journal.sync();
+    journal.sync();
+
+    EXPECT_FALSE(journal.has_pending_commit());
+    EXPECT_EQ(journal.durable_sequence(), 2u);
+    EXPECT_EQ(commits, (std::vector<journal_sequence_t>{2}));
+}
+
+TEST_F(UTestJournal, FramesSpanSegmentsAndAckedSegmentsAreRecycled) {
+    journal_t journal{directory, options};
+    std::string const payload(1000, 'x');
+    for (int i = 0; i < 12; ++i) {
+        journal.append(zmq::buffer(payload));
+    }
+    EXPECT_GE(journal.segment_count(), 3u);
+    EXPECT_EQ(read_all(journal).size(), 12u);
+
+    journal.ack(12);
+    journal.sync();
+
+    EXPECT_EQ(journal.segment_count(), 1u);
+    EXPECT_EQ(journal.spare_segment_count(), 1u);
+
+    for (int i = 0; i < 8; ++i) {
+        journal.append(zmq::buffer(payload));
+    }
+    EXPECT_EQ(journal.spare_segment_count(), 0u);
+    EXPECT_EQ(read_all(journal).size(), 8u);
+}
+
+TEST_F(UTestJournal, ReopenRecoversUnackedFrames) {
+    {
+        journal_t journal{directory, options};
+        for (int i = 0; i < 10; ++i) {
+            journal.append(zmq::buffer(std::to_string(i) + std::string(500, '.')), i % 2 == 0);
+        }
+        journal.ack(4);
+        journal.sync();
+    }
+
+    journal_t journal{directory, options};
+
+    EXPECT_EQ(journal.next_sequence(), 11u);
+    EXPECT_EQ(journal.acked_sequence(), 4u);
+    EXPECT_EQ(journal.durable_sequence(), 10u);
+    journal_entry_t entry;
+    ASSERT_TRUE(journal.read(entry));
+    EXPECT_EQ(entry.sequence, 5u);
+    EXPECT_EQ(to_string(entry).substr(0, 1), "4");
+    EXPECT_TRUE(entry.more);
+    EXPECT_EQ(read_all(journal).size(), 5u);
+    EXPECT_EQ(journal.append(zmq::str_buffer("next")), 11u);
+}
+
+TEST_F(UTestJournal, ReopenDiscardsCorruptedTail) {
+    {
+        journal_t journal{directory, options};
+        journal.append(zmq::str_buffer("kept"));
+        journal.append(zmq::str_buffer("torn"));
+        journal.sync();
+    }
+    {
+        // Corrupt the content of the second record
+        std::fstream file{directory + "/0.seg", std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(64 + 32 + 8 + 32);
+        file.write("X", 1);
+    }
+
+    journal_t journal{directory, options};
+
+    EXPECT_EQ(journal.next_sequence(), 2u);
+    EXPECT_EQ(read_all(journal), (std::vector<std::string>{"kept"}));
+    EXPECT_EQ(journal.append(zmq::str_buffer("new")), 2u);
+    journal.sync();
+}
+
+TEST_F(UTestJournal, ReopenAfterUnflushedTrailingSegmentKeepsSegmentsConsecutive) {
+    std::string const payload(1000, 'x');
+    {
+        journal_t journal{directory, options};
+        for (int i = 0; i < 8; ++i) {
+            journal.append(zmq::buffer(payload));
+        }
+        journal.sync();
+        ASSERT_EQ(journal.segment_count(), 3u);
+    }
+    {
+        // The records of the last segment never reached the disk
+        std::fstream file{directory + "/2.seg", std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(64);
+        std::string const zeros(4096 - 64, '\0');
+        file.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+
+    journal_t journal{directory, options};
+    EXPECT_EQ(journal.segment_count(), 2u);
+    auto const recovered = read_all(journal).size();
+    for (int i = 0; i < 6; ++i) {
+        journal.append(zmq::buffer(payload));
+    }
+    EXPECT_GE(journal.segment_count(), 3u);
+
+    journal.rewind();
+    EXPECT_EQ(read_all(journal).size(), recovered + 6);
+}
+
+TEST_F(UTestJournal, ReopenThrowsOnSegmentSizeMismatch) {
+    { journal_t journal{directory, options}; }
+
+    options.segment_size = 8192;
+
+    EXPECT_THROW(journal_t(directory, options), std::invalid_argument);
+}
+
+TEST_F(UTestJournal, CommitTimerSyncsPendingFrames) {
+    journal_t journal{directory, options};
+    loop_t loop;
+    journal.add_commit_timer(loop, std::chrono::milliseconds{5});
+    journal.set_commit_handler([&](journal_sequence_t) {
+        loop.add_timer(std::chrono::milliseconds{1}, 1, [](loop_t&, timer_id_t) { return false; });
+    });
+    journal.append(zmq::str_buffer("a"));
+
+    loop.run();
+
+    EXPECT_EQ(journal.durable_sequence(), 1u);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,142 @@
+#include <cppzmqzoltanext/last_value_cache.h>
+#include <cppzmqzoltanext/loop.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestLastValueCache : public ::testing::Test {
+public:
+    using frames_t = std::vector<std::string>;
+
+    UTestLastValueCache() : publisher{ctx, zmq::socket_type::pub}, cache{ctx, loop} {
+        publisher.set(zmq::sockopt::linger, 0);
+        publisher.bind("inproc://lvc-publisher");
+        cache.frontend().connect("inproc://lvc-publisher");
+        cache.backend().bind("inproc://lvc-subscribers");
+    }
+
+    zmq::socket_t connect_subscriber(std::string const& prefix) {
+        zmq::socket_t socket{ctx, zmq::socket_type::sub};
+        socket.set(zmq::sockopt::linger, 0);
+        socket.set(zmq::sockopt::subscribe, prefix);
+        socket.connect("inproc://lvc-subscribers");
+        return socket;
+    }
+
+    void publish(frames_t const& frames) {
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            publisher.send(zmq::buffer(frames[i]),
+                           i + 1 < frames.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+        }
+    }
+
+    /// Let the proxy handle the messages and subscriptions already sent
+    void pump() {
+        loop.add_timer(std::chrono::milliseconds{2}, 1, [](loop_t& loop, timer_id_t id) {
+            loop.remove_timer(id);
+            return false;
+        });
+        loop.run(false);
+    }
+
+    /// Receive the messages available after letting the proxy run
+    static std::vector<frames_t> receive_all(zmq::socket_ref subscriber) {
+        std::vector<frames_t> messages;
+        zmq::message_t msg;
+        while (subscriber.recv(msg, zmq::recv_flags::dontwait)) {
+            frames_t frames{msg.to_string()};
+            while (msg.more()) {
+                subscriber.recv(msg, zmq::recv_flags::none);
+                frames.push_back(msg.to_string());
+            }
+            messages.push_back(frames);
+        }
+        return messages;
+    }
+
+    /// Publish a message until the subscription of the subscriber reached the publisher
+    void wait_subscription(zmq::socket_ref subscriber, std::string const& topic) {
+        for (int i = 0; i < 500; ++i) {
+            publish({topic, "probe"});
+            pump();
+            if (!receive_all(subscriber).empty()) {
+                return;
+            }
+        }
+        FAIL() << "Subscription to " << topic << " not propagated";
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t publisher;
+    loop_t loop;
+    last_value_cache_t cache;
+};
+
+TEST_F(UTestLastValueCache, LateJoinerReceivesLastValueWithoutNewUpdate) {
+    auto early = connect_subscriber("price.");
+    wait_subscription(early, "price.eur");
+    publish({"price.eur", "1.08"});
+    publish({"price.eur", "1.09"});
+    pump();
+    EXPECT_EQ(receive_all(early), (std::vector<frames_t>{{"price.eur", "1.08"}, {"price.eur", "1.09"}}));
+
+    auto late = connect_subscriber("price.eur");
+    pump();
+
+    EXPECT_EQ(receive_all(late), (std::vector<frames_t>{{"price.eur", "1.09"}}));
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(UTestLastValueCache, SnapshotCoversTopicsMatchingPrefixOnly) {
+    auto early = connect_subscriber("");
+    wait_subscription(early, "a.1");
+    publish({"a.1", "x", "multipart"});
+    publish({"a.2", "y"});
+    publish({"b.1", "z"});
+    pump();
+
+    auto late = connect_subscriber("a.");
+    pump();
+    auto snapshot = receive_all(late);
+    std::sort(snapshot.begin(), snapshot.end());
+
+    EXPECT_EQ(snapshot, (std::vector<frames_t>{{"a.1", "x", "multipart"}, {"a.2", "y"}}));
+    EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST_F(UTestLastValueCache, ForwardsLiveUpdatesAfterSnapshot) {
+    auto early = connect_subscriber("t");
+    wait_subscription(early, "t");
+    publish({"t", "1"});
+    pump();
+
+    auto late = connect_subscriber("t");
+    pump();
+    publish({"t", "2"});
+    pump();
+
+    EXPECT_EQ(receive_all(late), (std::vector<frames_t>{{"t", "1"}, {"t", "2"}}));
+}
+
+TEST_F(UTestLastValueCache, ClearDiscardsCachedValues) {
+    auto early = connect_subscriber("t");
+    wait_subscription(early, "t");
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.clear();
+    auto late = connect_subscriber("t");
+    pump();
+
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_TRUE(receive_all(late).empty());
+}
+
+}  // namespace zmqzext
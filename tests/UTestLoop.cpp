@@ -532,6 +532,33 @@ TEST_F(UTestLoop, HandlesMultipleSocketAndTimerRemovals) {
     loop.run();  // Should exit immediately as nothing to handle
 }
 
+TEST_F(UTestLoop, WritableHandlerIsCalledUntilRemoved) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    std::size_t calls = 0;
+
+    loop.add_writable(sockets.socketPush, [&](loop_t& l, zmq::socket_ref socket) {
+        send_now_or_throw(socket, "test");
+        if (++calls == 3) {
+            l.remove_writable(socket);
+        }
+        return true;
+    });
+    loop.run();  // Exits when the socket is removed
+
+    EXPECT_EQ(calls, 3u);
+    for (std::size_t i = 0; i < calls; ++i) {
+        waitSocketHaveMsg(sockets.socketPull, std::chrono::milliseconds{1000});
+        EXPECT_EQ(recv_now_or_throw(sockets.socketPull).to_string(), "test");
+    }
+}
+
+TEST_F(UTestLoop, ThrowsWhenAddingSameWritableSocketTwice) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    loop.add_writable(sockets.socketPush, [](loop_t&, zmq::socket_ref) { return true; });
+    EXPECT_THROW(loop.add_writable(sockets.socketPush, [](loop_t&, zmq::socket_ref) { return true; }),
+                 std::invalid_argument);
+}
+
 #if !defined(_WIN32)
 TEST_F(UTestLoopWithInterruptHandler, StopsRunningWhenInterrupted) {
     ConnectedSocketsWithHandlers sockets{ctx};
@@ -584,6 +611,292 @@ TEST_F(UTestLoopWithInterruptHandler, IgnoresInterruptionWhenSetToNotInterruptib
     EXPECT_TRUE(timerRun);
 }
 
+TEST_F(UTestLoop, RateLimitedSocketIsPausedUntilItsBucketRefills) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    std::size_t const count = 20;
+    sockets.maxMsgs = count;
+    bool pausedSeen = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        send_now_or_throw(*sockets.socketPush, std::to_string(i));
+    }
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+
+    loop.add(
+        *sockets.socketPull,
+        [&](loop_t& loop, zmq::socket_ref socket) {
+            pausedSeen = pausedSeen || loop.paused(socket);
+            return sockets.socketHandlerReceiveMaxMessages(loop, socket);
+        },
+        rate_limit_t{100, 0, 5, 0});
+    auto const start = std::chrono::steady_clock::now();
+    loop.run();
+
+    // 5 messages from the burst, then one every 10 ms
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{140});
+    EXPECT_EQ(sockets.messages.size(), count);
+    EXPECT_FALSE(pausedSeen);
+}
+
+TEST_F(UTestLoop, RateLimitChargesWhatHandlersReport) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    std::size_t const count = 10;
+    std::string const payload(50, 'x');
+    for (std::size_t i = 0; i < count; ++i) {
+        send_now_or_throw(*sockets.socketPush, payload);
+    }
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+    std::size_t received = 0;
+    std::vector<bool> pausedAfterCall;
+
+    loop.add(
+        *sockets.socketPull,
+        [&](loop_t& loop, zmq::socket_ref socket) {
+            auto const msg = recv_now_or_throw(socket);
+            loop.charge(socket, 1, msg.size());
+            ++received;
+            return received < count;
+        },
+        rate_limit_t{0, 1000, 0, 100});
+    loop.add_timer(std::chrono::milliseconds{1}, 0, [&](loop_t& loop, timer_id_t) {
+        pausedAfterCall.push_back(loop.paused(*sockets.socketPull));
+        return true;
+    });
+    auto const start = std::chrono::steady_clock::now();
+    loop.run();
+
+    // 100 bytes of burst, then 50 bytes every 50 ms
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{350});
+    EXPECT_EQ(received, count);
+    EXPECT_THAT(pausedAfterCall, ::testing::Contains(true));
+}
+
+TEST_F(UTestLoop, RemovingPausedSocketDropsItsRateLimit) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    sockets.maxMsgs = 2;
+    send_now_or_throw(*sockets.socketPush, "first");
+    send_now_or_throw(*sockets.socketPush, "second");
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+
+    loop.add(*sockets.socketPull,
+             std::bind(&ConnectedSocketsWithHandlers::socketHandlerReceiveMaxMessages, &sockets, _1, _2),
+             rate_limit_t{1, 0, 1, 0});
+    loop.add_timer(std::chrono::milliseconds{20}, 1, [&](loop_t& loop, timer_id_t) {
+        EXPECT_TRUE(loop.paused(*sockets.socketPull));
+        loop.remove(*sockets.socketPull);
+        EXPECT_FALSE(loop.paused(*sockets.socketPull));
+        return true;
+    });
+    loop.run();
+
+    EXPECT_EQ(sockets.messages.size(), 1u);
+}
+
+TEST_F(UTestLoop, RateLimitWithoutRatesDoesNotLimit) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    sockets.maxMsgs = 3;
+    for (int i = 0; i < 3; ++i) {
+        send_now_or_throw(*sockets.socketPush, "msg");
+    }
+
+    loop.add(*sockets.socketPull,
+             std::bind(&ConnectedSocketsWithHandlers::socketHandlerReceiveMaxMessages, &sockets, _1, _2),
+             rate_limit_t{});
+    loop.run();
+
+    EXPECT_EQ(sockets.messages.size(), 3u);
+}
+
+TEST_F(UTestLoop, RateLimitRejectsNegativeValues) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    auto const handler = [](loop_t&, zmq::socket_ref) { return true; };
+
+    EXPECT_THROW(loop.add(*sockets.socketPull, handler, rate_limit_t{-1, 0, 0, 0}), std::invalid_argument);
+    EXPECT_THROW(loop.add(*sockets.socketPull, handler, rate_limit_t{1, 0, 0, -1}), std::invalid_argument);
+    loop.add(*sockets.socketPull, handler, rate_limit_t{1, 0, 0, 0});
+}
+
+TEST_F(UTestLoopWithInterruptHandler, DrainsPendingInputWhenInterrupted) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    std::size_t const count = 10;
+    sockets.maxMsgs = count + 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        send_now_or_throw(*sockets.socketPush, std::to_string(i));
+    }
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});  // ensure all messages arrived
+    std::vector<bool> draining;
+
+    loop.set_drain_on_interrupt(std::chrono::milliseconds{1000});
+    loop.add(*sockets.socketPull, [&](loop_t& loop, zmq::socket_ref socket) {
+        draining.push_back(loop.draining());
+        if (draining.size() == 1) {
+            raise_interrupt_signal();
+        }
+        return sockets.socketHandlerReceiveMaxMessages(loop, socket);
+    });
+    loop.run();
+
+    EXPECT_TRUE(loop.terminated());
+    EXPECT_FALSE(loop.draining());
+    ASSERT_EQ(sockets.messages.size(), count);
+    EXPECT_FALSE(draining.front());
+    EXPECT_TRUE(draining.back());
+}
+
+TEST_F(UTestLoopWithInterruptHandler, ReturnsAtOnceWhenInterruptedWithoutDrain) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    std::size_t const count = 10;
+    sockets.maxMsgs = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        send_now_or_throw(*sockets.socketPush, std::to_string(i));
+    }
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+
+    loop.add(*sockets.socketPull, [&](loop_t& loop, zmq::socket_ref socket) {
+        raise_interrupt_signal();
+        return sockets.socketHandlerReceiveMaxMessages(loop, socket);
+    });
+    loop.run();
+
+    EXPECT_TRUE(loop.terminated());
+    EXPECT_EQ(sockets.messages.size(), 1u);
+}
+
+TEST_F(UTestLoopWithInterruptHandler, DrainEndsAtDeadline) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    send_now_or_throw(*sockets.socketPush, "never received");
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+
+    loop.set_drain_on_interrupt(std::chrono::milliseconds{50});
+    // The message is never received, so the socket stays ready
+    loop.add(*sockets.socketPull, [](loop_t&, zmq::socket_ref) { return true; });
+    auto const start = std::chrono::steady_clock::now();
+    raise_interrupt_signal();
+    loop.run();
+
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds{50});
+    EXPECT_LT(elapsed, std::chrono::milliseconds{1000});
+    EXPECT_TRUE(loop.terminated());
+}
+
+TEST_F(UTestLoopWithInterruptHandler, RejectsNewSocketsWhileDraining) {
+    ConnectedSocketsWithHandlers sockets{ctx};
+    sockets.maxMsgs = 2;
+    send_now_or_throw(*sockets.socketPush, "first");
+    send_now_or_throw(*sockets.socketPush, "second");
+    waitSocketHaveMsg(*sockets.socketPull, std::chrono::milliseconds{1000});
+    auto const handler = [](loop_t&, zmq::socket_ref) { return true; };
+    bool rejected = false;
+
+    loop.set_drain_on_interrupt(std::chrono::milliseconds{1000});
+    loop.add(*sockets.socketPull, [&](loop_t& loop, zmq::socket_ref socket) {
+        if (loop.draining()) {
+            EXPECT_THROW(loop.add(*sockets.socketPull2, handler), std::runtime_error);
+            rejected = true;
+        }
+        raise_interrupt_signal();
+        return sockets.socketHandlerReceiveMaxMessages(loop, socket);
+    });
+    loop.run();
+
+    EXPECT_EQ(sockets.messages.size(), 2u);
+    EXPECT_TRUE(rejected);
+    reset_interrupted();
+    loop.add(*sockets.socketPull2, handler);
+}
+
+TEST_F(UTestLoop, ResetTimerPostponesItsExpiration) {
+    std::vector<zmqzext::timer_id_t> timersHandled;
+    auto const start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration idleElapsed{};
+
+    auto const idleTimerId = loop.add_timer(std::chrono::milliseconds{30}, 1, [&](loop_t&, timer_id_t id) {
+        idleElapsed = std::chrono::steady_clock::now() - start;
+        timersHandled.push_back(id);
+        return true;
+    });
+    loop.add_timer(std::chrono::milliseconds{10}, 2, [&](loop_t& l, timer_id_t) {
+        EXPECT_TRUE(l.reset_timer(idleTimerId));
+        return true;
+    });
+
+    loop.run();
+
+    EXPECT_THAT(timersHandled, ElementsAre(idleTimerId));
+    EXPECT_GE(idleElapsed, std::chrono::milliseconds{50});
+}
+
+TEST_F(UTestLoop, ResetTimerWithinItsOwnHandlerKeepsItsOccurrences) {
+    std::vector<std::chrono::steady_clock::time_point> calls;
+    std::chrono::milliseconds const timeout{5};
+
+    loop.add_timer(timeout, 3, [&](loop_t& l, timer_id_t id) {
+        calls.push_back(std::chrono::steady_clock::now());
+        EXPECT_TRUE(l.reset_timer(id));
+        return true;
+    });
+
+    loop.run();
+
+    ASSERT_EQ(3, calls.size());
+    EXPECT_GE(calls[1] - calls[0], timeout);
+    EXPECT_GE(calls[2] - calls[1], timeout);
+}
+
+TEST_F(UTestLoop, RescheduleTimerChangesItsInterval) {
+    std::vector<std::chrono::steady_clock::time_point> calls;
+
+    loop.add_timer(std::chrono::milliseconds{1}, 0, [&](loop_t& l, timer_id_t id) {
+        calls.push_back(std::chrono::steady_clock::now());
+        if (calls.size() == 1) {
+            EXPECT_TRUE(l.reschedule_timer(id, std::chrono::milliseconds{20}));
+        } else if (calls.size() == 3) {
+            l.remove_timer(id);
+        }
+        return true;
+    });
+
+    loop.run();
+
+    ASSERT_EQ(3, calls.size());
+    EXPECT_GE(calls[1] - calls[0], std::chrono::milliseconds{20});
+    // The next expiration is scheduled from the previous one, not from the late call
+    EXPECT_GE(calls[2] - calls[0], std::chrono::milliseconds{40});
+}
+
+TEST_F(UTestLoop, ResetTimerFailsForUnknownOrRemovedTimers) {
+    auto const timerId = loop.add_timer(std::chrono::milliseconds{1}, 1, [](loop_t&, timer_id_t) { return true; });
+
+    EXPECT_FALSE(loop.reset_timer(timerId + 1));
+    EXPECT_FALSE(loop.reschedule_timer(timerId + 1, std::chrono::milliseconds{1}));
+    EXPECT_TRUE(loop.reset_timer(timerId));
+
+    loop.remove_timer(timerId);
+
+    EXPECT_FALSE(loop.reset_timer(timerId));
+    EXPECT_FALSE(loop.reschedule_timer(timerId, std::chrono::milliseconds{1}));
+}
+
+TEST_F(UTestLoop, CopiedLoopResetsItsOwnTimers) {
+    std::size_t calls{0};
+    auto const timerId = loop.add_timer(std::chrono::milliseconds{1}, 1, [&](loop_t&, timer_id_t) {
+        ++calls;
+        return true;
+    });
+
+    auto loop_copy = loop;
+    loop_copy.remove_timer(timerId);
+
+    EXPECT_FALSE(loop_copy.reset_timer(timerId));
+    EXPECT_TRUE(loop.reset_timer(timerId));
+
+    loop.run();
+    loop_copy.run();
+
+    EXPECT_EQ(1, calls);
+}
+
 // Copyability Tests
 TEST_F(UTestLoop, IsCopyConstructible) {
     ConnectedSocketsWithHandlers sockets{ctx};
@@ -680,6 +993,65 @@ TEST_F(UTestLoop, CopiedLoopIsIndependent) {
 }
 
 // Moveability Tests
+TEST_F(UTestLoop, AccountingCountsWakeupsAndEmptyWakeups) {
+    zmq::socket_t socketPull(ctx, zmq::socket_type::pull);
+    zmq::socket_t socketPush(ctx, zmq::socket_type::push);
+    socketPull.bind("inproc://accounting");
+    socketPush.connect("inproc://accounting");
+    loop.set_accounting(true);
+    loop.add(socketPull, [](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        EXPECT_TRUE(socket.recv(msg, zmq::recv_flags::dontwait));
+        return false;
+    });
+    send_now_or_throw(socketPush, "Test message");
+
+    loop.run(false);
+
+    auto const usage = loop.usage();
+    EXPECT_EQ(1, usage.wakeups);
+    EXPECT_EQ(0, usage.empty_wakeups);
+
+    // Waking up only to check for interrupts is an empty wake-up
+    loop.remove(socketPull);
+    loop.add_timer(std::chrono::milliseconds{50}, 1, [](loop_t&, timer_id_t) { return true; });
+    loop.run(false, std::chrono::milliseconds{5});
+
+    auto const more = loop.usage() - usage;
+    EXPECT_GE(more.wakeups, 5);
+    EXPECT_EQ(more.wakeups - 1, more.empty_wakeups);
+}
+
+TEST_F(UTestLoop, AccountingSamplesTheCpuTimeOfTheRunningThread) {
+    loop.set_accounting(true);
+    loop_usage_t during;
+    loop.add_timer(std::chrono::milliseconds{1}, 1, [&](loop_t& l, timer_id_t) {
+        auto const until = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        during = l.usage();
+        return true;
+    });
+
+    loop.run(false);
+
+    EXPECT_GE(during.thread.cpu_time, std::chrono::milliseconds{5});
+    EXPECT_GE(loop.usage().thread.cpu_time, during.thread.cpu_time);
+
+    loop.reset_usage();
+    EXPECT_EQ(0, loop.usage().wakeups);
+    EXPECT_EQ(std::chrono::nanoseconds{0}, loop.usage().thread.cpu_time);
+}
+
+TEST_F(UTestLoop, AccountingIsDisabledByDefault) {
+    loop.add_timer(std::chrono::milliseconds{1}, 1, [](loop_t&, timer_id_t) { return true; });
+
+    loop.run(false);
+
+    EXPECT_EQ(0, loop.usage().wakeups);
+    EXPECT_EQ(std::chrono::nanoseconds{0}, loop.usage().thread.cpu_time);
+}
+
 TEST_F(UTestLoop, IsMoveConstructible) {
     ConnectedSocketsWithHandlers sockets{ctx};
     size_t const maxMsgs = 1;
@@ -751,6 +1123,59 @@ TEST_F(UTestLoop, MoveAssignmentSelfAssignmentIsNotWhatYouShouldExpect) {
     ASSERT_EQ(0, sockets.messages.size());
 }
 
+TEST_F(UTestLoop, AllocatesFromTheGivenMemoryResource) {
+    counting_resource_t resource;
+    loop_t pmr_loop{&resource};
+    EXPECT_EQ(&resource, pmr_loop.resource());
+    zmq::socket_t socketPull(ctx, zmq::socket_type::pull);
+    zmq::socket_t socketPush(ctx, zmq::socket_type::push);
+    socketPull.bind("inproc://memory-resource");
+    socketPush.connect("inproc://memory-resource");
+    std::size_t received = 0;
+    pmr_loop.add(socketPull, [&received](loop_t&, zmq::socket_ref socket) {
+        recv_now_or_throw(socket);
+        ++received;
+        return false;
+    });
+    pmr_loop.add_timer(std::chrono::hours{1}, 1, [](loop_t&, timer_id_t) { return true; });
+    EXPECT_GT(resource.allocations, 0U);
+
+    send_now_or_throw(socketPush, "Test message");
+    pmr_loop.run(false);
+    ASSERT_EQ(1U, received);
+
+    // Once warm, running the loop does not allocate
+    auto const allocations = resource.allocations;
+    send_now_or_throw(socketPush, "Test message");
+    pmr_loop.run(false);
+    ASSERT_EQ(2U, received);
+    EXPECT_EQ(allocations, resource.allocations);
+
+    loop_t const copy{pmr_loop};
+    EXPECT_EQ(std::pmr::get_default_resource(), copy.resource());
+    loop_t const moved{std::move(pmr_loop)};
+    EXPECT_EQ(&resource, moved.resource());
+}
+
+TEST_F(UTestLoop, MoveAssignmentAcrossMemoryResourcesKeepsTheTimers) {
+    counting_resource_t resource1;
+    counting_resource_t resource2;
+    loop_t loop1{&resource1};
+    loop_t loop2{&resource2};
+    TimersHandlers timers;
+    auto const handler = std::bind(&TimersHandlers::timerHandler, &timers, _1, _2);
+    auto const timer1 = loop1.add_timer(std::chrono::milliseconds{1}, 1, handler);
+    auto const timer2 = loop1.add_timer(std::chrono::milliseconds{1}, 1, handler);
+
+    loop2 = std::move(loop1);
+    EXPECT_EQ(&resource2, loop2.resource());
+    loop2.remove_timer(timer2);
+    loop2.run(false);
+
+    ASSERT_EQ(1U, timers.timersHandled.size());
+    EXPECT_EQ(timer1, timers.timersHandled[0]);
+}
+
 // Test multiple timers with identical timeouts firing simultaneously
 // Test invalid socket references
 // Test removing non-existent sockets and timers
@@ -0,0 +1,260 @@
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/loop_scheduler.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestLoopScheduler : public ::testing::Test {
+public:
+    /// Completion recorded by a receiver_t
+    template <typename Value>
+    struct result_t {
+        std::optional<Value> value;
+        std::exception_ptr error;
+        int completions{0};
+    };
+
+    /// Receiver recording its completion, std::monostate standing for no value
+    template <typename Value>
+    struct receiver_t {
+        result_t<Value>* result;
+
+        template <typename... Values>
+        void set_value(Values&&... values) {
+            result->value.emplace(std::forward<Values>(values)...);
+            ++result->completions;
+        }
+
+        void set_error(std::exception_ptr error) noexcept {
+            result->error = error;
+            ++result->completions;
+        }
+    };
+
+    UTestLoopScheduler()
+        : socketPull1{ctx, zmq::socket_type::pull},
+          socketPush1{ctx, zmq::socket_type::push},
+          socketPull2{ctx, zmq::socket_type::pull},
+          socketPush2{ctx, zmq::socket_type::push},
+          scheduler{loop} {
+        for (auto* socket : {&socketPull1, &socketPush1, &socketPull2, &socketPush2}) {
+            socket->set(zmq::sockopt::linger, 0);
+        }
+        socketPull1.bind("inproc://loop-scheduler-1");
+        socketPush1.connect("inproc://loop-scheduler-1");
+        socketPull2.bind("inproc://loop-scheduler-2");
+        socketPush2.connect("inproc://loop-scheduler-2");
+    }
+
+    /// Run the loop until an operation completed or a timeout, the scheduler keeping it running otherwise
+    template <typename Value>
+    void run_until_completed(result_t<Value> const& result,
+                             std::chrono::milliseconds timeout = std::chrono::milliseconds{1000}) {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        auto const timer = loop.add_timer(std::chrono::milliseconds{1}, 0, [&result, deadline](loop_t&, timer_id_t) {
+            return result.completions == 0 && std::chrono::steady_clock::now() < deadline;
+        });
+        loop.run(false);
+        // A timer stopping the loop is not consumed, so it is removed for the next runs
+        loop.remove_timer(timer);
+    }
+
+    static std::string error_message(std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (std::exception const& e) {
+            return e.what();
+        }
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t socketPull1;
+    zmq::socket_t socketPush1;
+    zmq::socket_t socketPull2;
+    zmq::socket_t socketPush2;
+    loop_t loop;
+    loop_scheduler_t scheduler;
+};
+
+TEST_F(UTestLoopScheduler, ScheduleCompletesInTheLoop) {
+    result_t<std::monostate> result;
+    auto op = scheduler.schedule().connect(receiver_t<std::monostate>{&result});
+
+    op.start();
+    EXPECT_EQ(0, result.completions);
+
+    run_until_completed(result);
+
+    EXPECT_EQ(1, result.completions);
+    EXPECT_TRUE(result.value.has_value());
+}
+
+TEST_F(UTestLoopScheduler, ScheduleStartedInAnotherThreadCompletesInTheLoopThread) {
+    result_t<std::thread::id> result;
+    auto op = then(scheduler.schedule(), []() { return std::this_thread::get_id(); })
+                  .connect(receiver_t<std::thread::id>{&result});
+
+    std::thread other([&op]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        op.start();
+    });
+    run_until_completed(result);
+    other.join();
+
+    EXPECT_EQ(1, result.completions);
+    ASSERT_TRUE(result.value.has_value());
+    EXPECT_EQ(std::this_thread::get_id(), *result.value);
+}
+
+TEST_F(UTestLoopScheduler, ScheduleAfterCompletesAfterTheDelay) {
+    result_t<std::monostate> result;
+    auto op = scheduler.schedule_after(std::chrono::milliseconds{20}).connect(receiver_t<std::monostate>{&result});
+    auto const start = std::chrono::steady_clock::now();
+
+    op.start();
+    run_until_completed(result);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{20});
+    EXPECT_EQ(1, result.completions);
+}
+
+TEST_F(UTestLoopScheduler, ReceiveCompletesWithTheMessageAndUnregistersTheSocket) {
+    result_t<zmq::message_t> result;
+    auto op = scheduler.receive(socketPull1).connect(receiver_t<zmq::message_t>{&result});
+
+    op.start();
+    send_now_or_throw(socketPush1, "Test message");
+    run_until_completed(result);
+
+    ASSERT_TRUE(result.value.has_value());
+    EXPECT_EQ("Test message", result.value->to_string());
+    // The socket is not registered in the loop anymore
+    EXPECT_NO_THROW(loop.add(socketPull1, [](loop_t&, zmq::socket_ref) { return true; }));
+}
+
+TEST_F(UTestLoopScheduler, ReadableCompletesWithTheSocket) {
+    result_t<zmq::socket_ref> result;
+    auto op = scheduler.readable(socketPull1).connect(receiver_t<zmq::socket_ref>{&result});
+
+    send_now_or_throw(socketPush1, "Test message");
+    op.start();
+    run_until_completed(result);
+
+    ASSERT_TRUE(result.value.has_value());
+    EXPECT_EQ(zmq::socket_ref{socketPull1}, *result.value);
+    EXPECT_EQ("Test message", recv_now_or_throw(socketPull1).to_string());
+}
+
+TEST_F(UTestLoopScheduler, ThenChainsTransformTheValue) {
+    result_t<std::size_t> result;
+    auto sender = then(then(scheduler.receive(socketPull1), [](zmq::message_t msg) { return msg.to_string(); }),
+                       [](std::string const& str) { return str.size(); });
+    auto op = sender.connect(receiver_t<std::size_t>{&result});
+
+    send_now_or_throw(socketPush1, "12345");
+    op.start();
+    run_until_completed(result);
+
+    ASSERT_TRUE(result.value.has_value());
+    EXPECT_EQ(5, *result.value);
+}
+
+TEST_F(UTestLoopScheduler, ThenReportsTheExceptionOfItsFunctionAsAnError) {
+    result_t<int> result;
+    auto sender = then(scheduler.schedule(), []() -> int { throw std::runtime_error("then failed"); });
+    auto op = sender.connect(receiver_t<int>{&result});
+
+    op.start();
+    run_until_completed(result);
+
+    EXPECT_EQ(1, result.completions);
+    EXPECT_FALSE(result.value.has_value());
+    ASSERT_TRUE(result.error);
+    EXPECT_EQ("then failed", error_message(result.error));
+}
+
+TEST_F(UTestLoopScheduler, WhenAllCompletesWithTheValuesOfAllItsSenders) {
+    using value_t = std::tuple<zmq::message_t, zmq::message_t, std::monostate>;
+    result_t<value_t> result;
+    auto sender = when_all(scheduler.receive(socketPull1), scheduler.receive(socketPull2),
+                           scheduler.schedule_after(std::chrono::milliseconds{5}));
+    auto op = sender.connect(receiver_t<value_t>{&result});
+
+    op.start();
+    send_now_or_throw(socketPush2, "second");
+    send_now_or_throw(socketPush1, "first");
+    run_until_completed(result);
+
+    EXPECT_EQ(1, result.completions);
+    ASSERT_TRUE(result.value.has_value());
+    EXPECT_EQ("first", std::get<0>(*result.value).to_string());
+    EXPECT_EQ("second", std::get<1>(*result.value).to_string());
+}
+
+TEST_F(UTestLoopScheduler, WhenAllReportsTheFirstErrorOnceAllItsSendersCompleted) {
+    using value_t = std::tuple<int, std::monostate>;
+    result_t<value_t> result;
+    auto sender = when_all(then(scheduler.schedule(), []() -> int { throw std::runtime_error("first failed"); }),
+                           scheduler.schedule_after(std::chrono::milliseconds{20}));
+    auto op = sender.connect(receiver_t<value_t>{&result});
+    auto const start = std::chrono::steady_clock::now();
+
+    op.start();
+    run_until_completed(result);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{20});
+    EXPECT_EQ(1, result.completions);
+    ASSERT_TRUE(result.error);
+    EXPECT_EQ("first failed", error_message(result.error));
+}
+
+TEST_F(UTestLoopScheduler, WaitingForASocketAlreadyInTheLoopCompletesWithAnError) {
+    result_t<zmq::message_t> result;
+    loop.add(socketPull1, [](loop_t&, zmq::socket_ref) { return false; });
+    auto op = scheduler.receive(socketPull1).connect(receiver_t<zmq::message_t>{&result});
+
+    op.start();
+
+    EXPECT_EQ(1, result.completions);
+    EXPECT_TRUE(result.error);
+}
+
+TEST_F(UTestLoopScheduler, DestroyingAStartedOperationUnregistersIt) {
+    result_t<zmq::message_t> receiveResult;
+    result_t<std::monostate> timerResult;
+    {
+        auto receiveOp = scheduler.receive(socketPull1).connect(receiver_t<zmq::message_t>{&receiveResult});
+        auto timerOp = scheduler.schedule().connect(receiver_t<std::monostate>{&timerResult});
+        receiveOp.start();
+        timerOp.start();
+    }
+
+    send_now_or_throw(socketPush1, "Test message");
+    run_until_completed(timerResult, std::chrono::milliseconds{20});
+
+    EXPECT_EQ(0, receiveResult.completions);
+    EXPECT_EQ(0, timerResult.completions);
+    // The socket is not registered in the loop anymore
+    EXPECT_NO_THROW(loop.add(socketPull1, [](loop_t&, zmq::socket_ref) { return true; }));
+}
+
+TEST_F(UTestLoopScheduler, RejectsInvalidArguments) {
+    EXPECT_THROW(scheduler.schedule_after(std::chrono::milliseconds{-1}), std::invalid_argument);
+    EXPECT_THROW(scheduler.readable(zmq::socket_ref{}), std::invalid_argument);
+    EXPECT_THROW(scheduler.receive(zmq::socket_ref{}), std::invalid_argument);
+    EXPECT_EQ(scheduler, loop_scheduler_t{loop});
+}
+
+}  // namespace zmqzext
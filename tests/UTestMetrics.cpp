@@ -0,0 +1,171 @@
+#include <cppzmqzoltanext/helpers.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/metrics.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestMetrics : public ::testing::Test {
+public:
+    zmq::context_t ctx;
+    metrics_registry_t registry;
+};
+
+TEST_F(UTestMetrics, RegistryReturnsSameMetricForSameName) {
+    auto& counter = registry.counter("counter");
+    auto& histogram = registry.histogram("histogram");
+
+    EXPECT_EQ(&counter, &registry.counter("counter"));
+    EXPECT_EQ(&histogram, &registry.histogram("histogram"));
+}
+
+TEST_F(UTestMetrics, RegistryThrowsOnNameUsedByOtherMetricType) {
+    registry.counter("counter");
+    registry.histogram("histogram");
+
+    EXPECT_THROW(registry.histogram("counter"), std::invalid_argument);
+    EXPECT_THROW(registry.counter("histogram"), std::invalid_argument);
+    EXPECT_THROW(registry.counter(""), std::invalid_argument);
+}
+
+TEST_F(UTestMetrics, SnapshotCollectsMetricsSortedByName) {
+    registry.counter("b").add(2);
+    registry.counter("a").add();
+    registry.histogram("h").record(100);
+
+    auto const snapshot = registry.snapshot(false);
+
+    ASSERT_EQ(2U, snapshot.counters.size());
+    EXPECT_EQ("a", snapshot.counters[0].first);
+    EXPECT_EQ(1U, snapshot.counters[0].second);
+    EXPECT_EQ("b", snapshot.counters[1].first);
+    EXPECT_EQ(2U, snapshot.counters[1].second);
+    ASSERT_EQ(1U, snapshot.histograms.size());
+    EXPECT_EQ(1U, snapshot.histograms[0].second.count());
+}
+
+TEST_F(UTestMetrics, SnapshotResetsHistogramsOnlyWhenRequested) {
+    registry.histogram("h").record(100);
+    registry.counter("c").add();
+
+    EXPECT_EQ(1U, registry.snapshot(false).histograms[0].second.count());
+    EXPECT_EQ(1U, registry.snapshot(true).histograms[0].second.count());
+    auto const snapshot = registry.snapshot(true);
+    EXPECT_EQ(0U, snapshot.histograms[0].second.count());
+    EXPECT_EQ(1U, snapshot.counters[0].second);
+}
+
+TEST_F(UTestMetrics, WritesSnapshotInLineProtocol) {
+    metrics_snapshot_t snapshot;
+    snapshot.time = std::chrono::system_clock::time_point{std::chrono::seconds{2}};
+    snapshot.counters.emplace_back("my counter,x", 5);
+    histogram_snapshot_t histogram;
+    snapshot.histograms.emplace_back("my.histogram", histogram);
+
+    std::ostringstream os;
+    write_metrics_lines(os, snapshot);
+
+    EXPECT_EQ(
+        "my\\ counter\\,x value=5i 2000000000\n"
+        "my.histogram count=0i,min=0i,p50=0i,p90=0i,p99=0i,p999=0i,max=0i,mean=0 2000000000\n",
+        os.str());
+}
+
+TEST_F(UTestMetrics, LoopCountsEventsInRegistry) {
+    zmq::socket_t sender(ctx, zmq::socket_type::pair);
+    zmq::socket_t receiver(ctx, zmq::socket_type::pair);
+    receiver.bind("inproc://test-metrics-loop");
+    sender.connect("inproc://test-metrics-loop");
+    sender.send(zmq::str_buffer("msg"), zmq::send_flags::none);
+
+    loop_t loop;
+    loop.set_metrics(registry, "loop");
+    loop.add(receiver, [](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        (void)socket.recv(msg, zmq::recv_flags::dontwait);
+        return true;
+    });
+    loop.add_timer(std::chrono::milliseconds{5}, 1, [](loop_t&, timer_id_t) { return false; });
+    loop.run(false);
+
+    EXPECT_EQ(1U, registry.counter("loop.socket_events").value());
+    EXPECT_EQ(1U, registry.counter("loop.timer_events").value());
+    EXPECT_EQ(0U, registry.counter("loop.fd_events").value());
+    EXPECT_LE(2U, registry.counter("loop.iterations").value());
+    EXPECT_EQ(2U, registry.histogram("loop.handler_ns").snapshot().count());
+    EXPECT_EQ(1U, registry.histogram("loop.timer_lateness_ns").snapshot().count());
+}
+
+TEST_F(UTestMetrics, PublisherThrowsOnInvalidOptions) {
+    EXPECT_THROW(metrics_publisher_t(ctx, registry, metrics_publisher_options_t{}), std::invalid_argument);
+
+    metrics_publisher_options_t options;
+    options.endpoint = "inproc://test-metrics";
+    options.interval = std::chrono::milliseconds{0};
+    EXPECT_THROW(metrics_publisher_t(ctx, registry, options), std::invalid_argument);
+}
+
+TEST_F(UTestMetrics, PublisherPublishesOnPubSocket) {
+    registry.counter("requests").add(3);
+    metrics_publisher_options_t options;
+    options.interval = std::chrono::milliseconds{10};
+    options.endpoint = "inproc://test-metrics-pub";
+    metrics_publisher_t publisher(ctx, registry, options);
+    publisher.start();
+
+    zmq::socket_t subscriber(ctx, zmq::socket_type::sub);
+    subscriber.set(zmq::sockopt::subscribe, "metrics");
+    subscriber.set(zmq::sockopt::rcvtimeo, 1000);
+    subscriber.connect(options.endpoint);
+
+    zmq::message_t topic;
+    zmq::message_t lines;
+    ASSERT_TRUE(recv_retry_on_eintr(subscriber, topic));
+    ASSERT_TRUE(topic.more());
+    ASSERT_TRUE(recv_retry_on_eintr(subscriber, lines));
+    EXPECT_EQ("metrics", topic.to_string());
+    EXPECT_EQ(0U, lines.to_string().find("requests value=3i "));
+    EXPECT_TRUE(publisher.stop(std::chrono::milliseconds{1000}));
+}
+
+TEST_F(UTestMetrics, PublisherAppendsToFile) {
+    auto const path = std::string{"czze-test-metrics.txt"};
+    std::remove(path.c_str());
+    registry.counter("requests").add();
+    metrics_publisher_options_t options;
+    options.interval = std::chrono::milliseconds{10};
+    options.file_path = path;
+    metrics_publisher_t publisher(ctx, registry, options);
+    publisher.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_TRUE(publisher.stop(std::chrono::milliseconds{1000}));
+
+    std::ifstream file(path);
+    std::string const content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    EXPECT_LE(2U, std::count(content.begin(), content.end(), '\n'));
+    EXPECT_EQ(0U, content.find("requests value=1i "));
+    std::remove(path.c_str());
+}
+
+TEST_F(UTestMetrics, PublisherStartThrowsWhenFileCannotBeOpened) {
+    metrics_publisher_options_t options;
+    options.file_path = "/nonexistent-dir/metrics.txt";
+    metrics_publisher_t publisher(ctx, registry, options);
+
+    EXPECT_THROW(publisher.start(), std::runtime_error);
+}
+
+}  // namespace zmqzext
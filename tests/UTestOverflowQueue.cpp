@@ -0,0 +1,129 @@
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/overflow_queue.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestOverflowQueue : public ::testing::Test {
+public:
+    UTestOverflowQueue() : socketPull{ctx, zmq::socket_type::pull}, socketPush{ctx, zmq::socket_type::push} {
+        socketPull.set(zmq::sockopt::linger, 0);
+        socketPush.set(zmq::sockopt::linger, 0);
+        socketPull.set(zmq::sockopt::rcvhwm, 1);
+        socketPush.set(zmq::sockopt::sndhwm, 1);
+        socketPull.bind("inproc://overflow-queue");
+        socketPush.connect("inproc://overflow-queue");
+    }
+
+    /// Receive messages in the loop until the expected number of frames was received
+    void receive_in_loop(std::size_t frames) {
+        loop.add(socketPull, [this, frames](loop_t&, zmq::socket_ref socket) {
+            received.push_back(recv_now_or_throw(socket).to_string());
+            return received.size() < frames;
+        });
+        loop.run(false);
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t socketPull;
+    zmq::socket_t socketPush;
+    loop_t loop;
+    std::vector<std::string> received;
+};
+
+TEST_F(UTestOverflowQueue, SendsDirectlyWhileSocketIsNotFull) {
+    overflow_queue_t queue{loop, socketPush};
+
+    EXPECT_TRUE(queue.send(zmq::str_buffer("test")));
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(recv_now_or_throw(socketPull).to_string(), "test");
+}
+
+TEST_F(UTestOverflowQueue, QueuesInMemoryAndReplaysInOrderWhenWritable) {
+    overflow_queue_t queue{loop, socketPush};
+    std::size_t const count = 100;
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(queue.send(zmq::buffer(std::to_string(i))));
+    }
+    EXPECT_GT(queue.memory_frames(), 0u);
+
+    receive_in_loop(count);
+
+    ASSERT_EQ(received.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.memory_bytes(), 0u);
+}
+
+TEST_F(UTestOverflowQueue, DropsMessagesBeyondMemoryLimitWithoutSpilling) {
+    overflow_queue_options_t options;
+    options.memory_limit = 8;
+    overflow_queue_t queue{loop, socketPush, options};
+    while (queue.memory_frames() == 0) {
+        queue.send(zmq::str_buffer("fill"));
+    }
+    EXPECT_TRUE(queue.send(zmq::str_buffer("head"), zmq::send_flags::sndmore));
+    EXPECT_TRUE(queue.send(zmq::str_buffer("tail-kept-over-limit")));
+
+    EXPECT_FALSE(queue.send(zmq::str_buffer("dropped-head"), zmq::send_flags::sndmore));
+    EXPECT_FALSE(queue.send(zmq::str_buffer("dropped-tail")));
+
+    EXPECT_EQ(queue.dropped_frames(), 2u);
+    EXPECT_EQ(queue.memory_frames(), 3u);
+}
+
+TEST_F(UTestOverflowQueue, ThrowsOnInvalidArguments) {
+    zmq::socket_t nullSocket{};
+    EXPECT_THROW(overflow_queue_t(loop, nullSocket), std::invalid_argument);
+
+    overflow_queue_options_t options;
+    options.replay_batch = 0;
+    EXPECT_THROW(overflow_queue_t(loop, socketPush, options), std::invalid_argument);
+}
+
+#if !defined(WIN32)
+TEST_F(UTestOverflowQueue, SpillsBeyondMemoryLimitAndReplaysMultipartMessagesInOrder) {
+    auto const directory = std::filesystem::temp_directory_path() / "czze-test-overflow-queue";
+    overflow_queue_options_t options;
+    options.memory_limit = 64;
+    options.spill_directory = directory.string();
+    options.spill_segment_size = 4096;
+    options.replay_batch = 16;
+    std::size_t const count = 500;
+    {
+        overflow_queue_t queue{loop, socketPush, options};
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_TRUE(queue.send(zmq::buffer("key" + std::to_string(i)), zmq::send_flags::sndmore));
+            EXPECT_TRUE(queue.send(zmq::buffer("value" + std::to_string(i))));
+        }
+        EXPECT_GT(queue.spilled_frames(), 0u);
+        EXPECT_LE(queue.memory_bytes(), 64u + 16u);
+
+        receive_in_loop(2 * count);
+
+        EXPECT_TRUE(queue.empty());
+        EXPECT_EQ(queue.spilled_frames(), 0u);
+        EXPECT_FALSE(std::filesystem::is_empty(directory));
+    }
+    ASSERT_EQ(received.size(), 2 * count);
+    for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(received[2 * i], "key" + std::to_string(i));
+        EXPECT_EQ(received[2 * i + 1], "value" + std::to_string(i));
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+}
+#endif
+
+}  // namespace zmqzext
@@ -214,6 +214,52 @@ TEST_F(UTestPoller, MultipleSocketRemovalsMaintainConsistency) {
     EXPECT_EQ(nullptr, readySocket);
 }
 
+TEST_F(UTestPoller, ReportsSocketsReadyToSend) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    zmq::socket_t unconnectedSocket{ctx, zmq::socket_type::push};
+
+    poller.add_writable(unconnectedSocket);
+    poller.add_writable(sockets.socketPush);
+
+    auto const readySockets = poller.wait_all(std::chrono::milliseconds{1000});
+
+    EXPECT_TRUE(readySockets.empty());
+    ASSERT_EQ(poller.writable_sockets().size(), 1u);
+    EXPECT_TRUE(sockets.socketPush == poller.writable_sockets()[0]);
+}
+
+TEST_F(UTestPoller, MonitorsSocketForReceivingAndSendingIndependently) {
+    zmq::socket_t socketA{ctx, zmq::socket_type::pair};
+    zmq::socket_t socketB{ctx, zmq::socket_type::pair};
+    socketA.bind("inproc://poller-writable");
+    socketB.connect("inproc://poller-writable");
+    send_now_or_throw(socketB, "test");
+
+    poller.add(socketA);
+    poller.add_writable(socketA);
+    auto const readySockets = poller.wait_all(std::chrono::milliseconds{10});
+
+    ASSERT_EQ(readySockets.size(), 1u);
+    EXPECT_TRUE(socketA == readySockets[0]);
+    ASSERT_EQ(poller.writable_sockets().size(), 1u);
+    EXPECT_EQ(poller.size(), 1u);
+
+    poller.remove_writable(socketA);
+    EXPECT_TRUE(socketA == poller.wait(std::chrono::milliseconds{10}));
+    EXPECT_TRUE(poller.writable_sockets().empty());
+
+    poller.remove(socketA);
+    EXPECT_EQ(poller.size(), 0u);
+}
+
+TEST_F(UTestPoller, ThrowsWhenAddingSameWritableSocketTwice) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    poller.add_writable(sockets.socketPush);
+    EXPECT_THROW(poller.add_writable(sockets.socketPush), std::invalid_argument);
+    zmq::socket_t nullSocket{};
+    EXPECT_THROW(poller.add_writable(nullSocket), std::invalid_argument);
+}
+
 #if !defined(WIN32)
 TEST_F(UTestPollerWithInterruptHandler, WaitCallIsTerminatedWhenInterrupted) {
     ConnectedSocketsPullAndPush sockets1{ctx};
@@ -582,4 +628,59 @@ TEST_F(UTestPoller, CopiedPollerCanBeUsedIndependently) {
     EXPECT_EQ(nullSocket, socket2);
 }
 
+TEST_F(UTestPoller, WaitReadyKeepsTheSocketsReadyToReceive) {
+    ConnectedSocketsPullAndPush sockets1{ctx};
+    ConnectedSocketsPullAndPush sockets2{ctx};
+
+    poller.add(sockets1.socketPull);
+    poller.add(sockets2.socketPull);
+
+    send_now_or_throw(sockets2.socketPush, "Test message 2");
+    send_now_or_throw(sockets1.socketPush, "Test message 1");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    ASSERT_EQ(2U, poller.wait_ready(std::chrono::milliseconds{10}));
+    ASSERT_EQ(2U, poller.ready_sockets().size());
+    EXPECT_TRUE(sockets1.socketPull == poller.ready_sockets()[0]);
+    EXPECT_TRUE(sockets2.socketPull == poller.ready_sockets()[1]);
+    recv_now_or_throw(poller.ready_sockets()[0]);
+    recv_now_or_throw(poller.ready_sockets()[1]);
+
+    EXPECT_EQ(0U, poller.wait_ready(std::chrono::milliseconds{1}));
+    EXPECT_TRUE(poller.ready_sockets().empty());
+}
+
+TEST_F(UTestPoller, AllocatesFromTheGivenMemoryResource) {
+    ConnectedSocketsPullAndPush sockets1{ctx};
+    ConnectedSocketsPullAndPush sockets2{ctx};
+    counting_resource_t resource;
+    poller_t pmr_poller{&resource};
+    EXPECT_EQ(&resource, pmr_poller.resource());
+
+    pmr_poller.add(sockets1.socketPull);
+    pmr_poller.add(sockets2.socketPull);
+    EXPECT_GT(resource.allocations, 0U);
+
+    for (int round = 0; round < 2; ++round) {
+        send_now_or_throw(sockets1.socketPush, "Test message 1");
+        send_now_or_throw(sockets2.socketPush, "Test message 2");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        auto const allocations = resource.allocations;
+        ASSERT_EQ(2U, pmr_poller.wait_ready(std::chrono::milliseconds{10}));
+        recv_now_or_throw(sockets1.socketPull);
+        recv_now_or_throw(sockets2.socketPull);
+        if (round > 0) {
+            // The ready list reuses the capacity of the previous wait
+            EXPECT_EQ(allocations, resource.allocations);
+        }
+    }
+
+    // As with the standard pmr containers, copies use the default resource and moves keep the resource
+    poller_t const copy{pmr_poller};
+    EXPECT_EQ(std::pmr::get_default_resource(), copy.resource());
+    poller_t const moved{std::move(pmr_poller)};
+    EXPECT_EQ(&resource, moved.resource());
+}
+
 }  // namespace zmqzext
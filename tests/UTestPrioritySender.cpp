@@ -0,0 +1,151 @@
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/priority_sender.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestPrioritySender : public ::testing::Test {
+public:
+    UTestPrioritySender() : socketPull{ctx, zmq::socket_type::pull}, socketPush{ctx, zmq::socket_type::push} {
+        socketPull.set(zmq::sockopt::linger, 0);
+        socketPush.set(zmq::sockopt::linger, 0);
+        socketPull.set(zmq::sockopt::rcvhwm, 1);
+        socketPush.set(zmq::sockopt::sndhwm, 1);
+        socketPull.bind("inproc://priority-sender");
+        socketPush.connect("inproc://priority-sender");
+    }
+
+    /// Fill the socket pipe with "fill" messages, so the next messages are queued by the sender
+    std::size_t fill_socket() {
+        std::size_t count = 0;
+        while (socketPush.send(zmq::str_buffer("fill"), zmq::send_flags::dontwait)) {
+            ++count;
+        }
+        return count;
+    }
+
+    /// Message of a given size starting with a tag
+    static std::string tagged(std::string tag, std::size_t size) {
+        tag.resize(size, '.');
+        return tag;
+    }
+
+    /// Receive messages in the loop until the expected number of frames was received, keeping the tags
+    void receive_in_loop(std::size_t frames) {
+        loop.add(socketPull, [this, frames](loop_t&, zmq::socket_ref socket) {
+            auto const msg = recv_now_or_throw(socket).to_string();
+            received.push_back(msg.substr(0, msg.find('.')));
+            return received.size() < frames;
+        });
+        loop.run(false);
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t socketPull;
+    zmq::socket_t socketPush;
+    loop_t loop;
+    std::vector<std::string> received;
+};
+
+TEST_F(UTestPrioritySender, SendsDirectlyWhileNothingIsQueued) {
+    priority_sender_t sender{loop, socketPush};
+
+    sender.send(1, zmq::str_buffer("test"));
+
+    EXPECT_TRUE(sender.empty());
+    EXPECT_EQ(recv_now_or_throw(socketPull).to_string(), "test");
+}
+
+TEST_F(UTestPrioritySender, ControlMessagesOvertakeQueuedBulkMessages) {
+    priority_sender_t sender{loop, socketPush};
+    auto const filled = fill_socket();
+    for (int i = 0; i < 10; ++i) {
+        sender.send(1, zmq::buffer(tagged("bulk", 1000)));
+    }
+    sender.send(0, zmq::str_buffer("control"));
+    EXPECT_EQ(10, sender.queued_messages(1));
+    EXPECT_EQ(10000, sender.queued_bytes(1));
+    EXPECT_EQ(1, sender.queued_messages(0));
+
+    receive_in_loop(filled + 11);
+
+    EXPECT_EQ("control", received[filled]);
+    EXPECT_TRUE(sender.empty());
+    EXPECT_EQ(0, sender.queued_bytes(1));
+}
+
+TEST_F(UTestPrioritySender, QuantaShareTheSocketBetweenQueues) {
+    priority_sender_t sender{loop, socketPush, priority_sender_options_t{{100, 100}}};
+    auto const filled = fill_socket();
+    for (int i = 0; i < 6; ++i) {
+        sender.send(0, zmq::buffer(tagged("c" + std::to_string(i), 50)));
+        sender.send(1, zmq::buffer(tagged("b" + std::to_string(i), 50)));
+    }
+
+    receive_in_loop(filled + 12);
+
+    std::vector<std::string> const expected{"c0", "c1", "b0", "b1", "c2", "c3", "b2", "b3", "c4", "c5", "b4", "b5"};
+    EXPECT_EQ(expected, std::vector<std::string>(received.begin() + filled, received.end()));
+}
+
+TEST_F(UTestPrioritySender, MessagesLargerThanTheQuantumAreSentAfterEnoughRounds) {
+    priority_sender_t sender{loop, socketPush, priority_sender_options_t{{1000, 100}}};
+    auto const filled = fill_socket();
+    sender.send(1, zmq::buffer(tagged("large", 350)));
+    for (int i = 0; i < 5; ++i) {
+        sender.send(0, zmq::buffer(tagged("c" + std::to_string(i), 1000)));
+    }
+
+    receive_in_loop(filled + 6);
+
+    // The large message earns 100 bytes per round and fits in the 4th one, after the control message of the round
+    std::vector<std::string> const expected{"c0", "c1", "c2", "c3", "large", "c4"};
+    EXPECT_EQ(expected, std::vector<std::string>(received.begin() + filled, received.end()));
+}
+
+TEST_F(UTestPrioritySender, MultipartMessagesAreSentWhole) {
+    priority_sender_t sender{loop, socketPush};
+    auto const filled = fill_socket();
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(std::string{"part 1"});
+    frames.emplace_back(std::string{"part 2"});
+    sender.send(1, std::move(frames));
+    sender.send(0, zmq::str_buffer("control"));
+
+    std::vector<zmq::message_t> messages;
+    loop.add(socketPull, [&](loop_t&, zmq::socket_ref socket) {
+        messages.push_back(recv_now_or_throw(socket));
+        return messages.size() < filled + 3;
+    });
+    loop.run(false);
+
+    ASSERT_EQ(filled + 3, messages.size());
+    EXPECT_EQ("control", messages[filled].to_string());
+    EXPECT_EQ("part 1", messages[filled + 1].to_string());
+    EXPECT_TRUE(messages[filled + 1].more());
+    EXPECT_EQ("part 2", messages[filled + 2].to_string());
+    EXPECT_FALSE(messages[filled + 2].more());
+}
+
+TEST_F(UTestPrioritySender, RejectsInvalidArguments) {
+    EXPECT_THROW((priority_sender_t{loop, zmq::socket_ref{}}), std::invalid_argument);
+    EXPECT_THROW((priority_sender_t{loop, socketPush, priority_sender_options_t{{}}}), std::invalid_argument);
+    EXPECT_THROW((priority_sender_t{loop, socketPush, priority_sender_options_t{{100, 0}}}), std::invalid_argument);
+    EXPECT_THROW((priority_sender_t{loop, socketPush, priority_sender_options_t{{100}, 0}}), std::invalid_argument);
+
+    priority_sender_t sender{loop, socketPush};
+    EXPECT_EQ(2, sender.priorities());
+    EXPECT_THROW(sender.send(2, zmq::str_buffer("test")), std::invalid_argument);
+    EXPECT_THROW(sender.send(0, std::vector<zmq::message_t>{}), std::invalid_argument);
+    EXPECT_THROW(sender.queued_messages(2), std::invalid_argument);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,190 @@
+#include <cppzmqzoltanext/pubsub_hub.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestPubSubHub : public ::testing::Test {
+public:
+    using frames_t = std::vector<std::string>;
+
+    UTestPubSubHub() : hub{ctx}, publisher{ctx, zmq::socket_type::push} {
+        publisher.set(zmq::sockopt::linger, 0);
+        publisher.connect(hub.publish_endpoint());
+    }
+
+    zmq::socket_t connect_subscriber() {
+        zmq::socket_t socket{ctx, zmq::socket_type::dealer};
+        socket.set(zmq::sockopt::linger, 0);
+        socket.connect(hub.subscribe_endpoint());
+        return socket;
+    }
+
+    static void subscribe(zmq::socket_ref subscriber, std::string const& prefix) {
+        send_now_or_throw(subscriber, std::string(1, '\x01') + prefix);
+    }
+
+    static void unsubscribe(zmq::socket_ref subscriber, std::string const& prefix) {
+        send_now_or_throw(subscriber, std::string(1, '\x00') + prefix);
+    }
+
+    void publish(frames_t const& frames) {
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            publisher.send(zmq::buffer(frames[i]),
+                           i + 1 < frames.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+        }
+    }
+
+    static frames_t recv_frames(zmq::socket_ref subscriber) {
+        waitSocketHaveMsg(subscriber, std::chrono::milliseconds{1000});
+        frames_t frames;
+        zmq::message_t msg;
+        do {
+            msg = recv_now_or_throw(subscriber);
+            frames.push_back(msg.to_string());
+        } while (msg.more());
+        return frames;
+    }
+
+    /**
+     * Wait until the hub handled the commands already sent by the subscribers and route the messages already
+     * published, returning the messages received before, the synchronization messages excepted
+     */
+    std::vector<frames_t> sync(zmq::socket_ref subscriber) {
+        auto const topic = "sync-" + std::to_string(++sync_count);
+        subscribe(subscriber, topic);
+        std::vector<frames_t> received;
+        while (true) {
+            publish({topic});
+            zmq::pollitem_t item{subscriber.handle(), 0, ZMQ_POLLIN, 0};
+            while (zmq::poll(&item, 1, std::chrono::milliseconds{1}) > 0) {
+                auto frames = recv_frames(subscriber);
+                if (frames.front() == topic) {
+                    unsubscribe(subscriber, topic);
+                    return received;
+                }
+                if (frames.front().rfind("sync-", 0) != 0) {
+                    received.push_back(frames);
+                }
+            }
+        }
+    }
+
+    zmq::context_t ctx;
+    pubsub_hub_t hub;
+    zmq::socket_t publisher;
+    std::size_t sync_count{0};
+};
+
+TEST_F(UTestPubSubHub, DeliversMessagesMatchingSubscribedPrefix) {
+    auto subscriber = connect_subscriber();
+    subscribe(subscriber, "weather.");
+    sync(subscriber);
+
+    publish({"weather.paris", "sunny", "20"});
+    publish({"sports.tennis", "final"});
+    publish({"weather.rome", "rainy"});
+
+    EXPECT_EQ(sync(subscriber),
+              (std::vector<frames_t>{{"weather.paris", "sunny", "20"}, {"weather.rome", "rainy"}}));
+}
+
+TEST_F(UTestPubSubHub, DeliversOnceWhenSeveralPrefixesMatch) {
+    auto subscriber = connect_subscriber();
+    subscribe(subscriber, "");
+    subscribe(subscriber, "a");
+    subscribe(subscriber, "ab");
+    subscribe(subscriber, "abc");
+    sync(subscriber);
+
+    publish({"abcd", "1"});
+    publish({"b", "2"});
+
+    EXPECT_EQ(sync(subscriber), (std::vector<frames_t>{{"abcd", "1"}, {"b", "2"}}));
+}
+
+TEST_F(UTestPubSubHub, FansOutToMatchingSubscribersOnly) {
+    auto all = connect_subscriber();
+    auto x = connect_subscriber();
+    auto y = connect_subscriber();
+    subscribe(all, "");
+    subscribe(x, "x");
+    subscribe(y, "y");
+    sync(all);
+    sync(x);
+    sync(y);
+    std::string const payload(1000, 'p');
+
+    publish({"x1", payload});
+    publish({"y1", payload});
+    publish({"z1", payload});
+
+    EXPECT_EQ(sync(all), (std::vector<frames_t>{{"x1", payload}, {"y1", payload}, {"z1", payload}}));
+    EXPECT_EQ(sync(x), (std::vector<frames_t>{{"x1", payload}}));
+    EXPECT_EQ(sync(y), (std::vector<frames_t>{{"y1", payload}}));
+}
+
+TEST_F(UTestPubSubHub, SubscriptionsAreReferenceCounted) {
+    auto subscriber = connect_subscriber();
+    subscribe(subscriber, "topic");
+    subscribe(subscriber, "topic");
+    unsubscribe(subscriber, "topic");
+    sync(subscriber);
+
+    publish({"topic", "1"});
+    EXPECT_EQ(sync(subscriber), (std::vector<frames_t>{{"topic", "1"}}));
+
+    unsubscribe(subscriber, "topic");
+    sync(subscriber);
+    publish({"topic", "2"});
+    EXPECT_EQ(sync(subscriber), (std::vector<frames_t>{}));
+}
+
+TEST_F(UTestPubSubHub, SplitsAndMergesSharedPrefixes) {
+    auto subscriber = connect_subscriber();
+    subscribe(subscriber, "news.sports");
+    subscribe(subscriber, "news.science");
+    subscribe(subscriber, "news");
+    unsubscribe(subscriber, "news");
+    unsubscribe(subscriber, "news.sports");
+    sync(subscriber);
+
+    publish({"news.sports"});
+    publish({"news.science.space"});
+    publish({"news"});
+
+    EXPECT_EQ(sync(subscriber), (std::vector<frames_t>{{"news.science.space"}}));
+}
+
+TEST_F(UTestPubSubHub, KeepsRoutingAfterSubscriberDisconnects) {
+    auto subscriber = connect_subscriber();
+    subscribe(subscriber, "t");
+    {
+        auto gone = connect_subscriber();
+        subscribe(gone, "t");
+        sync(gone);
+    }
+    sync(subscriber);
+
+    publish({"t", "1"});
+    publish({"t", "2"});
+
+    EXPECT_EQ(sync(subscriber), (std::vector<frames_t>{{"t", "1"}, {"t", "2"}}));
+}
+
+TEST_F(UTestPubSubHub, HubsRebuiltAtTheSameAddressBindNewEndpoints) {
+    std::string previous;
+    for (int i = 0; i < 200; ++i) {
+        pubsub_hub_t rebuilt{ctx};
+        EXPECT_NE(previous, rebuilt.publish_endpoint());
+        previous = rebuilt.publish_endpoint();
+    }
+}
+
+}  // namespace zmqzext
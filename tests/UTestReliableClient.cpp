@@ -0,0 +1,189 @@
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/reliable_client.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestReliableClient : public ::testing::Test {
+public:
+    UTestReliableClient() : server{ctx, zmq::socket_type::router} {
+        server.set(zmq::sockopt::linger, 0);
+        server.bind("inproc://reliable-server");
+        options.endpoints = {"inproc://reliable-server"};
+        options.timeout = std::chrono::milliseconds{50};
+        options.initial_backoff = std::chrono::milliseconds{5};
+    }
+
+    /// Echo the requests received by the server, with a prefix, dropping the first ones
+    void serve_in_loop(std::size_t dropped = 0) {
+        loop.add(server, [this, dropped](loop_t&, zmq::socket_ref socket) {
+            std::vector<zmq::message_t> frames;
+            do {
+                frames.emplace_back();
+                socket.recv(frames.back());
+            } while (frames.back().more());
+            if (++served <= dropped) {
+                return true;
+            }
+            for (std::size_t i = 0; i < frames.size(); ++i) {
+                if (i + 1 == frames.size()) {
+                    socket.send(zmq::buffer("re:" + frames[i].to_string()));
+                } else {
+                    socket.send(frames[i], zmq::send_flags::sndmore);
+                }
+            }
+            return true;
+        });
+    }
+
+    /// Run the loop until the given number of requests completed
+    void run_until(std::size_t completions) {
+        loop.add_timer(std::chrono::milliseconds{1}, 0,
+                       [this, completions](loop_t&, timer_id_t) { return results.size() < completions; });
+        loop.add_timer(std::chrono::milliseconds{5000}, 1, [](loop_t&, timer_id_t) { return false; });
+        loop.run(false);
+    }
+
+    fn_reply_handler_t record() {
+        return [this](request_result_t result, std::vector<zmq::message_t>& reply) {
+            results.push_back(result);
+            replies.push_back(reply.empty() ? std::string{} : reply.back().to_string());
+        };
+    }
+
+    static std::vector<zmq::message_t> frames(std::string const& body) {
+        std::vector<zmq::message_t> result;
+        result.emplace_back(body);
+        return result;
+    }
+
+    zmq::context_t ctx;
+    zmq::socket_t server;
+    loop_t loop;
+    reliable_client_options_t options;
+    std::size_t served{0};
+    std::vector<request_result_t> results;
+    std::vector<std::string> replies;
+};
+
+TEST_F(UTestReliableClient, ReceivesReplyMatchedToRequest) {
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop();
+
+    client.request(frames("hello"), record());
+    run_until(1);
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], request_result_t::reply);
+    EXPECT_EQ(replies[0], "re:hello");
+    EXPECT_EQ(client.outstanding(), 0u);
+}
+
+TEST_F(UTestReliableClient, PipelinesUpToMaxOutstandingRequests) {
+    options.max_outstanding = 8;
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop();
+    std::size_t const count = 100;
+    std::size_t max_seen = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        client.request(frames(std::to_string(i)), [&, i](request_result_t result, std::vector<zmq::message_t>& reply) {
+            max_seen = std::max(max_seen, client.outstanding());
+            results.push_back(result);
+            EXPECT_EQ(reply.back().to_string(), "re:" + std::to_string(i));
+        });
+    }
+    EXPECT_EQ(client.outstanding(), 8u);
+    EXPECT_EQ(client.backlog(), count - 8);
+    run_until(count);
+
+    EXPECT_EQ(results.size(), count);
+    EXPECT_TRUE(std::all_of(results.begin(), results.end(), [](auto r) { return r == request_result_t::reply; }));
+    EXPECT_LE(max_seen, 8u);
+    EXPECT_EQ(client.backlog(), 0u);
+}
+
+TEST_F(UTestReliableClient, RetriesRequestWhoseReplyIsLost) {
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop(1);
+
+    client.request(frames("again"), record());
+    run_until(1);
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], request_result_t::reply);
+    EXPECT_EQ(replies[0], "re:again");
+    EXPECT_EQ(served, 2u);
+}
+
+TEST_F(UTestReliableClient, FailsAfterMaxRetries) {
+    options.max_retries = 2;
+    options.timeout = std::chrono::milliseconds{10};
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop(100);
+
+    auto const start = std::chrono::steady_clock::now();
+    client.request(frames("lost"), record());
+    run_until(1);
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], request_result_t::timeout);
+    EXPECT_EQ(served, 3u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{30 + 5 + 10});
+}
+
+TEST_F(UTestReliableClient, FailsOverToNextEndpoint) {
+    options.endpoints = {"inproc://reliable-dead-server", "inproc://reliable-server"};
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop();
+    EXPECT_EQ(client.endpoint(), "inproc://reliable-dead-server");
+
+    client.request(frames("first"), record());
+    client.request(frames("second"), record());
+    run_until(2);
+
+    EXPECT_EQ(client.endpoint(), "inproc://reliable-server");
+    EXPECT_EQ(results, (std::vector<request_result_t>{request_result_t::reply, request_result_t::reply}));
+    std::sort(replies.begin(), replies.end());
+    EXPECT_EQ(replies, (std::vector<std::string>{"re:first", "re:second"}));
+}
+
+TEST_F(UTestReliableClient, CancelledRequestHandlerIsNotCalled) {
+    options.max_outstanding = 1;
+    reliable_client_t client{ctx, loop, options};
+    serve_in_loop();
+
+    auto const first = client.request(frames("first"), record());
+    auto const second = client.request(frames("second"), record());
+    client.request(frames("third"), record());
+
+    EXPECT_TRUE(client.cancel(second));
+    EXPECT_TRUE(client.cancel(first));
+    EXPECT_FALSE(client.cancel(first));
+    run_until(1);
+
+    EXPECT_EQ(replies, (std::vector<std::string>{"re:third"}));
+}
+
+TEST_F(UTestReliableClient, ThrowsOnInvalidArguments) {
+    reliable_client_options_t no_endpoint;
+    EXPECT_THROW(reliable_client_t(ctx, loop, no_endpoint), std::invalid_argument);
+
+    options.max_outstanding = 0;
+    EXPECT_THROW(reliable_client_t(ctx, loop, options), std::invalid_argument);
+
+    options.max_outstanding = 1;
+    reliable_client_t client{ctx, loop, options};
+    EXPECT_THROW(client.request({}, record()), std::invalid_argument);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,312 @@
+#include <cppzmqzoltanext/actor.h>
+#include <cppzmqzoltanext/helpers.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/poller.h>
+#include <cppzmqzoltanext/ring_pipe.h>
+#include <cppzmqzoltanext/signal.h>
+#include <cppzmqzoltanext/thread_usage.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestRingPipe : public ::testing::Test {
+public:
+    zmq::context_t ctx;
+};
+
+TEST_F(UTestRingPipe, FrameSentThroughOneEndpointIsReceivedByTheOther) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    std::string const msgStrToSend{"Test message"};
+
+    ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+
+    zmq::message_t msg;
+    auto const result = child.recv(msg, zmq::recv_flags::dontwait);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(msgStrToSend.size(), *result);
+    EXPECT_EQ(msgStrToSend, msg.to_string());
+    EXPECT_FALSE(child.more());
+}
+
+TEST_F(UTestRingPipe, DirectionsAreIndependent) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+
+    parent.send(zmq::buffer(std::string{"to child"}));
+    child.send(zmq::buffer(std::string{"to parent"}));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(parent.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("to parent", msg.to_string());
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("to child", msg.to_string());
+}
+
+TEST_F(UTestRingPipe, NonBlockingRecvReturnsEmptyResultWhenEmpty) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+
+    zmq::message_t msg;
+    EXPECT_FALSE(child.recv(msg, zmq::recv_flags::dontwait));
+}
+
+TEST_F(UTestRingPipe, NonBlockingSendReturnsEmptyResultWhenFull) {
+    auto [parent, child] = ring_pipe_t::create_pair(64);
+    std::string const msgStrToSend(24, 'x');
+
+    EXPECT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+    EXPECT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+    EXPECT_FALSE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+}
+
+TEST_F(UTestRingPipe, BlockingSendSleepsUntilThePeerFreesSpace) {
+    auto [parent, child] = ring_pipe_t::create_pair(64);
+    std::string const msgStrToSend(24, 'x');
+    ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+    ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+
+    std::chrono::nanoseconds senderCpuTime{0};
+    std::thread sender([&parent = parent, &msgStrToSend, &senderCpuTime]() {
+        auto const start = current_thread_usage().cpu_time;
+        parent.send(zmq::buffer(msgStrToSend));
+        senderCpuTime = current_thread_usage().cpu_time - start;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    zmq::message_t msg;
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    sender.join();
+
+    // Woken up by the receiver, the sender did not spin while the ring was full
+    EXPECT_LT(senderCpuTime, std::chrono::milliseconds{20});
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ(msgStrToSend, msg.to_string());
+}
+
+TEST_F(UTestRingPipe, BlockingOperationsFailOnceThePeerIsDestroyed) {
+    auto endpoints = ring_pipe_t::create_pair(64);
+    auto& parent = endpoints.first;
+    std::string const msgStrToSend(24, 'x');
+    ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+    ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+    { auto const child = std::move(endpoints.second); }
+
+    try {
+        parent.send(zmq::buffer(msgStrToSend));
+        FAIL() << "Expected zmq::error_t";
+    } catch (zmq::error_t const& e) {
+        EXPECT_EQ(EPIPE, e.num());
+    }
+    zmq::message_t msg;
+    try {
+        parent.recv(msg);
+        FAIL() << "Expected zmq::error_t";
+    } catch (zmq::error_t const& e) {
+        EXPECT_EQ(EPIPE, e.num());
+    }
+}
+
+TEST_F(UTestRingPipe, ThrowsWhenSendingFrameLargerThanCapacity) {
+    auto [parent, child] = ring_pipe_t::create_pair(64);
+    std::string const msgStrToSend(parent.max_message_size() + 1, 'x');
+
+    EXPECT_THROW(parent.send(zmq::buffer(msgStrToSend)), std::invalid_argument);
+}
+
+TEST_F(UTestRingPipe, CapacityIsRoundedUpToPowerOfTwo) {
+    auto [parent, child] = ring_pipe_t::create_pair(1000);
+
+    EXPECT_EQ(1024U, parent.capacity());
+    EXPECT_EQ(1024U, child.capacity());
+}
+
+TEST_F(UTestRingPipe, KeepsMultipartFlag) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+
+    parent.send(zmq::buffer(std::string{"part1"}), zmq::send_flags::sndmore);
+    parent.send(zmq::buffer(std::string{"part2"}));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("part1", msg.to_string());
+    EXPECT_TRUE(child.more());
+    ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("part2", msg.to_string());
+    EXPECT_FALSE(child.more());
+}
+
+TEST_F(UTestRingPipe, TruncatesFrameLargerThanReceiveBuffer) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    parent.send(zmq::buffer(std::string{"0123456789"}));
+
+    char buffer[4];
+    auto const result = child.recv(zmq::buffer(buffer, sizeof(buffer)), zmq::recv_flags::dontwait);
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(4U, result->size);
+    EXPECT_EQ(10U, result->untruncated_size);
+    EXPECT_EQ("0123", std::string(buffer, 4));
+}
+
+TEST_F(UTestRingPipe, KeepsOrderAcrossBufferWrapAround) {
+    auto [parent, child] = ring_pipe_t::create_pair(256);
+
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        std::string const msgStrToSend(i % 50, static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(parent.send(zmq::buffer(msgStrToSend), zmq::send_flags::dontwait));
+        zmq::message_t msg;
+        ASSERT_TRUE(child.recv(msg, zmq::recv_flags::dontwait));
+        ASSERT_EQ(msgStrToSend, msg.to_string());
+    }
+}
+
+TEST_F(UTestRingPipe, DeliversAllFramesInOrderBetweenThreads) {
+    auto [parent, child] = ring_pipe_t::create_pair(4096);
+    std::uint32_t const numMsgs = 100000;
+
+    std::thread producer([&parent = parent, numMsgs]() {
+        for (std::uint32_t i = 0; i < numMsgs; ++i) {
+            parent.send(zmq::buffer(&i, sizeof(i)));
+        }
+    });
+
+    std::uint32_t expected = 0;
+    for (; expected < numMsgs; ++expected) {
+        std::uint32_t value = 0;
+        auto const result = recv_retry_on_eintr(child, zmq::buffer(&value, sizeof(value)));
+        ASSERT_TRUE(result);
+        ASSERT_EQ(expected, value);
+    }
+    producer.join();
+
+    zmq::message_t msg;
+    EXPECT_FALSE(child.recv(msg, zmq::recv_flags::dontwait));
+}
+
+TEST_F(UTestRingPipe, PollerReportsDescriptorReadyOnlyWhileFramesArePending) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    poller_t poller;
+    poller.add_fd(child.fd());
+
+    poller.wait_all(std::chrono::milliseconds{0});
+    EXPECT_TRUE(poller.ready_fds().empty());
+
+    parent.send(zmq::buffer(std::string{"msg1"}));
+    parent.send(zmq::buffer(std::string{"msg2"}));
+
+    auto sockets = poller.wait_all(std::chrono::milliseconds{10});
+    EXPECT_TRUE(sockets.empty());
+    ASSERT_EQ(1U, poller.ready_fds().size());
+    EXPECT_EQ(child.fd(), poller.ready_fds()[0]);
+
+    zmq::message_t msg;
+    child.recv(msg);
+    poller.wait_all(std::chrono::milliseconds{0});
+    EXPECT_EQ(1U, poller.ready_fds().size());
+
+    child.recv(msg);
+    poller.wait_all(std::chrono::milliseconds{0});
+    EXPECT_TRUE(poller.ready_fds().empty());
+}
+
+TEST_F(UTestRingPipe, PollerThrowsWhenAddingSameDescriptorTwice) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    poller_t poller;
+    poller.add_fd(child.fd());
+
+    EXPECT_THROW(poller.add_fd(child.fd()), std::invalid_argument);
+}
+
+TEST_F(UTestRingPipe, PollerDoesNotReportRemovedDescriptor) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    poller_t poller;
+    poller.add_fd(child.fd());
+    poller.remove_fd(child.fd());
+    parent.send(zmq::buffer(std::string{"msg"}));
+
+    poller.wait_all(std::chrono::milliseconds{0});
+
+    EXPECT_EQ(0U, poller.size());
+    EXPECT_TRUE(poller.ready_fds().empty());
+}
+
+TEST_F(UTestRingPipe, LoopCallsDescriptorHandler) {
+    auto [parent, child] = ring_pipe_t::create_pair(1024);
+    loop_t loop;
+    std::vector<std::string> received;
+
+    loop.add_fd(child.fd(), [&child = child, &received](loop_t&, zmq::fd_t) {
+        zmq::message_t msg;
+        while (child.recv(msg, zmq::recv_flags::dontwait)) {
+            received.push_back(msg.to_string());
+        }
+        return received.size() < 3;
+    });
+
+    parent.send(zmq::buffer(std::string{"msg1"}));
+    parent.send(zmq::buffer(std::string{"msg2"}));
+    auto t = std::thread([&parent = parent]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        parent.send(zmq::buffer(std::string{"msg3"}));
+    });
+
+    loop.run();
+    t.join();
+
+    EXPECT_EQ((std::vector<std::string>{"msg1", "msg2", "msg3"}), received);
+}
+
+TEST_F(UTestRingPipe, ActorExchangesMessagesThroughPipe) {
+    actor_t actor(ctx);
+
+    actor.start(
+        [](zmq::socket_t& socket, ring_pipe_t& pipe) {
+            loop_t loop;
+            loop.add(socket, [](loop_t&, zmq::socket_ref s) {
+                zmq::message_t msg;
+                recv_retry_on_eintr(s, msg);
+                auto const signal = signal_t::check_signal(msg);
+                return !(signal && signal->is_stop());
+            });
+            loop.add_fd(pipe.fd(), [&pipe](loop_t&, zmq::fd_t) {
+                zmq::message_t msg;
+                while (pipe.recv(msg, zmq::recv_flags::dontwait)) {
+                    pipe.send(zmq::buffer(msg.data(), msg.size()));
+                }
+                return true;
+            });
+            send_retry_on_eintr(socket, signal_t::create_success());
+            loop.run(false);
+            return true;
+        },
+        4096);
+
+    ASSERT_TRUE(actor.has_pipe());
+    actor.pipe().send(zmq::buffer(std::string{"echo"}));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(recv_retry_on_eintr(actor.pipe(), msg));
+    EXPECT_EQ("echo", msg.to_string());
+    EXPECT_TRUE(actor.stop(std::chrono::milliseconds{1000}));
+}
+
+TEST_F(UTestRingPipe, ActorWithoutPipeThrowsOnPipeAccess) {
+    actor_t actor(ctx);
+
+    EXPECT_FALSE(actor.has_pipe());
+    EXPECT_THROW(actor.pipe(), std::runtime_error);
+}
+
+}  // namespace zmqzext
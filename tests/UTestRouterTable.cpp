@@ -0,0 +1,149 @@
+#include <cppzmqzoltanext/router_table.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestRouterTable : public ::testing::Test {
+public:
+    using table_t = router_table_t<std::string>;
+
+    static std::string* find(table_t& table, std::string const& identity) {
+        return table.find(identity.data(), identity.size());
+    }
+
+    static bool add(table_t& table, std::string const& identity, std::string const& state) {
+        return table.try_emplace(identity.data(), identity.size(), state).second;
+    }
+
+    static bool erase(table_t& table, std::string const& identity) {
+        return table.erase(identity.data(), identity.size());
+    }
+};
+
+TEST_F(UTestRouterTable, AddsFindsAndErasesPeers) {
+    table_t table;
+    EXPECT_EQ(find(table, "a"), nullptr);
+
+    EXPECT_TRUE(add(table, "a", "state a"));
+    EXPECT_TRUE(add(table, std::string("\0b", 2), "state b"));
+    EXPECT_FALSE(add(table, "a", "other"));
+
+    ASSERT_NE(find(table, "a"), nullptr);
+    EXPECT_EQ(*find(table, "a"), "state a");
+    EXPECT_EQ(*find(table, std::string("\0b", 2)), "state b");
+    EXPECT_EQ(find(table, "b"), nullptr);
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_TRUE(erase(table, "a"));
+    EXPECT_FALSE(erase(table, "a"));
+    EXPECT_EQ(find(table, "a"), nullptr);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST_F(UTestRouterTable, StoresKeysLongerThanInlineCapacity) {
+    table_t table;
+    std::string const long_identity(table_t::inline_key_capacity + 100, 'x');
+    std::string const inline_identity(table_t::inline_key_capacity, 'x');
+
+    add(table, long_identity, "long");
+    add(table, inline_identity, "inline");
+
+    EXPECT_EQ(*find(table, long_identity), "long");
+    EXPECT_EQ(*find(table, inline_identity), "inline");
+}
+
+TEST_F(UTestRouterTable, MatchesReferenceMapUnderRandomOperations) {
+    table_t table;
+    std::map<std::string, std::string> reference;
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> key_distribution{0, 2000};
+
+    for (int i = 0; i < 20000; ++i) {
+        auto const key = std::string(1, '\0') + std::to_string(key_distribution(random));
+        auto const value = std::to_string(i);
+        if (random() % 3 == 0) {
+            EXPECT_EQ(erase(table, key), reference.erase(key) == 1);
+        } else {
+            EXPECT_EQ(add(table, key, value), reference.emplace(key, value).second);
+        }
+    }
+
+    ASSERT_EQ(table.size(), reference.size());
+    for (auto const& entry : reference) {
+        auto* const state = find(table, entry.first);
+        ASSERT_NE(state, nullptr);
+        EXPECT_EQ(*state, entry.second);
+    }
+    std::size_t visited = 0;
+    table.for_each([&](zmq::const_buffer identity, std::string& state) {
+        std::string const key(static_cast<char const*>(identity.data()), identity.size());
+        EXPECT_EQ(reference.at(key), state);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST_F(UTestRouterTable, ReserveKeepsPeers) {
+    table_t table;
+    add(table, "a", "1");
+
+    table.reserve(1000);
+
+    EXPECT_EQ(*find(table, "a"), "1");
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(find(table, "a"), nullptr);
+}
+
+TEST_F(UTestRouterTable, RoutesMessagesByIdentityFrame) {
+    zmq::context_t ctx;
+    zmq::socket_t router{ctx, zmq::socket_type::router};
+    router.bind("inproc://router-table");
+    zmq::socket_t first{ctx, zmq::socket_type::dealer};
+    first.set(zmq::sockopt::routing_id, "first");
+    first.connect("inproc://router-table");
+    zmq::socket_t second{ctx, zmq::socket_type::dealer};
+    second.connect("inproc://router-table");
+
+    router_table_t<int> peers;
+    router_message_t msg;
+    first.send(zmq::str_buffer(""), zmq::send_flags::sndmore);
+    first.send(zmq::str_buffer("hello"), zmq::send_flags::none);
+    second.send(zmq::str_buffer("no envelope"), zmq::send_flags::none);
+
+    waitSocketHaveMsg(router, std::chrono::milliseconds{1000});
+    ASSERT_TRUE(msg.recv(router));
+    EXPECT_EQ(msg.identity().to_string(), "first");
+    EXPECT_EQ(msg.envelope_size(), 2u);
+    ASSERT_EQ(msg.body_size(), 1u);
+    EXPECT_EQ(msg.body(0).to_string(), "hello");
+    ++*peers.try_emplace(msg.identity(), 0).first;
+    msg.body(0).rebuild(std::string{"reply"}.data(), 5);
+    ASSERT_TRUE(msg.send(router));
+    EXPECT_EQ(recv_now_or_throw(first).to_string(), "");
+    EXPECT_EQ(recv_now_or_throw(first).to_string(), "reply");
+
+    waitSocketHaveMsg(router, std::chrono::milliseconds{1000});
+    ASSERT_TRUE(msg.recv(router));
+    EXPECT_EQ(msg.size(), 2u);
+    EXPECT_EQ(msg.envelope_size(), 1u);
+    EXPECT_EQ(msg.body(0).to_string(), "no envelope");
+    EXPECT_EQ(peers.find(msg.identity()), nullptr);
+    peers.try_emplace(msg.identity(), 10);
+
+    EXPECT_FALSE(msg.recv(router, zmq::recv_flags::dontwait));
+    EXPECT_EQ(peers.size(), 2u);
+    EXPECT_EQ(*peers.find("first", 5), 1);
+}
+
+}  // namespace zmqzext
@@ -0,0 +1,250 @@
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/poller.h>
+#include <cppzmqzoltanext/shm_ring.h>
+#include <cppzmqzoltanext/thread_usage.h>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestShmRing : public ::testing::Test {
+public:
+    UTestShmRing() : name{"utest-" + std::to_string(::getpid())} { shm_ring_t::remove(name); }
+    ~UTestShmRing() override { shm_ring_t::remove(name); }
+
+    static bool is_readable(zmq::fd_t fd) {
+        zmq::pollitem_t item{nullptr, fd, ZMQ_POLLIN, 0};
+        zmq::poll(&item, 1, std::chrono::milliseconds{0});
+        return (item.revents & ZMQ_POLLIN) != 0;
+    }
+
+    std::string const name;
+};
+
+TEST_F(UTestShmRing, FramesSentByEachEndpointAreReceivedByTheOther) {
+    auto creator = shm_ring_t::create(name, 1024);
+    auto opener = shm_ring_t::open(name);
+
+    ASSERT_TRUE(creator.send(zmq::str_buffer("part 1"), zmq::send_flags::sndmore));
+    ASSERT_TRUE(creator.send(zmq::str_buffer("part 2")));
+    ASSERT_TRUE(opener.send(zmq::str_buffer("reply"), zmq::send_flags::dontwait));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("part 1", msg.to_string());
+    EXPECT_TRUE(opener.more());
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_EQ("part 2", msg.to_string());
+    EXPECT_FALSE(opener.more());
+    EXPECT_FALSE(opener.recv(msg, zmq::recv_flags::dontwait));
+
+    char buffer[3];
+    auto const result = creator.recv(zmq::buffer(buffer), zmq::recv_flags::dontwait);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(3, result->size);
+    EXPECT_EQ(5, result->untruncated_size);
+    EXPECT_EQ(name, creator.name());
+    EXPECT_EQ(1024, opener.capacity());
+}
+
+TEST_F(UTestShmRing, DescriptorIsReadableOnlyWhileFramesArePending) {
+    auto creator = shm_ring_t::create(name, 1024);
+    auto opener = shm_ring_t::open(name);
+    EXPECT_FALSE(is_readable(opener.fd()));
+
+    ASSERT_TRUE(creator.send(zmq::str_buffer("one")));
+    ASSERT_TRUE(creator.send(zmq::str_buffer("two")));
+    EXPECT_TRUE(is_readable(opener.fd()));
+    EXPECT_FALSE(is_readable(creator.fd()));
+
+    zmq::message_t msg;
+    ASSERT_TRUE(opener.recv(msg));
+    EXPECT_TRUE(is_readable(opener.fd()));
+    ASSERT_TRUE(opener.recv(msg));
+    EXPECT_FALSE(is_readable(opener.fd()));
+}
+
+TEST_F(UTestShmRing, FullRingRefusesNonBlockingSends) {
+    auto creator = shm_ring_t::create(name, 64);
+    auto opener = shm_ring_t::open(name);
+    std::string const frame(24, 'x');
+
+    std::size_t sent = 0;
+    while (creator.send(zmq::buffer(frame), zmq::send_flags::dontwait)) {
+        ++sent;
+    }
+    EXPECT_GT(sent, 0);
+
+    zmq::message_t msg;
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_TRUE(creator.send(zmq::buffer(frame), zmq::send_flags::dontwait));
+    EXPECT_THROW(creator.send(zmq::buffer(std::string(creator.max_message_size() + 1, 'x'))), std::invalid_argument);
+}
+
+TEST_F(UTestShmRing, BlockingSendSleepsUntilThePeerFreesSpace) {
+    auto creator = shm_ring_t::create(name, 64);
+    auto opener = shm_ring_t::open(name);
+    std::string const frame(24, 'x');
+    ASSERT_TRUE(creator.send(zmq::buffer(frame), zmq::send_flags::dontwait));
+    ASSERT_TRUE(creator.send(zmq::buffer(frame), zmq::send_flags::dontwait));
+
+    std::chrono::nanoseconds senderCpuTime{0};
+    std::thread sender([&creator, &frame, &senderCpuTime]() {
+        auto const start = current_thread_usage().cpu_time;
+        creator.send(zmq::buffer(frame));
+        senderCpuTime = current_thread_usage().cpu_time - start;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    zmq::message_t msg;
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    sender.join();
+
+    EXPECT_LT(senderCpuTime, std::chrono::milliseconds{20});
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    ASSERT_TRUE(opener.recv(msg, zmq::recv_flags::dontwait));
+    EXPECT_FALSE(opener.recv(msg, zmq::recv_flags::dontwait));
+}
+
+TEST_F(UTestShmRing, BlockingOperationsFailOnceThePeerIsDestroyed) {
+    auto creator = shm_ring_t::create(name, 64);
+    std::string const frame(24, 'x');
+    ASSERT_TRUE(creator.send(zmq::buffer(frame), zmq::send_flags::dontwait));
+    ASSERT_TRUE(creator.send(zmq::buffer(frame), zmq::send_flags::dontwait));
+    { auto const opener = shm_ring_t::open(name); }
+
+    try {
+        creator.send(zmq::buffer(frame));
+        FAIL() << "Expected zmq::error_t";
+    } catch (zmq::error_t const& e) {
+        EXPECT_EQ(EPIPE, e.num());
+    }
+    zmq::message_t msg;
+    try {
+        creator.recv(msg);
+        FAIL() << "Expected zmq::error_t";
+    } catch (zmq::error_t const& e) {
+        EXPECT_EQ(EPIPE, e.num());
+    }
+}
+
+TEST_F(UTestShmRing, BlockingReceiveFailsOnceThePeerProcessExitsWithoutClosing) {
+    auto creator = shm_ring_t::create(name, 1024);
+
+    auto const pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // Leak the endpoint as a crashing process would
+        new shm_ring_t(shm_ring_t::open(name));
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(pid, ::waitpid(pid, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+
+    zmq::message_t msg;
+    try {
+        creator.recv(msg);
+        FAIL() << "Expected zmq::error_t";
+    } catch (zmq::error_t const& e) {
+        EXPECT_EQ(EPIPE, e.num());
+    }
+}
+
+TEST_F(UTestShmRing, ExchangesMessagesWithAnotherProcessThroughALoop) {
+    std::size_t const numMessages = 10000;
+    auto creator = shm_ring_t::create(name, 4096);
+
+    auto const pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // Child process: echo the messages back, then acknowledge the end
+        int status = 0;
+        try {
+            auto opener = shm_ring_t::open(name);
+            zmq::message_t msg;
+            for (std::size_t i = 0; i < numMessages; ++i) {
+                opener.recv(msg);
+                opener.send(zmq::buffer(msg.data(), msg.size()));
+            }
+        } catch (...) {
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    loop_t loop;
+    std::size_t sent = 0;
+    std::vector<std::uint64_t> received;
+    auto const send_next = [&]() {
+        std::uint64_t const value = sent;
+        if (creator.send(zmq::buffer(&value, sizeof(value)), zmq::send_flags::dontwait)) {
+            ++sent;
+        }
+    };
+    loop.add_fd(creator.fd(), [&](loop_t&, zmq::fd_t) {
+        zmq::message_t msg;
+        while (creator.recv(msg, zmq::recv_flags::dontwait)) {
+            received.push_back(*msg.data<std::uint64_t>());
+            if (sent < numMessages) {
+                send_next();
+            }
+        }
+        return received.size() < numMessages;
+    });
+    // Keep up to 16 messages in flight
+    while (sent < 16) {
+        send_next();
+    }
+    loop.run(false);
+
+    int status = -1;
+    ASSERT_EQ(pid, ::waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    ASSERT_EQ(numMessages, received.size());
+    for (std::size_t i = 0; i < numMessages; ++i) {
+        ASSERT_EQ(i, received[i]);
+    }
+}
+
+TEST_F(UTestShmRing, OpenFailsForMissingOrAlreadyOpenedPipes) {
+    EXPECT_THROW(shm_ring_t::open(name), std::system_error);
+
+    auto creator = shm_ring_t::create(name, 1024);
+    EXPECT_THROW(shm_ring_t::create(name, 1024), std::system_error);
+    {
+        auto opener = shm_ring_t::open(name);
+        EXPECT_THROW(shm_ring_t::open(name), std::runtime_error);
+    }
+    // The pipe can be opened again once the other endpoint is gone
+    EXPECT_NO_THROW(shm_ring_t::open(name));
+}
+
+TEST_F(UTestShmRing, CreatorRemovesThePipeWhenDestroyed) {
+    {
+        auto creator = shm_ring_t::create(name, 1024);
+    }
+    EXPECT_THROW(shm_ring_t::open(name), std::system_error);
+    EXPECT_NO_THROW(shm_ring_t::create(name, 1024));
+}
+
+TEST_F(UTestShmRing, RejectsInvalidNames) {
+    EXPECT_THROW(shm_ring_t::create(""), std::invalid_argument);
+    EXPECT_THROW(shm_ring_t::create("a/b"), std::invalid_argument);
+    EXPECT_THROW(shm_ring_t::open(""), std::invalid_argument);
+}
+
+}  // namespace zmqzext
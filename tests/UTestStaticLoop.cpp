@@ -0,0 +1,151 @@
+#include <cppzmqzoltanext/interrupt.h>
+#include <cppzmqzoltanext/static_loop.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.hpp>
+
+#include "utils.h"
+
+namespace zmqzext {
+
+class UTestStaticLoop : public ::testing::Test {
+public:
+    zmq::context_t ctx;
+};
+
+class UTestStaticLoopWithInterruptHandler : public UTestStaticLoop {
+public:
+    void SetUp() override { install_interrupt_handler(); }
+
+    void TearDown() override {
+        restore_interrupt_handler();
+        reset_interrupted();
+    }
+};
+
+TEST_F(UTestStaticLoop, CallsTheHandlerOfEachReadySocket) {
+    ConnectedSocketsPullAndPush sockets1{ctx};
+    ConnectedSocketsPullAndPush sockets2{ctx};
+    std::vector<std::string> received;
+
+    static_loop_t loop{static_socket(sockets1.socketPull,
+                                     [&received](zmq::socket_ref socket) {
+                                         received.push_back("1:" + recv_now_or_throw(socket).to_string());
+                                         return received.size() < 3;
+                                     }),
+                       static_socket(sockets2.socketPull, [&received](zmq::socket_ref socket) {
+                           received.push_back("2:" + recv_now_or_throw(socket).to_string());
+                           return received.size() < 3;
+                       })};
+
+    send_now_or_throw(sockets2.socketPush, "a");
+    send_now_or_throw(sockets1.socketPush, "b");
+    send_now_or_throw(sockets1.socketPush, "c");
+    waitSocketHaveMsg(sockets1.socketPull, std::chrono::milliseconds{1000});
+    waitSocketHaveMsg(sockets2.socketPull, std::chrono::milliseconds{1000});
+
+    loop.run(false);
+
+    // Ready sockets are handled in slot order, once per wake-up
+    ASSERT_EQ(3U, received.size());
+    EXPECT_EQ("1:b", received[0]);
+    EXPECT_EQ("2:a", received[1]);
+    EXPECT_EQ("1:c", received[2]);
+    EXPECT_FALSE(loop.terminated());
+}
+
+TEST_F(UTestStaticLoop, TimersFireTheirOccurrencesThenTheRunReturns) {
+    std::size_t fastCalls = 0;
+    std::size_t slowCalls = 0;
+    static_loop_t loop{static_timer(std::chrono::milliseconds{2}, 3, [&fastCalls]() { return ++fastCalls > 0; }),
+                       static_timer(std::chrono::milliseconds{5}, 1, [&slowCalls]() { return ++slowCalls > 0; })};
+
+    auto const start = std::chrono::steady_clock::now();
+    loop.run(false);
+
+    EXPECT_EQ(3U, fastCalls);
+    EXPECT_EQ(1U, slowCalls);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{5});
+
+    // Nothing left to wait for
+    loop.run(false);
+    EXPECT_EQ(3U, fastCalls);
+}
+
+TEST_F(UTestStaticLoop, TimerReturningFalseStopsTheLoopBeforeTheSockets) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    bool socketCalled = false;
+    std::size_t timerCalls = 0;
+    static_loop_t loop{static_socket(sockets.socketPull,
+                                     [&socketCalled](zmq::socket_ref socket) {
+                                         recv_now_or_throw(socket);
+                                         socketCalled = true;
+                                         return true;
+                                     }),
+                       static_timer(std::chrono::milliseconds{1}, 0, [&timerCalls]() {
+                           ++timerCalls;
+                           return false;
+                       })};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    send_now_or_throw(sockets.socketPush, "Test message");
+    waitSocketHaveMsg(sockets.socketPull, std::chrono::milliseconds{1000});
+    loop.run(false);
+
+    EXPECT_EQ(1U, timerCalls);
+    EXPECT_FALSE(socketCalled);
+
+    // The stopping timer is not rescheduled and fires again on the next run
+    loop.run(false);
+    EXPECT_EQ(2U, timerCalls);
+    EXPECT_FALSE(socketCalled);
+}
+
+TEST_F(UTestStaticLoop, ThrowsWhenConstructedWithNullSocket) {
+    zmq::socket_t nullSocket{};
+    EXPECT_THROW(static_loop_t(static_socket(nullSocket, [](zmq::socket_ref) { return true; })),
+                 std::invalid_argument);
+}
+
+TEST_F(UTestStaticLoop, IsTerminatedOnContextShutdown) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    static_loop_t loop{static_socket(sockets.socketPull, [](zmq::socket_ref) { return true; })};
+
+    auto t = shutdown_ctx_after_time(ctx, std::chrono::milliseconds{10});
+    loop.run();
+    t.join();
+
+    EXPECT_TRUE(loop.terminated());
+}
+
+TEST_F(UTestStaticLoopWithInterruptHandler, IsTerminatedWhenInterrupted) {
+    ConnectedSocketsPullAndPush sockets{ctx};
+    static_loop_t loop{static_socket(sockets.socketPull, [](zmq::socket_ref) { return true; })};
+
+    auto t = raise_interrupt_after_time(std::chrono::milliseconds{10});
+    loop.run(true, std::chrono::milliseconds{5});
+    t.join();
+
+    EXPECT_TRUE(loop.terminated());
+}
+
+TEST_F(UTestStaticLoopWithInterruptHandler, IgnoresInterruptionWhenSetToNotInterruptibleMode) {
+    bool timerRun = false;
+    static_loop_t loop{static_timer(std::chrono::milliseconds{20}, 1, [&timerRun]() {
+        timerRun = true;
+        return false;
+    })};
+
+    auto t = raise_interrupt_after_time(std::chrono::milliseconds{10});
+    loop.run(false);
+    t.join();
+
+    EXPECT_TRUE(timerRun);
+    EXPECT_FALSE(loop.terminated());
+}
+
+}  // namespace zmqzext
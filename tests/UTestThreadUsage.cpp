@@ -0,0 +1,49 @@
+#include <cppzmqzoltanext/thread_usage.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace zmqzext {
+
+class UTestThreadUsage : public ::testing::Test {
+public:
+    /// Burn CPU in the calling thread for a duration of wall time
+    static void spin_for(std::chrono::milliseconds duration) {
+        auto const until = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+};
+
+TEST_F(UTestThreadUsage, CpuTimeGrowsWhileTheThreadIsBusy) {
+    auto const before = current_thread_usage();
+    spin_for(std::chrono::milliseconds{20});
+    auto const used = current_thread_usage() - before;
+
+    EXPECT_GE(used.cpu_time, std::chrono::milliseconds{5});
+}
+
+TEST_F(UTestThreadUsage, SleepingCountsVoluntarySwitchesButNoCpuTime) {
+    auto const before = current_thread_usage();
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+    auto const used = current_thread_usage() - before;
+
+    EXPECT_LT(used.cpu_time, std::chrono::milliseconds{5});
+#if defined(__linux__)
+    EXPECT_GE(used.voluntary_switches, 5);
+#endif
+}
+
+TEST_F(UTestThreadUsage, UsageOfOtherThreadsIsNotCounted) {
+    auto const before = current_thread_usage();
+    std::thread other{[]() { spin_for(std::chrono::milliseconds{50}); }};
+    other.join();
+    auto const used = current_thread_usage() - before;
+
+    EXPECT_LT(used.cpu_time, std::chrono::milliseconds{25});
+}
+
+}  // namespace zmqzext
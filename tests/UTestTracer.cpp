@@ -0,0 +1,235 @@
+#include <cppzmqzoltanext/actor.h>
+#include <cppzmqzoltanext/helpers.h>
+#include <cppzmqzoltanext/loop.h>
+#include <cppzmqzoltanext/signal.h>
+#include <cppzmqzoltanext/tracer.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <zmq.hpp>
+
+#if !defined(WIN32)
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include "utils.h"
+
+namespace zmqzext {
+
+namespace {
+
+std::string chrome_trace() {
+    std::ostringstream os;
+    write_chrome_trace(os);
+    return os.str();
+}
+
+std::size_t count_occurrences(std::string const& text, std::string const& pattern) {
+    std::size_t count = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+std::string event(std::string const& name, char phase) {
+    return "{\"name\":\"" + name + "\",\"cat\":\"czze\",\"ph\":\"" + phase + "\"";
+}
+
+}  // namespace
+
+class UTestTracer : public ::testing::Test {
+public:
+    void SetUp() override {
+        if (!is_tracing_compiled_in()) {
+            GTEST_SKIP() << "Library built without CZZE_ENABLE_TRACING";
+        }
+        clear_trace();
+        enable_tracing();
+    }
+
+    void TearDown() override {
+        disable_tracing();
+        clear_trace();
+    }
+
+    zmq::context_t ctx;
+};
+
+TEST(UTestTracerCompiledOut, EnableHasNoEffectWhenCompiledOut) {
+    if (is_tracing_compiled_in()) {
+        GTEST_SKIP() << "Library built with CZZE_ENABLE_TRACING";
+    }
+    enable_tracing();
+
+    EXPECT_FALSE(is_tracing_enabled());
+    EXPECT_FALSE(trace_begin("user.event"));
+    EXPECT_EQ(0U, count_occurrences(chrome_trace(), "user.event"));
+}
+
+TEST_F(UTestTracer, UserEventsAreExportedAsChromeTraceEvents) {
+    {
+        trace_scope_t scope("user.event");
+    }
+
+    auto const trace = chrome_trace();
+
+    EXPECT_EQ(0U, trace.find("{\"traceEvents\":["));
+    EXPECT_EQ(1U, count_occurrences(trace, event("user.event", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("user.event", 'E')));
+}
+
+TEST_F(UTestTracer, EventNamesAreEscaped) {
+    trace_begin("user \"quoted\"");
+    trace_end("user \"quoted\"");
+
+    EXPECT_EQ(2U, count_occurrences(chrome_trace(), "\"user \\\"quoted\\\"\""));
+}
+
+TEST_F(UTestTracer, DisabledTracerRecordsNothing) {
+    disable_tracing();
+
+    EXPECT_FALSE(trace_begin("user.event"));
+    EXPECT_EQ(0U, count_occurrences(chrome_trace(), "user.event"));
+}
+
+TEST_F(UTestTracer, ClearDiscardsRecordedEvents) {
+    trace_begin("user.event");
+    trace_end("user.event");
+
+    clear_trace();
+
+    EXPECT_EQ(0U, count_occurrences(chrome_trace(), "user.event"));
+}
+
+TEST_F(UTestTracer, OldestEventsAreOverwrittenWhenBufferIsFull) {
+    for (std::size_t i = 0; i < k_trace_buffer_events; ++i) {
+        trace_begin("old.event");
+    }
+    for (std::size_t i = 0; i < k_trace_buffer_events; ++i) {
+        trace_begin("new.event");
+    }
+
+    auto const trace = chrome_trace();
+
+    EXPECT_EQ(0U, count_occurrences(trace, "old.event"));
+    EXPECT_EQ(k_trace_buffer_events - 1, count_occurrences(trace, "new.event"));
+}
+
+TEST_F(UTestTracer, EventsOfFinishedThreadsAreExported) {
+    std::thread t([]() { trace_scope_t scope("thread.event"); });
+    t.join();
+
+    EXPECT_EQ(2U, count_occurrences(chrome_trace(), "thread.event"));
+}
+
+TEST_F(UTestTracer, LoopRecordsPollAndHandlerEvents) {
+    zmq::socket_t sender(ctx, zmq::socket_type::pair);
+    zmq::socket_t receiver(ctx, zmq::socket_type::pair);
+    receiver.bind("inproc://test-tracer");
+    sender.connect("inproc://test-tracer");
+    sender.send(zmq::str_buffer("msg"), zmq::send_flags::none);
+
+    loop_t loop;
+    loop.add(receiver, [](loop_t&, zmq::socket_ref socket) {
+        zmq::message_t msg;
+        (void)socket.recv(msg, zmq::recv_flags::dontwait);
+        return true;
+    });
+    loop.add_timer(std::chrono::milliseconds{5}, 1, [](loop_t&, timer_id_t) { return false; });
+    loop.run(false);
+
+    auto const trace = chrome_trace();
+    EXPECT_LE(1U, count_occurrences(trace, event("loop.poll", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("loop.socket", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("loop.socket", 'E')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("loop.timer", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("loop.timer", 'E')));
+}
+
+TEST_F(UTestTracer, ActorRecordsStartRunAndStopEvents) {
+    {
+        actor_t actor(ctx);
+        actor.start([](zmq::socket_t& socket) {
+            send_retry_on_eintr(socket, signal_t::create_success());
+            zmq::message_t msg;
+            recv_retry_on_eintr(socket, msg);
+            return true;
+        });
+        EXPECT_TRUE(actor.stop(std::chrono::milliseconds{1000}));
+    }
+
+    auto const trace = chrome_trace();
+    EXPECT_EQ(1U, count_occurrences(trace, event("actor.start", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("actor.stop", 'E')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("actor.run", 'B')));
+    EXPECT_EQ(1U, count_occurrences(trace, event("actor.run", 'E')));
+}
+
+#if !defined(WIN32)
+TEST_F(UTestTracer, DumpsTraceOnSignalWithoutTerminatingLoop) {
+    auto const path = std::string{"/tmp/czze-test-trace-"} + std::to_string(getpid()) + ".json";
+    std::remove(path.c_str());
+    install_trace_dump_handler(path, SIGUSR1);
+    trace_begin("user.event");
+    trace_end("user.event");
+
+    std::size_t num_timer_calls = 0;
+    loop_t loop;
+    loop.add_timer(std::chrono::milliseconds{10}, 0, [&num_timer_calls](loop_t&, timer_id_t) {
+        if (num_timer_calls++ == 0) {
+            kill(getpid(), SIGUSR1);
+        }
+        return num_timer_calls < 20;
+    });
+    loop.run();
+
+    restore_trace_dump_handler();
+    EXPECT_EQ(20U, num_timer_calls);
+
+    std::ifstream file(path);
+    std::string const trace{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(0U, trace.find("{\"traceEvents\":["));
+    EXPECT_EQ(1U, count_occurrences(trace, event("user.event", 'B')));
+    std::remove(path.c_str());
+}
+
+TEST_F(UTestTracer, SurvivesSignalsDuringRepeatedInstallAndRestore) {
+    auto const path = std::string{"/tmp/czze-test-trace-"} + std::to_string(getpid()) + ".json";
+    // The restored handler must not terminate the process
+    auto* const previous = signal(SIGUSR1, [](int) {});
+    std::atomic<bool> done{false};
+    std::thread sender([&done]() {
+        while (!done.load()) {
+            kill(getpid(), SIGUSR1);
+            std::this_thread::yield();
+        }
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        install_trace_dump_handler(path, SIGUSR1);
+        restore_trace_dump_handler();
+    }
+    done.store(true);
+    sender.join();
+
+    // A signal received after the last restore does not trigger a dump on the next install
+    std::remove(path.c_str());
+    install_trace_dump_handler(path, SIGUSR1);
+    restore_trace_dump_handler();
+    EXPECT_FALSE(std::ifstream(path).good());
+
+    signal(SIGUSR1, previous);
+    std::remove(path.c_str());
+}
+#endif
+
+}  // namespace zmqzext
@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "cppzmqzoltanext/zpl_config.h"
+#include "utils.h"
 
 namespace zmqzext {
 
@@ -986,4 +987,29 @@ TEST_F(ZplConfigTest, ConfigurationWithMixedQuoting) {
     EXPECT_EQ(config.get("city"), "San Francisco");
 }
 
+TEST_F(ZplConfigTest, AllocatesTheTreeFromTheGivenMemoryResource) {
+    std::istringstream input(
+        "server\n"
+        "    address = tcp://127.0.0.1:5555\n"
+        "    options/linger = 1000\n"
+        "client");
+    counting_resource_t resource;
+    auto const config = zpl_config_t::from_stream(input, &resource);
+    auto const tree_allocations = resource.allocations;
+    EXPECT_GT(tree_allocations, 0U);
+
+    // Lookups walk the tree without allocating
+    EXPECT_EQ("1000", config.get("/server/options/linger"));
+    EXPECT_TRUE(config.contains("server/address"));
+    EXPECT_FALSE(config.contains("server/options/"));
+    EXPECT_EQ(tree_allocations, resource.allocations);
+
+    // Child configurations share the tree and its resource
+    auto const server = config.child("server");
+    EXPECT_GT(resource.allocations, tree_allocations);
+    EXPECT_EQ("tcp://127.0.0.1:5555", server.get("address"));
+    ASSERT_EQ(2U, config.children().size());
+    EXPECT_EQ("client", config.children()[1].name());
+}
+
 }  // namespace zmqzext
@@ -5,6 +5,7 @@
 #include <csignal>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <thread>
 #include <zmq.hpp>
@@ -68,6 +69,23 @@ std::thread shutdown_ctx_after_time(zmq::context_t& ctx, std::chrono::millisecon
     });
 }
 
+class counting_resource_t : public std::pmr::memory_resource {
+public:
+    std::size_t allocations{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+};
+
 struct ConnectedSocketsPullAndPush {
     zmq::socket_t socketPull;
     zmq::socket_t socketPush;